@@ -0,0 +1,64 @@
+#ifndef BENCHUTILS_H
+#define BENCHUTILS_H
+
+#include "pch.h"
+
+// Minimal benchmark helpers: benchmarks register themselves with the BENCHMARK macro
+// and are run by the main of the bench executable (optionally filtered by name)
+
+typedef std::chrono::steady_clock BenchClock;
+
+class LatencyStats
+{
+    public:
+        void reserve(std::size_t count) { _samplesNs.reserve(count);}
+        void add(const BenchClock::duration & latency) {
+            _samplesNs.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count());
+        }
+        std::size_t count() const { return _samplesNs.size();}
+
+        // prints count, p50, p90, p99 and max in microseconds
+        void report(const std::string & name) {
+            if (_samplesNs.empty()) {
+                std::cout << std::left << std::setw(44) << name << " no samples" << std::endl;
+                return;
+            }
+            std::sort(_samplesNs.begin(), _samplesNs.end());
+            std::cout << std::left << std::setw(44) << name << std::fixed << std::setprecision(1)
+                << " n=" << _samplesNs.size()
+                << " p50=" << percentileUs(0.50) << "us"
+                << " p90=" << percentileUs(0.90) << "us"
+                << " p99=" << percentileUs(0.99) << "us"
+                << " max=" << _samplesNs.back() / 1000.0 << "us" << std::endl;
+        }
+    private:
+        double percentileUs(const double p) const {
+            const std::size_t index = std::min(_samplesNs.size() - 1, (std::size_t)(p * _samplesNs.size()));
+            return _samplesNs[index] / 1000.0;
+        }
+        std::vector<long long> _samplesNs;
+};
+
+class BenchRegistry
+{
+    public:
+        typedef std::pair<std::string, std::function<void()>> Bench;
+        static std::vector<Bench> & benches() {
+            static std::vector<Bench> registered;
+            return registered;
+        }
+};
+
+struct BenchRegistrar
+{
+    BenchRegistrar(const std::string & name, std::function<void()> bench) {
+        BenchRegistry::benches().push_back(std::make_pair(name, bench));
+    }
+};
+
+#define BENCHMARK(name) \
+    static void name(); \
+    static BenchRegistrar name##Registrar(#name, name); \
+    static void name()
+
+#endif //BENCHUTILS_H
@@ -0,0 +1,55 @@
+#include "pch.h"
+#include "benchUtils.h"
+#include "buffer.h"
+#include "ringBuffer.h"
+#include "mqttData.h"
+
+// Throughput of the topicHandler buffers with several producers (like on_message and 
+// the motor polling threads) and one consumer, mutex queue against the lock-free ring
+
+namespace {
+
+template<typename BufferType>
+void runProducersToConsumer(const std::string & name, const int producerCount)
+{
+    const int messagesPerProducer = 100000;
+    BufferType buffer(1024, OverflowPolicy::Block);
+    const MqttData message("rbus/0628252/0000000000001/rbus.get.status/result", "{\"results\":\"12,1000,50,false,false,true,34,20,false,false,false,false,true,false\"}");
+
+    const auto start = BenchClock::now();
+    std::vector<std::thread> producers;
+    for (int p = 0; p < producerCount; ++p) {
+        producers.push_back(std::thread([&buffer, &message, messagesPerProducer]() {
+            for (int i = 0; i < messagesPerProducer; ++i) {
+                buffer.QueueNewMessage(message);
+            }
+        }));
+    }
+    std::vector<MqttData> received;
+    received.reserve(1024);
+    std::size_t total = 0;
+    while (total < (std::size_t)(producerCount * messagesPerProducer)) {
+        received.clear();
+        if (buffer.UnqueueAll(received) == 0) {
+            buffer.WaitForMessage(std::chrono::milliseconds(10));
+        }
+        total += received.size();
+    }
+    for (auto & t : producers) {
+        t.join();
+    }
+    const double seconds = std::chrono::duration<double>(BenchClock::now() - start).count();
+    std::cout << std::left << std::setw(44) << name << std::fixed << std::setprecision(0)
+        << " " << total / seconds << " msg/s" << std::endl;
+}
+
+}
+
+BENCHMARK(bufferThroughput)
+{
+    for (int producers : {1, 4}) {
+        const std::string suffix = " (" + std::to_string(producers) + " producers)";
+        runProducersToConsumer<Buffer<MqttData>>("buffer locked queue" + suffix, producers);
+        runProducersToConsumer<Buffer<MqttData, RingBuffer<MqttData>>>("buffer ring" + suffix, producers);
+    }
+}
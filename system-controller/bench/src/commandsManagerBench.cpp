@@ -0,0 +1,65 @@
+#include "pch.h"
+#include "benchUtils.h"
+#include "commandsManager.h"
+
+// Resends of unacked commands: how late a resend is compared to its backoff deadline
+// and the threads it takes for a site full of motors
+
+namespace {
+
+int threadCount()
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 8, "Threads:") == 0) {
+            return std::stoi(line.substr(8));
+        }
+    }
+    return -1;
+}
+
+struct SendLog {
+    std::chrono::system_clock::time_point firstSend;
+    int sendCount = 0;
+};
+
+}
+
+BENCHMARK(commandResends)
+{
+    const int managerCount = 200;
+    const int threadsBefore = threadCount();
+    std::mutex mutex;
+    LatencyStats lateness;
+    std::vector<SendLog> logs(managerCount);
+    std::vector<std::unique_ptr<CommandsManager>> managers;
+    for (int i = 0; i < managerCount; ++i) {
+        managers.emplace_back(new CommandsManager());
+        SendLog & log = logs[i];
+        managers.back()->setSendHandler([&mutex, &lateness, &log](MqttData data) {
+            const auto now = std::chrono::system_clock::now();
+            std::lock_guard<std::mutex> lock(mutex);
+            if (log.sendCount == 0) {
+                log.firstSend = now;
+            } else {
+                lateness.add(now - (log.firstSend + CommandsManager::getResendDelay(log.sendCount - 1)));
+            }
+            log.sendCount++;
+        });
+        managers.back()->startEvaluating();
+    }
+    const int threadsStarted = threadCount();
+    for (int i = 0; i < managerCount; ++i) {
+        const std::string serial = std::to_string(i);
+        managers[i]->pushCommandoToBeSend(MqttData("rbus/0628252/" + std::string(13 - serial.size(), '0') + serial + "/rbus.close/trigger", "_x_"), CommandType::SetMovement);
+    }
+    // stop before the slowed down resends (these log critical)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1300));
+    for (auto & manager : managers) {
+        manager->stopEvaluating();
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    lateness.report("resend lateness (200 unacked commands)");
+    std::cout << std::left << std::setw(44) << "threads added for 200 managers" << " " << threadsStarted - threadsBefore << std::endl;
+}
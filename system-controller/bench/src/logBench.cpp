@@ -0,0 +1,43 @@
+#include "pch.h"
+#include "benchUtils.h"
+#include "log.h"
+
+// Cost of a log call below the active level: the former macros built the message before the
+// logger checked its level, the current ones check the level (per subsystem) first
+
+namespace {
+
+template<typename Func>
+void reportNsPerOp(const std::string & name, const int iterations, Func func)
+{
+    const auto start = BenchClock::now();
+    for (int i = 0; i < iterations; ++i) {
+        func();
+    }
+    const double ns = std::chrono::duration<double, std::nano>(BenchClock::now() - start).count();
+    std::cout << std::left << std::setw(44) << name << std::fixed << std::setprecision(1)
+        << " " << ns / iterations << " ns/op" << std::endl;
+}
+
+}
+
+BENCHMARK(disabledLog)
+{
+    const int iterations = 200000;
+    Log::Init("log", spdlog::level::info);
+    const std::string wingId = "9b2f0c1e-5d2a-4c1b-8a55-3f0e4b6c7d21";
+    int position = 0;
+
+    reportNsPerOp("disabled debug, message built first", iterations, [&]() {
+        Log::GetLogger()->debug("wing " + wingId + ":" + "Request for set POSITION: " + std::to_string(position++) + "mm");
+    });
+    reportNsPerOp("disabled debug, level of the logger", iterations, [&]() {
+        LOG_SUBSYSTEM_DEBUG(Log::Wing, "wing " + wingId + ":" + "Request for set POSITION: " + std::to_string(position++) + "mm");
+    });
+    Log::GetLogger()->set_level(spdlog::level::trace);
+    Log::setLevel(Log::Wing, spdlog::level::info);
+    reportNsPerOp("disabled debug, level of the subsystem", iterations, [&]() {
+        LOG_SUBSYSTEM_DEBUG(Log::Wing, "wing {}:Request for set POSITION: {}mm", wingId, position++);
+    });
+    Log::setLevel(Log::Wing, spdlog::level::trace);
+}
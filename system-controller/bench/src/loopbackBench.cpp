@@ -0,0 +1,126 @@
+#include "pch.h"
+#include <atomic>
+#include "benchUtils.h"
+#include "loopbackTransport.h"
+#include "motorsHandler.h"
+#include "mqttManager.h"
+#include "mqttMotor.h"
+
+// The MqttManager on the in-process loopback bus, no broker needed:
+// - round trip of a request through the MqttManager and a topicHandler back to the requesting peer
+// - a site of simulated motor peers answering the polling of hundreds of MqttMotors
+
+namespace {
+
+class ReplyHandler : public TopicHandler
+{
+    public:
+        ReplyHandler() : TopicHandler({"request/#"}) {}
+    protected:
+        void handleNewInput(const MqttData & inputData) override {
+            _pOutTypeBuffer->QueueNewMessage(MqttData("reply/bench", inputData.getPayload()));
+        }
+};
+
+std::string motorSerial(const int index)
+{
+    const std::string serial = std::to_string(index);
+    return std::string(13 - serial.size(), '0') + serial;
+}
+
+// replaces the last level of a trigger topic
+std::string replyTopic(const std::string & triggerTopic, const std::string & action)
+{
+    return triggerTopic.substr(0, triggerTopic.find_last_of('/') + 1) + action;
+}
+
+}
+
+BENCHMARK(loopbackRoundTrip)
+{
+    const int requestCount = 5000;
+    auto bus = std::make_shared<LoopbackBus>();
+    MqttManager mqtt(std::make_shared<LoopbackTransport>(bus), {std::make_shared<ReplyHandler>()});
+    LoopbackTransport peer(bus);
+    std::vector<BenchClock::time_point> sendTimes(requestCount);
+    LatencyStats stats;
+    stats.reserve(requestCount);
+    std::atomic<int> replies(0);
+    peer.setMessageHandler([&](const MqttData & data) {
+        stats.add(BenchClock::now() - sendTimes[std::stoi(data.getPayload())]);
+        replies++;
+    });
+    peer.connect();
+    peer.subscribe("reply/#");
+    peer.startThreadedLoop();
+    mqtt.start();
+
+    for (int i = 0; i < requestCount; ++i) {
+        sendTimes[i] = BenchClock::now();
+        peer.publish(MqttData("request/bench", std::to_string(i)));
+        // wait for the reply so the latency of a single message is measured
+        const auto deadline = BenchClock::now() + std::chrono::milliseconds(500);
+        while (replies <= i && BenchClock::now() < deadline) {
+            std::this_thread::yield();
+        }
+    }
+    mqtt.stop();
+    peer.stopThreadedLoop();
+    stats.report("loopback request->reply round trip");
+}
+
+BENCHMARK(loopbackMotorSite)
+{
+    const int motorCount = 400;
+    const auto duration = std::chrono::seconds(3);
+    const std::string pn = "0628252";
+    auto bus = std::make_shared<LoopbackBus>();
+    auto motorsHandler = std::make_shared<MotorsHandler>();
+    std::vector<std::shared_ptr<MqttMotor>> motors;
+    for (int i = 0; i < motorCount; ++i) {
+        motors.push_back(std::make_shared<MqttMotor>(pn, motorSerial(i)));
+        motorsHandler->addMotor(motors.back());
+    }
+    MqttManager mqtt(std::make_shared<LoopbackTransport>(bus), {motorsHandler});
+
+    // one peer plays all motors: idle and closed, every command is acknowledged
+    auto peer = std::make_shared<LoopbackTransport>(bus, 1 << 14);
+    std::atomic<int> polls(0);
+    LoopbackTransport * rawPeer = peer.get();
+    peer->setMessageHandler([rawPeer, &polls](const MqttData & data) {
+        const std::string & topic = data.getTopic();
+        if (topic.find("rbus.get.status") != std::string::npos) {
+            polls++;
+            rawPeer->publish(MqttData(replyTopic(topic, "result"), "{\"results\":\"0,0,0,false,false,true,30,0,0,0,0,false,false,true,false\"}"));
+        } else if (topic.find("rbus.get.minspeed") != std::string::npos) {
+            rawPeer->publish(MqttData(replyTopic(topic, "result"), "{\"results\":50}"));
+        } else if (topic.find("rbus.get.maxspeed") != std::string::npos) {
+            rawPeer->publish(MqttData(replyTopic(topic, "result"), "{\"results\":150}"));
+        } else if (topic.find("rbus.get.stroke") != std::string::npos) {
+            rawPeer->publish(MqttData(replyTopic(topic, "result"), "{\"results\":1000}"));
+        } else {
+            rawPeer->publish(MqttData(replyTopic(topic, "ack"), ""));
+        }
+    });
+    peer->connect();
+    peer->subscribe("rbus/+/+/+/trigger");
+    peer->startThreadedLoop();
+
+    mqtt.start();
+    std::this_thread::sleep_for(duration);
+    mqtt.stop();
+    peer->stopThreadedLoop();
+    for (auto & motor : motors) {
+        motor->onMotorDisconnected();
+    }
+    int configured = 0;
+    for (auto & motor : motors) {
+        configured += motor->getIsConfigured() ? 1 : 0;
+    }
+    const double seconds = std::chrono::duration_cast<std::chrono::duration<double>>(duration).count();
+    std::cout << std::left << std::setw(44) << ("loopback site of " + std::to_string(motorCount) + " motors") << std::fixed << std::setprecision(0)
+        << " configured=" << configured
+        << " polls/s=" << polls / seconds
+        << " messages/s=" << bus->getNumberOfDeliveredMessages() / seconds
+        << " dropped=" << peer->getDroppedCount() << std::endl;
+}
@@ -0,0 +1,23 @@
+#include "pch.h"
+#include "benchUtils.h"
+
+// Run all benchmarks, or only those whose name contains one of the arguments
+// Ex: ./systemControllerBench mqttManager
+int main (int argc , char **argv) {
+    Log::Init("logs");
+    Log::GetLogger()->set_level(spdlog::level::critical);
+
+    for (auto & bench : BenchRegistry::benches()) {
+        bool selected = argc <= 1;
+        for (int i = 1; i < argc; ++i) {
+            if (bench.first.find(argv[i]) != std::string::npos) {
+                selected = true;
+            }
+        }
+        if (selected) {
+            bench.second();
+        }
+    }
+    Log::GetLogger()->flush();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,42 @@
+#include "pch.h"
+#include "benchUtils.h"
+#include "metrics.h"
+
+// Cost of recording one event in the metrics that are left on in production,
+// on one thread and on four threads recording into the same metric
+
+namespace {
+
+template<typename Func>
+void reportNsPerOp(const std::string & name, const int iterations, const int numberOfThreads, Func func)
+{
+    std::vector<std::thread> threads;
+    const auto start = BenchClock::now();
+    for (int t = 0; t < numberOfThreads; ++t) {
+        threads.emplace_back([&]() {
+            for (int i = 0; i < iterations; ++i) {
+                func(i);
+            }
+        });
+    }
+    for (auto & thread : threads) {
+        thread.join();
+    }
+    const double ns = std::chrono::duration<double, std::nano>(BenchClock::now() - start).count();
+    std::cout << std::left << std::setw(44) << (name + " x" + std::to_string(numberOfThreads)) << std::fixed << std::setprecision(1)
+        << " " << ns / iterations << " ns/op (per thread)" << std::endl;
+}
+
+}
+
+BENCHMARK(metricsRecording)
+{
+    const int iterations = 1000000;
+    Counter & counter = MetricsRegistry::getInstance().getCounter("bench.counter");
+    Histogram & histogram = MetricsRegistry::getInstance().getHistogram("bench.histogram");
+    for (int threads : {1, 4}) {
+        reportNsPerOp("counter add", iterations, threads, [&](int) {counter.add();});
+        reportNsPerOp("histogram record", iterations, threads, [&](int i) {histogram.record(i & 1023);});
+        reportNsPerOp("scoped timer", iterations / 10, threads, [&](int) {ScopedTimer timer(histogram);});
+    }
+}
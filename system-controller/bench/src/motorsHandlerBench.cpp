@@ -0,0 +1,146 @@
+#include "pch.h"
+#include "benchUtils.h"
+#include <atomic>
+#include "motorsHandler.h"
+#include "mqttMotor.h"
+
+// Cost of MotorsHandler::handleNewInput (parse the topic + find the motor) for small and large sites
+// and the throughput of the status input of a large site spread over 1 to 8 shards
+
+namespace {
+
+class NullMotor : public IMqttMotor
+{
+    public:
+        explicit NullMotor(const std::string & id) : _id(id) {}
+        void onMotorInput(const MotorData & data) override { inputCount++;}
+        void onMotorConnected() override {}
+        void onMotorDisconnected() override {}
+        void setDelegateMotorOutput(std::function<void(MqttData)> delegateMotorOutput) override {}
+        std::string getId() const override { return _id;}
+        std::size_t inputCount = 0;
+    private:
+        std::string _id;
+};
+
+std::string motorId(const int index)
+{
+    const std::string serial = std::to_string(index);
+    return "0628252/" + std::string(13 - serial.size(), '0') + serial;
+}
+
+MqttData statusResult(const std::string & id)
+{
+    return MqttData("rbus/" + id + "/rbus.get.status/result", "{\"results\":\"12,1000,50,false,false,true,34,20,false,false,false,false,true,false\"}");
+}
+
+// busy work in the position handler, like a wing evaluated on the motor worker
+void spin(const std::chrono::nanoseconds duration)
+{
+    const auto end = BenchClock::now() + duration;
+    while (BenchClock::now() < end) {
+    }
+}
+
+void runShards(const std::size_t shardCount, const int motorCount, const std::chrono::nanoseconds handlerWork)
+{
+    MotorsHandler handler(shardCount);
+    std::vector<std::shared_ptr<MqttMotor>> motors;
+    std::atomic<long> handled(0);
+    for (int i = 0; i < motorCount; ++i) {
+        const std::string serial = std::to_string(i);
+        motors.push_back(std::make_shared<MqttMotor>("0628252", std::string(13 - serial.size(), '0') + serial));
+        motors.back()->addOnPositionUpdatehandler([&handled, handlerWork](int) {
+            spin(handlerWork);
+            handled++;
+        });
+        handler.addMotor(motors.back());
+    }
+    // the polling requests of the motors are not needed
+    std::atomic<bool> isDraining(true);
+    std::thread drain([&handler, &isDraining]() {
+        MqttData data;
+        while (isDraining) {
+            if (!handler.getOutputBuffer()->UnqueueMessage(data)) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        }
+    });
+    handler.start();
+    // the motors only handle a status once their speeds are known (reset on connect)
+    for (int i = 0; i < motorCount; ++i) {
+        handler.queueInput(MqttData("rbus/" + motorId(i) + "/rbus.get.minspeed/result", "{\"results\":50}"));
+        handler.queueInput(MqttData("rbus/" + motorId(i) + "/rbus.get.maxspeed/result", "{\"results\":150}"));
+    }
+    for (auto & motor : motors) {
+        while (!motor->getIsConfigured()) {
+            std::this_thread::yield();
+        }
+    }
+
+    std::vector<MqttData> messages;
+    for (int i = 0; i < motorCount; ++i) {
+        messages.push_back(statusResult(motorId(i)));
+    }
+    // limit the messages in flight so the inputbuffers never drop
+    const long messageCount = 100000;
+    const long maxInFlight = TopicHandler::InputBufferCapacity / 2;
+    const auto start = BenchClock::now();
+    for (long i = 0; i < messageCount; ++i) {
+        while (i - handled >= maxInFlight) {
+            std::this_thread::yield();
+        }
+        handler.queueInput(messages[i % motorCount]);
+    }
+    while (handled < messageCount) {
+        std::this_thread::yield();
+    }
+    const double seconds = std::chrono::duration<double>(BenchClock::now() - start).count();
+    handler.stop();
+    isDraining = false;
+    drain.join();
+    for (auto & motor : motors) {
+        motor->onMotorDisconnected();
+    }
+    std::cout << std::left << std::setw(44) << ("motorsHandler " + std::to_string(shardCount) + " shards (" + std::to_string(handlerWork.count()) + "ns handler)")
+        << std::fixed << std::setprecision(0) << " " << messageCount / seconds << " status/s" << std::endl;
+}
+
+void runDispatch(const int motorCount)
+{
+    MotorsHandler handler;
+    std::vector<std::shared_ptr<NullMotor>> motors;
+    std::vector<MqttData> messages;
+    for (int i = 0; i < motorCount; ++i) {
+        motors.push_back(std::make_shared<NullMotor>(motorId(i)));
+        handler.addMotor(motors.back());
+        messages.push_back(statusResult(motorId(i)));
+    }
+    const int iterations = 200000;
+    const auto start = BenchClock::now();
+    for (int i = 0; i < iterations; ++i) {
+        handler.handleNewInput(messages[i % motorCount]);
+    }
+    const double ns = std::chrono::duration<double, std::nano>(BenchClock::now() - start).count();
+    std::cout << std::left << std::setw(44) << ("motorsHandler dispatch (" + std::to_string(motorCount) + " motors)") 
+        << std::fixed << std::setprecision(1) << " " << ns / iterations << " ns/op" << std::endl;
+}
+
+}
+
+BENCHMARK(motorsHandlerDispatch)
+{
+    for (int motorCount : {4, 40, 400}) {
+        runDispatch(motorCount);
+    }
+}
+
+BENCHMARK(motorsHandlerShards)
+{
+    std::cout << "hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+    for (auto handlerWork : {std::chrono::nanoseconds(0), std::chrono::nanoseconds(5000)}) {
+        for (std::size_t shardCount : {1, 2, 4, 8}) {
+            runShards(shardCount, 200, handlerWork);
+        }
+    }
+}
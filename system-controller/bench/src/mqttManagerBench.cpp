@@ -0,0 +1,74 @@
+#include "pch.h"
+#include <atomic>
+#include "benchUtils.h"
+#include "mqttManager.h"
+#include "topicHandler.h"
+
+// Measures the time between QueueNewMessage on an output buffer of a topicHandler 
+// and the moment the MqttManager publishes that message.
+// The publish is intercepted so no broker is needed.
+
+namespace {
+
+class LatencyMqttManager : public MqttManager
+{
+    public:
+        LatencyMqttManager(std::vector<std::shared_ptr<TopicHandler>> topicHandlers, std::size_t messageCount) 
+            : MqttManager("localhost", 1883, "systemcontrollerBench", topicHandlers)
+            , _enqueueTimes(messageCount)
+            , _published(0)
+        {
+            _stats.reserve(messageCount);
+        }
+        void markEnqueued(std::size_t sequence) { _enqueueTimes[sequence] = BenchClock::now();}
+        std::size_t published() const { return _published.load();}
+        LatencyStats & stats() { return _stats;}
+    protected:
+        bool publishMessage(const MqttData & data) override {
+            const auto now = BenchClock::now();
+            const std::size_t sequence = std::stoul(data.getPayload());
+            _stats.add(now - _enqueueTimes[sequence]);
+            _published++;
+            return true;
+        }
+    private:
+        std::vector<BenchClock::time_point> _enqueueTimes;
+        std::atomic<std::size_t> _published;
+        LatencyStats _stats;
+};
+
+void runQueueToPublish(const std::string & name, const bool threadedLoop, const int handlerCount) 
+{
+    const std::size_t messageCount = 2000;
+    std::vector<std::shared_ptr<TopicHandler>> topicHandlers;
+    for (int i = 0; i < handlerCount; ++i) {
+        topicHandlers.push_back(std::make_shared<TopicHandler>(std::vector<std::string>{"bench/" + std::to_string(i) + "/#"}));
+    }
+    LatencyMqttManager mqtt(topicHandlers, messageCount);
+    mqtt.setUseThreadedLoop(threadedLoop);
+    mqtt.start();
+
+    for (std::size_t sequence = 0; sequence < messageCount; ++sequence) {
+        // alternate between the handlers, the last one is the one which used to wait the longest
+        auto & handler = topicHandlers[(sequence + 1) % topicHandlers.size()];
+        mqtt.markEnqueued(sequence);
+        handler->getOutputBuffer()->QueueNewMessage(MqttData("bench/out", std::to_string(sequence)));
+        // space the messages so the latency of a single message is measured and not the throughput
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    const auto deadline = BenchClock::now() + std::chrono::seconds(5);
+    while (mqtt.published() < messageCount && BenchClock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    mqtt.stop();
+    mqtt.stats().report(name);
+}
+
+}
+
+BENCHMARK(mqttManagerQueueToPublish)
+{
+    runQueueToPublish("mqttManager queue->publish (1 handler)", false, 1);
+    runQueueToPublish("mqttManager queue->publish (2 handlers)", false, 2);
+    runQueueToPublish("mqttManager queue->publish (threaded loop)", true, 2);
+}
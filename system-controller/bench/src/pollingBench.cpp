@@ -0,0 +1,77 @@
+#include "pch.h"
+#include "benchUtils.h"
+#include "mqttMotor.h"
+
+// Status polling of a site: broker message rate while the motors settle after connecting
+// versus when they are idle and closed, and the number of threads it takes
+
+namespace {
+
+int threadCount()
+{
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.compare(0, 8, "Threads:") == 0) {
+            return std::stoi(line.substr(8));
+        }
+    }
+    return -1;
+}
+
+std::string motorSerial(const int index)
+{
+    const std::string serial = std::to_string(index);
+    return std::string(13 - serial.size(), '0') + serial;
+}
+
+}
+
+BENCHMARK(statusPolling)
+{
+    const int motorCount = 40;
+    const std::string pn = "0628252";
+    const int threadsBefore = threadCount();
+    std::atomic<int> polls(0);
+    std::vector<std::shared_ptr<MqttMotor>> motors;
+    for (int i = 0; i < motorCount; ++i) {
+        const std::string base = "rbus/" + pn + "/" + motorSerial(i) + "/";
+        auto motor = std::make_shared<MqttMotor>(pn, motorSerial(i));
+        const MqttData status(base + "rbus.get.status/result", "{\"results\":\"0,0,0,false,false,true,30,0,0,0,0,false,false,true,false\"}");
+        const MqttData stroke(base + "rbus.get.stroke/result", "{\"results\":1000}");
+        MqttMotor * raw = motor.get();
+        // every motor replies immediately as idle and closed
+        motor->setDelegateMotorOutput([raw, status, stroke, &polls](const MqttData & data) {
+            if (data.getTopic().find("get.status") != std::string::npos) {
+                polls++;
+                raw->onMotorInput(MotorData(status));
+            } else if (data.getTopic().find("get.stroke") != std::string::npos) {
+                raw->onMotorInput(MotorData(stroke));
+            }
+        });
+        motor->onMotorConnected();
+        motor->onMotorInput(MotorData(MqttData(base + "rbus.get.maxspeed/result", "{\"results\":120}")));
+        motor->onMotorInput(MotorData(MqttData(base + "rbus.get.minspeed/result", "{\"results\":20}")));
+        motors.push_back(motor);
+    }
+    const int threadsPolling = threadCount();
+
+    auto measure = [&polls](const std::string & name, const std::chrono::milliseconds duration) {
+        polls = 0;
+        std::this_thread::sleep_for(duration);
+        const double seconds = std::chrono::duration<double>(duration).count();
+        std::cout << std::left << std::setw(44) << name << std::fixed << std::setprecision(1)
+            << " " << polls / seconds << " status polls/s" << std::endl;
+    };
+    measure("polling 40 motors, settling (fast)", MqttMotor::FastPollHold);
+    measure("polling 40 motors, idle and closed", std::chrono::milliseconds(3000));
+    for (auto & motor : motors) {
+        motor->requestFastPolling();
+    }
+    measure("polling 40 motors, fast requested", std::chrono::milliseconds(1000));
+
+    std::cout << std::left << std::setw(44) << "threads added for 40 motors" << " " << threadsPolling - threadsBefore << std::endl;
+    for (auto & motor : motors) {
+        motor->onMotorDisconnected();
+    }
+}
@@ -0,0 +1,109 @@
+#include "pch.h"
+#include "benchUtils.h"
+#include "motorizedWindow.h"
+#include "passiveWindow.h"
+#include "panelChain.h"
+
+// Cost of evaluating the push zones of a 6 panel chain (X X O X O X), as done on every position
+// update of its motors: pushSlavesToAllowMovement of each motorized panel while opening and closing.
+// Also listing the motors of the chain by walking the slave tree versus the compiled panel chain.
+
+namespace {
+
+// answers without any work, only the evaluation of the panels is measured
+class NullMotionManager : public MotorMotionManager
+{
+    public:
+        void setHighSpeed() override {}
+        void setLowSpeed() override {}
+        int getLowSpeed() const override {return 50;}
+        void stop() override {}
+        void close() override {}
+        void open() override {}
+        int getStroke() const override {return 6000;}
+        std::future<bool> clearCalibration() override {return std::future<bool>();}
+        MotorStatusData getMotorStatusData() const override {return MotorStatusData();}
+        bool isCalibrated() const override {return true;}
+        bool getIsConfigured() const override {return true;}
+};
+
+const int panelLength = 1000;
+
+std::vector<std::shared_ptr<MotorizedWindow>> createChain(bool firstIsMaster)
+{
+    std::vector<std::shared_ptr<MotorizedWindow>> motorized;
+    std::shared_ptr<IMovingWindow> last;
+    for (char type : std::string("XXOXOX")) {
+        std::shared_ptr<IMovingWindow> panel;
+        if (type == 'X') {
+            if (motorized.empty() && firstIsMaster) {
+                motorized.push_back(std::make_shared<MasterMotorizedWindow>(panelLength, std::make_shared<NullMotionManager>()));
+            } else {
+                motorized.push_back(std::make_shared<MotorizedWindow>(panelLength, std::make_shared<NullMotionManager>()));
+            }
+            panel = motorized.back();
+        } else {
+            panel = std::make_shared<PassiveWindow>(panelLength);
+        }
+        if (last) {
+            last->addSlave(panel, type == 'X' ? SlaveType::Motor : SlaveType::Passive);
+        }
+        last = panel;
+    }
+    return motorized;
+}
+
+void runChain(const std::string & name, PushType pushType)
+{
+    const int iterations = 200000;
+    const auto motorized = createChain(false);
+
+    long long check = 0;
+    const auto start = BenchClock::now();
+    for (int i = 0; i < iterations; ++i) {
+        // the panels are close to each other, all zones (push, overlap, slow down) are crossed
+        const int offset = i % 400;
+        for (std::size_t m = 0; m < motorized.size(); ++m) {
+            motorized[m]->push(pushType);
+            motorized[m]->onPositionUpdate(5000 - (int)m * 800 + offset);
+            check += (int)motorized[m]->getMovementFreedom();
+        }
+    }
+    const double seconds = std::chrono::duration<double>(BenchClock::now() - start).count();
+    std::cout << std::left << std::setw(44) << name << std::fixed << std::setprecision(1)
+        << " " << seconds * 1e9 / iterations << " ns/chain (check " << check << ")" << std::endl;
+}
+
+}
+
+BENCHMARK(pushZoneChain)
+{
+    runChain("6 panel chain push open", PushType::PushToOpen);
+    runChain("6 panel chain pull close", PushType::PushToClose);
+}
+
+BENCHMARK(panelChainMotors)
+{
+    const int iterations = 200000;
+    const auto motorized = createChain(true);
+    const auto master = std::static_pointer_cast<MasterMotorizedWindow>(motorized[0]);
+    std::size_t check = 0;
+    auto start = BenchClock::now();
+    for (int i = 0; i < iterations; ++i) {
+        check += master->getSlaveMotors().size();
+    }
+    double seconds = std::chrono::duration<double>(BenchClock::now() - start).count();
+    std::cout << std::left << std::setw(44) << "motors of 6 panel chain, slave tree walk" << std::fixed << std::setprecision(1)
+        << " " << seconds * 1e9 / iterations << " ns (check " << check << ")" << std::endl;
+
+    const PanelChain chain(master);
+    start = BenchClock::now();
+    for (int i = 0; i < iterations; ++i) {
+        for (auto & motor : chain.getMotors()) {
+            check += motor->getLength();
+        }
+    }
+    seconds = std::chrono::duration<double>(BenchClock::now() - start).count();
+    std::cout << std::left << std::setw(44) << "motors of 6 panel chain, panel chain" << std::fixed << std::setprecision(1)
+        << " " << seconds * 1e9 / iterations << " ns (check " << check << ")" << std::endl;
+}
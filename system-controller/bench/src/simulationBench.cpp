@@ -0,0 +1,72 @@
+#include "pch.h"
+#include "benchUtils.h"
+#include "siteSimulation.h"
+
+// Closed loop runs of full configurations on simulated motors: open, random positions
+// and close, driven by the virtual clock. Reports the speedup versus real time, the decisions
+// per second, the latency of a single status report or wing evaluation and the message counts
+
+namespace {
+
+// every motorized element gets its own serial, all elements are 1990mm
+std::string configJson(const std::string & layout)
+{
+    std::string json = "{\"id\":\"simulation\",\"config\":[";
+    int serial = 0;
+    for (std::size_t i = 0; i < layout.size(); ++i) {
+        const std::string type(1, layout[i]);
+        json += i == 0 ? "{" : ",{";
+        json += "\"type\":\"" + type + "\"";
+        if (type == "X" || type == "O") {
+            json += ",\"length\":1990";
+        }
+        if (type == "X") {
+            const std::string number = std::to_string(++serial);
+            json += ",\"pn\":\"0628253\",\"serial\":\"" + std::string(13 - number.size(), '0') + number + "\"";
+        }
+        json += "}";
+    }
+    return json + "]}";
+}
+
+void runScenario(const std::string & layout, const int cycles)
+{
+    SiteSimulation simulation(configJson(layout));
+    LatencyStats latencies;
+    latencies.reserve(1 << 20);
+    simulation.setUpdateObserver([&latencies](std::chrono::nanoseconds duration) {latencies.add(duration);});
+    std::mt19937 random(42);
+    std::uniform_int_distribution<int> percentage(0, 100);
+    const auto timeout = std::chrono::minutes(2);
+
+    const auto start = BenchClock::now();
+    for (int cycle = 0; cycle < cycles; ++cycle) {
+        for (auto & wing : simulation.getWings()) {wing->open();}
+        simulation.runUntil([&simulation]() {return simulation.areAllWingsOpen();}, timeout);
+        for (auto & wing : simulation.getWings()) {wing->setPositionPerc(percentage(random));}
+        simulation.run(std::chrono::seconds(30));
+        for (auto & wing : simulation.getWings()) {wing->close();}
+        simulation.runUntil([&simulation]() {return simulation.areAllWingsClosed();}, timeout);
+    }
+    const auto wall = std::chrono::duration_cast<std::chrono::duration<double>>(BenchClock::now() - start).count();
+    const double simulated = std::chrono::duration_cast<std::chrono::duration<double>>(simulation.getClock().now()).count();
+    const auto counters = simulation.getCounters();
+
+    std::cout << std::left << std::setw(44) << ("siteSimulation " + layout) << std::fixed << std::setprecision(0)
+        << " simulated=" << simulated << "s wall=" << wall * 1000 << "ms speedup=" << simulated / wall << "x"
+        << " decisions/s=" << counters.getDecisions() / wall << std::endl;
+    std::cout << std::left << std::setw(44) << "" << " messages=" << counters.getMessages()
+        << " (status=" << 2 * counters.statusReports << " commands=" << counters.motorCommands
+        << " wing=" << counters.wingMessages << ")" << std::endl;
+    latencies.report("  wing update " + layout);
+}
+
+}
+
+BENCHMARK(siteSimulation)
+{
+    const int cycles = 20;
+    for (const std::string layout : {"QOX-XXQ", "XvX", "QXvXQ", "X(XX)", "QXX-XXQ"}) {
+        runScenario(layout, cycles);
+    }
+}
@@ -0,0 +1,68 @@
+#include "pch.h"
+#include "benchUtils.h"
+#include "motorData.h"
+#include "motorStatusParser.h"
+
+// Throughput of parsing a rbus.get.status result: the one pass parser against
+// the former rapidjson document + substr/erase/stoi tokenizing
+
+namespace {
+
+void domStatus(const std::string & payload, MotorStatusData & motorStatus)
+{
+    rapidjson::Document d;
+    d.Parse(payload.data());
+    rapidjson::Value& t = d["results"];
+    if ( t.IsString()) {
+        std::string result = t.GetString();
+        size_t pos = 0;
+        std::string token;
+        std::string delimitor = ",";
+        int count = 0;
+        while ((pos = result.find(delimitor)) != std::string::npos) {
+            token = result.substr(0, pos);
+            if ( count == 0) { motorStatus.posMm = std::stoi(token);}
+            else if ( count == 2) { motorStatus.speedMm = std::stoi(token);}
+            else if ( count == 3) { motorStatus.isLocked =  (token == "true");}
+            else if ( count == 4) { motorStatus.isOpen =  (token == "true");}
+            else if ( count == 5) { motorStatus.isClosed =  (token == "true");}
+            else if ( count == 13) { motorStatus.isCalibrated =  (token == "true");}
+            else if ( count == 14) { motorStatus.isEmergencyRun =  (token == "true");}
+            result.erase(0, pos + delimitor.length());
+            count ++;
+        }
+    }
+}
+
+template<typename Func>
+void reportThroughput(const std::string & name, const int iterations, Func func)
+{
+    const auto start = BenchClock::now();
+    for (int i = 0; i < iterations; ++i) {
+        func();
+    }
+    const double seconds = std::chrono::duration<double>(BenchClock::now() - start).count();
+    std::cout << std::left << std::setw(44) << name << std::fixed << std::setprecision(0)
+        << " " << iterations / seconds << " status/s" << std::endl;
+}
+
+}
+
+BENCHMARK(statusParsing)
+{
+    const int iterations = 200000;
+    const std::string payload = "{\"results\":\"1234,45,50,false,false,true,34,20,0,0,0,false,false,true,false\"}";
+    MotorStatusData status;
+    long long check = 0;
+    reportThroughput("status rapidjson + substr", iterations, [&]() {
+        domStatus(payload, status);
+        check += status.posMm;
+    });
+    reportThroughput("status MotorStatusParser", iterations, [&]() {
+        MotorStatusParser::parse(payload, status);
+        check += status.posMm;
+    });
+    if (check == 0) {
+        std::cout << "unexpected: nothing parsed" << std::endl;
+    }
+}
@@ -0,0 +1,110 @@
+#include "pch.h"
+#include "benchUtils.h"
+#include "subscriptionMatcher.h"
+
+// Routing of 10k synthetic topics over 100 subscriptions (10 topic handlers with 10 subscriptions each):
+// one walk of the compiled matcher against checking every subscription of every handler
+
+namespace {
+
+// the former TopicHandler::isTopicValidForHandling
+bool characterMatch(const std::vector<std::string> & subscribeStrs, const std::string & topic) {
+    for (auto & sub: subscribeStrs) {
+        if ( topic.size() < sub.size())
+            continue;
+        bool isSearchingForNextMatch =false;
+        std::string::size_type j = 0;
+        std::string::size_type i = 0;
+        for(; i < topic.size(); ++i) {
+            if ( j >= sub.size()) {
+                    break;
+            } else {
+                 if (isSearchingForNextMatch) {
+                    if( topic[i] == '/' ) {
+                        isSearchingForNextMatch = false;
+                    } else {
+                        continue;
+                    }
+                }
+                else if ( topic[i] != sub[j]) {
+                    if ( sub[j]=='#') {
+                        if (j==0 || topic[j-1]=='/') {
+                            return true;
+                        } else { 
+                            break;
+                        }
+                    } else if (sub[j]=='+') {
+                        isSearchingForNextMatch=true;  
+                        j++;
+                        continue;                 
+                    } else {                   
+                        break;
+                    }
+                }
+                j++;
+            }
+        }
+        if ( i >= topic.size() && !isSearchingForNextMatch)
+            return true;
+    }
+    return false;
+}
+
+}
+
+BENCHMARK(subscriptionMatcher)
+{
+    const int handlerCount = 10;
+    const int subscriptionsPerHandler = 10;
+    std::vector<std::vector<std::string>> handlerSubscriptions(handlerCount);
+    SubscriptionMatcher matcher;
+    for (int h = 0; h < handlerCount; ++h) {
+        for (int s = 0; s < subscriptionsPerHandler; ++s) {
+            std::string sub;
+            switch (s % 4) {
+                case 0: sub = "site" + std::to_string(h) + "/zone" + std::to_string(s) + "/#"; break;
+                case 1: sub = "site" + std::to_string(h) + "/+/device" + std::to_string(s) + "/status"; break;
+                case 2: sub = "rbus/+/+/cmd" + std::to_string(h * subscriptionsPerHandler + s) + "/result"; break;
+                default: sub = "systemcontroller/config" + std::to_string(h) + "/wing/+/cmd" + std::to_string(s); break;
+            }
+            handlerSubscriptions[h].push_back(sub);
+            matcher.add(sub, h);
+        }
+    }
+    std::vector<std::string> topics;
+    std::mt19937 random(42);
+    for (int i = 0; i < 10000; ++i) {
+        const int h = random() % handlerCount;
+        const int s = random() % (subscriptionsPerHandler + 2);
+        switch (i % 4) {
+            case 0: topics.push_back("site" + std::to_string(h) + "/zone" + std::to_string(s) + "/device/" + std::to_string(i)); break;
+            case 1: topics.push_back("site" + std::to_string(h) + "/floor" + std::to_string(i % 7) + "/device" + std::to_string(s) + "/status"); break;
+            case 2: topics.push_back("rbus/0628252/" + std::to_string(1000000000000LL + i) + "/cmd" + std::to_string(random() % 120) + "/result"); break;
+            default: topics.push_back("systemcontroller/config" + std::to_string(h) + "/wing/" + std::to_string(i) + "/cmd" + std::to_string(s)); break;
+        }
+    }
+
+    std::size_t matchedOld = 0;
+    auto start = BenchClock::now();
+    for (auto & topic : topics) {
+        for (auto & subscriptions : handlerSubscriptions) {
+            matchedOld += characterMatch(subscriptions, topic);
+        }
+    }
+    const double oldNs = std::chrono::duration<double, std::nano>(BenchClock::now() - start).count();
+
+    std::size_t matchedNew = 0;
+    std::vector<std::size_t> handlers;
+    start = BenchClock::now();
+    for (auto & topic : topics) {
+        handlers.clear();
+        matcher.match(topic, handlers);
+        matchedNew += handlers.size();
+    }
+    const double newNs = std::chrono::duration<double, std::nano>(BenchClock::now() - start).count();
+
+    std::cout << std::left << std::setw(44) << "subscriptions per handler (character walk)" << std::fixed << std::setprecision(1)
+        << " " << oldNs / topics.size() << " ns/topic, " << matchedOld << " deliveries" << std::endl;
+    std::cout << std::left << std::setw(44) << "subscriptions compiled matcher" << std::fixed << std::setprecision(1)
+        << " " << newNs / topics.size() << " ns/topic, " << matchedNew << " deliveries" << std::endl;
+}
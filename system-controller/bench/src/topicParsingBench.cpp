@@ -0,0 +1,77 @@
+#include "pch.h"
+#include "benchUtils.h"
+#include "motorData.h"
+#include "wingData.h"
+
+// Parsing of the motor and wing topics: the tokenizer used by MotorData/WingData
+// against the std::regex implementation they used before
+
+namespace {
+
+// the former MotorData topic parsing
+void regexMotorTopic(const std::string & topicStr, std::string & id, std::string & command, std::string & action)
+{
+    std::regex motor_regex("\\/(\\d{7})\\/(\\d{13})\\/([^\\/]+)\\/([^\\/]+$)",std::regex_constants::ECMAScript | std::regex_constants::icase);
+    std::smatch matches;
+    if(std::regex_search( topicStr, matches, motor_regex)) {
+        id =  matches[1].str() + "/" + matches[2].str() ;
+        command = matches[3].str();
+        action = matches[4].str();
+    }
+}
+
+// the former WingData topic parsing
+void regexWingTopic(const std::string & topicStr, std::string & id, std::string & command)
+{
+    std::regex wing_regex("\\/wing\\/([^\\/]+)\\/([^\\/]+$)",std::regex_constants::ECMAScript | std::regex_constants::icase);
+    std::smatch matches;
+    if(std::regex_search( topicStr, matches, wing_regex)) {
+        id =  matches[1].str();
+        command = matches[2].str();
+    }
+}
+
+template<typename Func>
+void reportNsPerOp(const std::string & name, const int iterations, Func func)
+{
+    const auto start = BenchClock::now();
+    for (int i = 0; i < iterations; ++i) {
+        func();
+    }
+    const double ns = std::chrono::duration<double, std::nano>(BenchClock::now() - start).count();
+    std::cout << std::left << std::setw(44) << name << std::fixed << std::setprecision(1)
+        << " " << ns / iterations << " ns/op" << std::endl;
+}
+
+}
+
+BENCHMARK(topicParsing)
+{
+    const int iterations = 5000;
+    const std::string motorTopic = "rbus/0628252/0000000000001/rbus.get.status/result";
+    const MqttData motorMessage(motorTopic, "{\"results\":\"12,1000,50,false,false,true,34,20,false,false,false,false,true,false\"}");
+    const std::string wingTopic = "systemcontroller/config1/wing/9b2f0c1e-5d2a-4c1b-8a55-3f0e4b6c7d21/open";
+    const MqttData wingMessage(wingTopic);
+
+    std::size_t check = 0;
+    std::string id, command, action;
+    reportNsPerOp("motor topic regex", iterations, [&]() {
+        regexMotorTopic(motorTopic, id, command, action);
+        check += command.size();
+    });
+    reportNsPerOp("motor topic MotorData", iterations, [&]() {
+        MotorData motorData(motorMessage);
+        check += (motorData.getMotorCommand() == MotorCommand::GetStatus);
+    });
+    reportNsPerOp("wing topic regex", iterations, [&]() {
+        regexWingTopic(wingTopic, id, command);
+        check += command.size();
+    });
+    reportNsPerOp("wing topic WingData", iterations, [&]() {
+        WingData wingData(wingMessage);
+        check += (wingData.getWingCommand() == WingComandType::Open);
+    });
+    if (check == 0) {
+        std::cout << "unexpected: nothing parsed" << std::endl;
+    }
+}
@@ -2,50 +2,220 @@
 #define BUFFER_H
 
 #include "pch.h"
+#include <atomic>
 
-template<typename T>
-class Buffer
+// A notifier can be shared between multiple buffers so that one consumer
+// can wait on 'any of the buffers received a new message' instead of
+// polling every buffer one after the other
+class BufferNotifier
 {
     public:
-        int QueueNewMessage(const T &msg)
+        void notify()
         {
+            // already pending: the consumer did not pick up the previous notify yet
+            if (m_pending.exchange(true)) {
+                return;
+            }
             {
                 std::lock_guard<std::mutex> lock(m_mutex);
-                Messages.push(msg);
             }
             m_cv.notify_one();
-            return 0;
+        }
+        // returns true when notified, false on a timeout
+        // a notify given while the consumer was not waiting is not lost,
+        // the next wait returns immediately
+        bool waitFor(const std::chrono::milliseconds timeout)
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            const bool notified = m_cv.wait_for(lock, timeout, [this]() {return m_pending.load();});
+            m_pending.store(false);
+            return notified;
         }
 
-        int UnqueueMessage (T &msg)
+    private:
+        std::mutex m_mutex;
+        std::condition_variable m_cv;
+        std::atomic<bool> m_pending {false};
+};
+
+enum class OverflowPolicy 
+{
+    DropOldest, // the oldest message is removed to make room for the new one
+    Block       // the producer waits for room (up to the block timeout, then the oldest is dropped)
+};
+
+// Unbounded queue behind a mutex, the default storage of a Buffer
+template<typename T>
+class LockedQueue
+{
+    public:
+        explicit LockedQueue(std::size_t /*capacity*/) {}
+        bool tryPush(T && value)
         {
             std::lock_guard<std::mutex> lock(m_mutex);
-
-            if (Messages.size() == 0) {
-                return 0;
+            m_queue.push(std::move(value));
+            return true;
+        }
+        bool tryPop(T & value)
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_queue.empty()) {
+                return false;
             }
+            value = std::move(m_queue.front());
+            m_queue.pop();
+            return true;
+        }
+        std::size_t size() const 
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_queue.size();
+        }
+        bool empty() const { return size() == 0;}
+    private:
+        mutable std::mutex m_mutex;
+        std::queue<T> m_queue;
+};
 
-            msg = Messages.front();
-            Messages.pop();
+// Buffer between a producer and a consumer thread, the storage is a template parameter
+// so the lock-free RingBuffer can be used instead of the LockedQueue.
+// The consumer is only signaled when it is actually waiting.
+template<typename T, typename Storage = LockedQueue<T>>
+class Buffer
+{
+    public:
+        explicit Buffer(std::size_t capacity = 1024, OverflowPolicy policy = OverflowPolicy::DropOldest)
+            : m_queue(capacity)
+            , m_policy(policy)
+        {}
 
+        int QueueNewMessage(const T &msg)
+        {
+            T copy(msg);
+            return QueueNewMessage(std::move(copy));
+        }
+        int QueueNewMessage(T &&msg)
+        {
+            const auto blockDeadline = std::chrono::steady_clock::now() + m_blockTimeout;
+            while (!m_queue.tryPush(std::move(msg))) {
+                if (m_policy == OverflowPolicy::Block && std::chrono::steady_clock::now() < blockDeadline) {
+                    waitForSpace();
+                    continue;
+                }
+                T dropped;
+                if (m_queue.tryPop(dropped)) {
+                    m_droppedCount++;
+                    signalSpace();
+                }
+            }
+            signalNewMessage();
+            return 0;
+        }
+
+        int UnqueueMessage (T &msg)
+        {
+            if (!m_queue.tryPop(msg)) {
+                return 0;
+            }
+            signalSpace();
             return 1;
         }
+        // moves all available messages to the back of messages, returns the number of messages added
+        std::size_t UnqueueAll(std::vector<T> &messages)
+        {
+            std::size_t count = 0;
+            T msg;
+            while (m_queue.tryPop(msg)) {
+                messages.push_back(std::move(msg));
+                count++;
+            }
+            if (count > 0) {
+                signalSpace();
+            }
+            return count;
+        }
+        // wait until there is a message available or the timeout passed
+        // returns true when there is a message available
+        bool WaitForMessage(const std::chrono::milliseconds timeout)
+        {
+            if (!m_queue.empty()) {
+                return true;
+            }
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_waitingConsumers++;
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            const bool available = m_cv.wait_for(lock, timeout, [this]() {return !m_queue.empty();});
+            m_waitingConsumers--;
+            return available;
+        }
         unsigned int GetSize() {
+            return m_queue.size();
+        }
+        // number of messages removed because of an overflow
+        std::size_t GetDroppedCount() const {
+            return m_droppedCount.load();
+        }
+        // the notifier is signaled on every new message (next to the own condition variable)
+        void SetNotifier(std::shared_ptr<BufferNotifier> notifier)
+        {
             std::lock_guard<std::mutex> lock(m_mutex);
-            return Messages.size();
+            m_notifier.store(notifier.get());
+            m_notifierOwner = std::move(notifier);
         }
 
-    public:
-        std::condition_variable& conditionVariable()
+    private:
+        void signalNewMessage()
+        {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            BufferNotifier * notifier = m_notifier.load();
+            if (notifier) {
+                notifier->notify();
+            }
+            if (m_waitingConsumers.load() > 0) {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                }
+                m_cv.notify_one();
+            }
+        }
+        // only used by the Block policy, waits a short slice so a missed signal only costs one slice
+        void waitForSpace()
+        {
+            std::unique_lock<std::mutex> lock(m_spaceMutex);
+            m_blockedProducers++;
+            m_spaceCv.wait_for(lock, std::chrono::milliseconds(1), [this]() {return m_spaceSignaled;});
+            m_spaceSignaled = false;
+            m_blockedProducers--;
+        }
+        void signalSpace()
         {
-            return m_cv;
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (m_blockedProducers.load() > 0) {
+                {
+                    std::lock_guard<std::mutex> lock(m_spaceMutex);
+                    m_spaceSignaled = true;
+                }
+                m_spaceCv.notify_all();
+            }
         }
 
     private:
-        std::queue<T> Messages;
+        Storage m_queue;
+        const OverflowPolicy m_policy;
+        const std::chrono::milliseconds m_blockTimeout {1000};
 
-        mutable std::mutex m_mutex;
+        std::mutex m_mutex;
         std::condition_variable m_cv;
+        std::atomic<int> m_waitingConsumers {0};
+        std::atomic<BufferNotifier*> m_notifier {nullptr};
+        std::shared_ptr<BufferNotifier> m_notifierOwner;
+
+        std::mutex m_spaceMutex;
+        std::condition_variable m_spaceCv;
+        std::atomic<int> m_blockedProducers {0};
+        bool m_spaceSignaled = false;
+
+        std::atomic<std::size_t> m_droppedCount {0};
 };
 
 #endif // BUFFER_H
@@ -0,0 +1,76 @@
+#ifndef CALLBACKLIST_H
+#define CALLBACKLIST_H
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+
+// Fixed number of handler slots for one kind of event, without a map or allocation per event.
+// A handler gets the lowest free slot and is called in slot order, like the ids of the map it
+// replaces. The id of a handler holds the slot and a generation: an id that was removed
+// before never removes the handler that reuses its slot.
+// Not thread safe, the owner locks.
+template<typename Signature, std::size_t Capacity = 32>
+class CallbackList;
+
+template<typename... Args, std::size_t Capacity>
+class CallbackList<void(Args...), Capacity>
+{
+    static_assert(Capacity > 0 && Capacity <= 32, "the slots are tracked in a 32 bit mask");
+
+    public:
+        using Handler = std::function<void(Args...)>;
+
+        // throws std::length_error when all slots are in use
+        int add(Handler handler)
+        {
+            if (_usedSlots == fullMask()) {
+                throw std::length_error("No free handler slot left");
+            }
+            const std::size_t slot = lowestBit(~_usedSlots & fullMask());
+            _slots[slot] = std::move(handler);
+            _usedSlots |= bit(slot);
+            return (int)(_generations[slot] * Capacity + slot);
+        }
+        // an unknown or already removed id is ignored
+        void remove(int id)
+        {
+            if (id < 0) {
+                return;
+            }
+            const std::size_t slot = (std::size_t)id % Capacity;
+            if ((_usedSlots & bit(slot)) == 0 || _generations[slot] != (std::uint32_t)id / Capacity) {
+                return;
+            }
+            _usedSlots &= ~bit(slot);
+            _slots[slot] = nullptr;
+            _generations[slot] = (_generations[slot] + 1) % MaxGeneration;
+        }
+        // a handler removed by an earlier handler of the same call is skipped
+        void operator()(Args... args)
+        {
+            for (std::uint32_t pending = _usedSlots; pending != 0; pending &= pending - 1) {
+                const std::size_t slot = lowestBit(pending);
+                if (_usedSlots & bit(slot)) {
+                    _slots[slot](args...);
+                }
+            }
+        }
+        std::size_t size() const {return __builtin_popcount(_usedSlots);}
+        bool empty() const {return _usedSlots == 0;}
+
+    private:
+        // keeps the ids positive ints
+        static const std::uint32_t MaxGeneration = 0x7fffffff / Capacity;
+
+        static std::uint32_t bit(std::size_t slot) {return (std::uint32_t)1 << slot;}
+        static std::uint32_t fullMask() {return Capacity == 32 ? 0xffffffffu : bit(Capacity) - 1;}
+        static std::size_t lowestBit(std::uint32_t mask) {return __builtin_ctz(mask);}
+
+        std::array<Handler, Capacity> _slots;
+        std::array<std::uint32_t, Capacity> _generations {};
+        std::uint32_t _usedSlots = 0;
+};
+
+#endif //CALLBACKLIST_H
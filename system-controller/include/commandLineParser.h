@@ -13,13 +13,23 @@ class CommandLineParser
         bool tryParse (int argc, char **argv);   
         int getPort () const {return _port;}
         std::string getLogPath() const {return _logPath;}
+        // trace, debug, info, warning, error, critical or off
+        std::string getLogLevel() const {return _logLevel;}
         bool generateScriptsOn () const {return _isGenerateScriptsOn;}
+        bool useThreadedMqttLoop () const {return _isThreadedMqttLoopOn;}
+        // either one config file (-c) or a directory of config files (-d) is given
         std::string getConfigFilePath () const {return _filePathOfConfig;}
+        std::string getConfigDirectory () const {return _configDirectory;}
+        std::size_t getNumberOfMotorShards () const {return _numberOfMotorShards;}
         std::stringstream errorMessage;
     private:
         bool _isGenerateScriptsOn = false;
+        bool _isThreadedMqttLoopOn = false;
         std::string _filePathOfConfig = "";
+        std::string _configDirectory = "";
         std::string _logPath;
+        std::string _logLevel = "trace";
+        std::size_t _numberOfMotorShards = 1;
         
         int _port = 1883; 
             
@@ -3,6 +3,7 @@
 
 #include "pch.h"
 #include <mqttData.h>
+#include "timerWheel.h"
 
 enum class CommandType {
     SetParam,
@@ -30,29 +31,44 @@ class CommandsInfo {
         std::chrono::time_point<std::chrono::system_clock> timeOfPublish;
         bool isAcked = false;
         int resendCounter = 0;
+        TimerWheel::TimerId retryTimer = 0;
+        uint64_t retryGeneration = 0;
 };
 
+// unacked commands are resend from a timer on the shared timer wheel, no thread per manager
 class CommandsManager : public ICommandsManager {
            
     public:
-    CommandsManager();
-    ~CommandsManager () {}
+    explicit CommandsManager(TimerWheel & timerWheel = TimerWheel::getInstance());
+    ~CommandsManager ();
     void stopEvaluating() override;
     void startEvaluating() override;    
     void pushCommandoToBeSend(MqttData message, CommandType commandType) override; 
     void handleAck(const MqttData & ackMessage)  override;
     void setSendHandler(std::function<void(MqttData)> delegateSend) override;
     int getNumberOfManagedCommands() const;
+    // time after the publish before the command is resend for the n-th time
+    static std::chrono::milliseconds getResendDelay(int resendCounter);
 
     private:
+    // shared with the timer callbacks, a callback holds the mutex while it runs
+    // so detaching the owner waits for a running callback
+    struct TimerGuard {
+        std::mutex mutex;
+        CommandsManager * owner = nullptr;
+    };
     std::map<std::string, CommandsInfo> _commandsBuffer;
     std::tuple<std::string,CommandsInfo> _lastMoveCommand;
     std::function<void(MqttData &)> _delegateSend ;
-    void evaluateAllCommandsInBuffer();
+    void scheduleResend(const std::string & command, CommandsInfo & info, bool isMoveCommand);
+    void cancelResend(CommandsInfo & info);
+    void onResendTimer(const std::string & command, uint64_t generation, bool isMoveCommand);
     void send(MqttData & message) const;
     bool _sendDelegateIsSet = false;
     bool _isRunning = false;
-    std::thread _workerThread;
+    TimerWheel & _timerWheel;
+    std::shared_ptr<TimerGuard> _timerGuard;
+    uint64_t _nextRetryGeneration = 1;
     mutable std::mutex _mutex; // mark mutable to allow hold of mutex during const methods
     static const int _maxResendCountBeforeSlowDownOfSending=5;
 };
@@ -38,16 +38,21 @@ class ConfigObject {
 
 
 class ConfigBuilder {
-    public:                
-        static void parseFromJson(std::string json, std::vector<std::shared_ptr<IWing>> & wings, std::string & configId);
+    public:
+        // creates the motion manager of a motorized element, without a factory an MqttMotor is created
+        typedef std::function<std::shared_ptr<IMotorMotionManager>(const ConfigObject & motorObject)> MotorFactory;
+        static void parseFromJson(std::string json, std::vector<std::shared_ptr<IWing>> & wings, std::string & configId, const MotorFactory & motorFactory = MotorFactory());
+        // the elements, lengths and motors of the configuration, equal signatures build the same wings
+        static std::string getGraphSignature(std::string json, std::string & configId);
     protected:
         static void parseJsonToObjects(std::string json, std::vector<ConfigObject> & configObjects, std::string & configId);
-        static std::shared_ptr<IWing> parseWing(std::vector<ConfigObject>::iterator & startOfWing,std::vector<ConfigObject>::iterator & endOfWing, bool isLefOpening,const std::string &configId) ;
+        static std::shared_ptr<IWing> parseWing(std::vector<ConfigObject>::iterator & startOfWing,std::vector<ConfigObject>::iterator & endOfWing, bool isLefOpening,const std::string &configId, const MotorFactory & motorFactory = MotorFactory()) ;
         static void listWings(std::vector<ConfigObject> & configObjects, std::vector<std::tuple<std::vector<ConfigObject>::iterator,std::vector<ConfigObject>::iterator,bool>> & wingInfos);
-        static void connectWingsWithRelationsAndList(std::vector<std::tuple<std::vector<ConfigObject>::iterator,std::vector<ConfigObject>::iterator,bool>> & wingInfos, std::vector<std::shared_ptr<IWing>> & wings ,const std::string &configId) ;
+        static void connectWingsWithRelationsAndList(std::vector<std::tuple<std::vector<ConfigObject>::iterator,std::vector<ConfigObject>::iterator,bool>> & wingInfos, std::vector<std::shared_ptr<IWing>> & wings ,const std::string &configId, const MotorFactory & motorFactory = MotorFactory()) ;
     
     private:
         static void parseWing();
+        static std::shared_ptr<IMotorMotionManager> createMotor(const ConfigObject & motorObject, const MotorFactory & motorFactory);
 };
 
 #endif //CONFIGBUILDER_H
\ No newline at end of file
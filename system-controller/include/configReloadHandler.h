@@ -0,0 +1,22 @@
+#ifndef CONFIGRELOADHANDLER_H
+#define CONFIGRELOADHANDLER_H
+
+#include "pch.h"
+#include "topicHandler.h"
+
+// Reloads a hosted configuration on systemcontroller/<configId>/config/reload without a restart.
+// The payload is the new JSON configuration, an empty payload reloads the file it was loaded from.
+// The outcome is published on systemcontroller/<configId>/config/reload/result
+class ConfigReloadHandler : public TopicHandler {
+    public:
+        // returns true when the wings are rebuilt, false when only the system settings changed, throws on failure
+        typedef std::function<bool(const std::string & configId, const std::string & json)> ReloadFunction;
+        explicit ConfigReloadHandler(ReloadFunction reload);
+        std::string getType() const override {return "CONFIG";};
+    protected:
+        void handleNewInput(const MqttData & inputData) override;
+    private:
+        ReloadFunction _reload;
+};
+
+#endif //CONFIGRELOADHANDLER_H
@@ -0,0 +1,68 @@
+#ifndef CONFIGURATIONHOST_H
+#define CONFIGURATIONHOST_H
+
+#include "pch.h"
+#include "configBuilder.h"
+#include "configReloadHandler.h"
+#include "diagnosticsHandler.h"
+#include "motorsHandler.h"
+#include "strand.h"
+#include "wingsHandler.h"
+
+// Hosts one or more independent configurations in one process.
+// The configurations share the MotorsHandler (one subscription on rbus/#), the thread pool of the
+// wing strands and, through the topicHandlers, one MQTT connection. Every configuration has its
+// own WingsHandler that only subscribes on systemcontroller/<configId>/wing/#.
+// A configuration can be reloaded while running: when its elements and motors are unchanged only the
+// system settings are applied, otherwise the wings are rebuilt around the motors that are kept
+// (no new connection, configuration or calibration of those motors).
+class ConfigurationHost {
+    public:
+        explicit ConfigurationHost(std::size_t numberOfMotorShards = 1, std::shared_ptr<ThreadPool> threadPool = nullptr);
+
+        // parses and adds the configuration, returns its configId
+        // throws when the configId is already hosted or a motor is used by another configuration
+        std::string addConfiguration(const std::string & json, const ConfigBuilder::MotorFactory & motorFactory = ConfigBuilder::MotorFactory());
+        // reads the file and applies its system settings before adding the configuration, the file is used again on a reload
+        std::string addConfigurationFile(const std::string & path, const ConfigBuilder::MotorFactory & motorFactory = ConfigBuilder::MotorFactory());
+        // returns true when the wings are rebuilt, false when only the system settings changed
+        // throws when the configuration is not hosted or invalid, the running configuration is then kept
+        bool reloadConfiguration(const std::string & json);
+        bool reloadConfigurationFile(const std::string & configId);
+
+        // the motorsHandler, the wingsHandler of every configuration, the reload and the diagnostics handler
+        std::vector<std::shared_ptr<TopicHandler>> getTopicHandlers() const;
+        std::vector<std::string> getConfigurationIds() const;
+        std::vector<std::shared_ptr<IWing>> getWings(const std::string & configId) const;
+        std::shared_ptr<WingsHandler> getWingsHandler(const std::string & configId) const;
+        std::shared_ptr<MotorsHandler> getMotorsHandler() const {return _motorsHandler;}
+
+        // the JSON files of the directory, sorted by name
+        static std::vector<std::string> listConfigFiles(const std::string & directory);
+
+    private:
+        struct Configuration {
+            std::vector<std::shared_ptr<IWing>> wings;
+            std::shared_ptr<WingsHandler> wingsHandler;
+            std::string signature;
+            std::string file;
+            ConfigBuilder::MotorFactory motorFactory;
+            std::map<std::string,std::shared_ptr<IMotorMotionManager>> motors; // by pn/serial of the configuration
+            std::map<std::string,std::shared_ptr<IMqttMotor>> mqttMotors; // by motor id
+        };
+        std::string addConfiguration(const std::string & json, const ConfigBuilder::MotorFactory & motorFactory, const std::string & file);
+        // builds the wings of the configuration, the motors of the previous version are taken over
+        void buildWings(const std::string & json, Configuration & configuration, const Configuration & previous) const;
+        const Configuration & getConfiguration(const std::string & configId) const;
+
+        mutable std::mutex _mutex;
+        std::shared_ptr<ThreadPool> _threadPool;
+        std::shared_ptr<MotorsHandler> _motorsHandler;
+        std::shared_ptr<ConfigReloadHandler> _reloadHandler;
+        std::shared_ptr<DiagnosticsHandler> _diagnosticsHandler;
+        std::map<std::string, Configuration> _configurations;
+        std::vector<std::string> _configurationOrder;
+        std::set<std::string> _motorIds;
+};
+
+#endif // CONFIGURATIONHOST_H
@@ -0,0 +1,25 @@
+#ifndef DIAGNOSTICSHANDLER_H
+#define DIAGNOSTICSHANDLER_H
+
+#include "pch.h"
+#include "topicHandler.h"
+
+// Changes the logging of the running process on systemcontroller/<configId>/diag/loglevel.
+// The payload is a JSON object of which every member is optional, an empty payload changes nothing:
+//   {"level":"info", "subsystems":{"motor":"debug","commands":"warning"}, "rateLimit":{"messages":10,"periodMs":10000}}
+// The logging is shared by all configurations of the process, whichever configId is used.
+// The logging in use is published on systemcontroller/<configId>/diag/loglevel/result
+class DiagnosticsHandler : public TopicHandler {
+    public:
+        DiagnosticsHandler();
+        std::string getType() const override {return "DIAG";};
+
+        // nothing is applied when a member is not valid, throws std::invalid_argument then
+        static void applyLogSettings(const std::string & json);
+        // the levels, the rate limit and the number of messages the full log queue dropped
+        static std::string getLogSettings();
+    protected:
+        void handleNewInput(const MqttData & inputData) override;
+};
+
+#endif //DIAGNOSTICSHANDLER_H
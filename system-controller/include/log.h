@@ -1,6 +1,12 @@
 #ifndef LOG_H
 #define LOG_H
 
+// Levels below SPDLOG_ACTIVE_LEVEL are compiled out (cmake -DLOG_ACTIVE_LEVEL=INFO), all are kept by default
+#ifndef SPDLOG_ACTIVE_LEVEL
+#define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_TRACE
+#endif
+
+#include <atomic>
 #include <memory>
 #include <cstdlib>
 #include <iostream>
@@ -8,24 +14,87 @@
 #include "spdlog/sinks/stdout_color_sinks.h"
 #include "spdlog/sinks/rotating_file_sink.h"
 #include "spdlog/async.h"
+#include "logRateLimiter.h"
 
 class Log {
     public:
+        // parts of the controller with their own runtime level on top of the level of the logger
+        enum Subsystem {General, Motor, Wing, Mqtt, Commands, NumberOfSubsystems};
+
         static void Init();
-        static void Init( std::string logFolder);
+        static void Init( std::string logFolder, spdlog::level::level_enum level = spdlog::level::trace);
 
         inline static std::shared_ptr<spdlog::logger> & GetLogger() {return _logger;}
+
+        static void setLevel(Subsystem subsystem, spdlog::level::level_enum level);
+        static spdlog::level::level_enum getLevel(Subsystem subsystem);
+        // the log macros check this before their arguments are evaluated
+        inline static bool shouldLog(Subsystem subsystem, spdlog::level::level_enum level) {
+            return level >= _levels[subsystem].load(std::memory_order_relaxed) && _logger->should_log(level);
+        }
+        static const char * getSubsystemName(Subsystem subsystem);
+        static bool tryGetSubsystem(const std::string & name, Subsystem & subsystem);
+
+        // limits the messages of the LOG_SUBSYSTEM_LIMITED macro
+        static LogRateLimiter & getRateLimiter() {return _rateLimiter;}
+        // a full queue drops the oldest messages instead of blocking the thread that logs
+        static std::size_t getNumberOfDroppedMessages();
     private:
         static std::shared_ptr<spdlog::logger> _logger;
+        static std::atomic<int> _levels[NumberOfSubsystems];
+        static LogRateLimiter _rateLimiter;
 
 };
 
-#define LOG_CRITICAL(...) Log::GetLogger()->critical(__VA_ARGS__);
+// Takes one message or an fmt format string with its arguments: LOG_DEBUG("speed {} of {}", speed, id);
+#define LOG_SUBSYSTEM(subsystem, level, ...) do { if (Log::shouldLog(subsystem, level)) { Log::GetLogger()->log(level, __VA_ARGS__); } } while (0);
+#define LOG_DISABLED(...) do {} while (0);
+// Like LOG_SUBSYSTEM but at most a number of messages of one key per period (Log::getRateLimiter),
+// the first message after a drop is preceded by the number of messages of the key that were dropped
+#define LOG_SUBSYSTEM_LIMITED(subsystem, level, key, ...) do { std::size_t suppressed_ = 0; \
+    if (Log::shouldLog(subsystem, level) && Log::getRateLimiter().tryAcquire(key, suppressed_)) { \
+        if (suppressed_ > 0) { Log::GetLogger()->log(level, "{} messages like the next one were suppressed", suppressed_); } \
+        Log::GetLogger()->log(level, __VA_ARGS__); \
+    } } while (0);
+
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_CRITICAL
+#define LOG_SUBSYSTEM_CRITICAL(subsystem, ...) LOG_SUBSYSTEM(subsystem, spdlog::level::critical, __VA_ARGS__)
+#else
+#define LOG_SUBSYSTEM_CRITICAL(subsystem, ...) LOG_DISABLED()
+#endif
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_ERROR
+#define LOG_SUBSYSTEM_ERROR(subsystem, ...) LOG_SUBSYSTEM(subsystem, spdlog::level::err, __VA_ARGS__)
+#else
+#define LOG_SUBSYSTEM_ERROR(subsystem, ...) LOG_DISABLED()
+#endif
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_WARN
+#define LOG_SUBSYSTEM_WARNING(subsystem, ...) LOG_SUBSYSTEM(subsystem, spdlog::level::warn, __VA_ARGS__)
+#else
+#define LOG_SUBSYSTEM_WARNING(subsystem, ...) LOG_DISABLED()
+#endif
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_INFO
+#define LOG_SUBSYSTEM_INFO(subsystem, ...) LOG_SUBSYSTEM(subsystem, spdlog::level::info, __VA_ARGS__)
+#else
+#define LOG_SUBSYSTEM_INFO(subsystem, ...) LOG_DISABLED()
+#endif
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_DEBUG
+#define LOG_SUBSYSTEM_DEBUG(subsystem, ...) LOG_SUBSYSTEM(subsystem, spdlog::level::debug, __VA_ARGS__)
+#else
+#define LOG_SUBSYSTEM_DEBUG(subsystem, ...) LOG_DISABLED()
+#endif
+#if SPDLOG_ACTIVE_LEVEL <= SPDLOG_LEVEL_TRACE
+#define LOG_SUBSYSTEM_TRACE(subsystem, ...) LOG_SUBSYSTEM(subsystem, spdlog::level::trace, __VA_ARGS__)
+#else
+#define LOG_SUBSYSTEM_TRACE(subsystem, ...) LOG_DISABLED()
+#endif
+
+#define LOG_CRITICAL(...) LOG_SUBSYSTEM_CRITICAL(Log::General, __VA_ARGS__)
+// always logs, the exception is thrown whatever the level
 #define LOG_CRITICAL_THROW(msg) Log::GetLogger()->critical(msg); throw new std::runtime_error(msg);
-#define LOG_ERROR(...) Log::GetLogger()->error(__VA_ARGS__);
-#define LOG_WARNING(...) Log::GetLogger()->warn(__VA_ARGS__);
-#define LOG_DEBUG(...) Log::GetLogger()->debug(__VA_ARGS__);
-#define LOG_INFO(...)  Log::GetLogger()->info(__VA_ARGS__);
-#define LOG_TRACE(...) Log::GetLogger()->trace(__VA_ARGS__);
+#define LOG_ERROR(...) LOG_SUBSYSTEM_ERROR(Log::General, __VA_ARGS__)
+#define LOG_WARNING(...) LOG_SUBSYSTEM_WARNING(Log::General, __VA_ARGS__)
+#define LOG_DEBUG(...) LOG_SUBSYSTEM_DEBUG(Log::General, __VA_ARGS__)
+#define LOG_INFO(...)  LOG_SUBSYSTEM_INFO(Log::General, __VA_ARGS__)
+#define LOG_TRACE(...) LOG_SUBSYSTEM_TRACE(Log::General, __VA_ARGS__)
 
-#endif //LOG_H
\ No newline at end of file
+#endif //LOG_H
@@ -0,0 +1,43 @@
+#ifndef LOGRATELIMITER_H
+#define LOGRATELIMITER_H
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Lets a number of log messages of one key through in every period and counts the ones it drops,
+// a storm of the same message (a motor that never acks) can't fill the queue of the logger.
+class LogRateLimiter {
+    public:
+        typedef std::chrono::steady_clock Clock;
+
+        // 0 messages per period is no limit
+        LogRateLimiter(std::size_t messagesPerPeriod, std::chrono::milliseconds period);
+
+        // true when a message of the key may be logged, suppressed is then the number of messages
+        // of the key that were dropped since the last one that was let through
+        bool tryAcquire(const std::string & key, std::size_t & suppressed, Clock::time_point now = Clock::now());
+
+        void setLimit(std::size_t messagesPerPeriod, std::chrono::milliseconds period);
+        std::size_t getMessagesPerPeriod() const;
+        std::chrono::milliseconds getPeriod() const;
+
+        // with more keys the ones of which the period has passed are forgotten
+        static const std::size_t MaxKeys = 1024;
+
+    private:
+        struct KeyState {
+            Clock::time_point periodStart;
+            std::size_t logged = 0;
+            std::size_t suppressed = 0;
+        };
+        void forgetPassedPeriods(Clock::time_point now);
+
+        mutable std::mutex _mutex;
+        std::size_t _messagesPerPeriod;
+        std::chrono::milliseconds _period;
+        std::unordered_map<std::string, KeyState> _keys;
+};
+
+#endif //LOGRATELIMITER_H
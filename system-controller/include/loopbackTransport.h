@@ -0,0 +1,74 @@
+#ifndef LOOPBACKTRANSPORT_H
+#define LOOPBACKTRANSPORT_H
+
+#include "pch.h"
+#include "transport.h"
+#include "buffer.h"
+#include "ringBuffer.h"
+#include "subscriptionMatcher.h"
+
+// In-process message bus with the subscription rules of MQTT (QoS 0, no retained messages).
+// A publish copies the message (only the reference to the text) into the inbox of every
+// transport with a matching subscription, the transports deliver it from their own loop.
+// Like a broker a full inbox drops its oldest message.
+class LoopbackBus {
+    public:
+        typedef Buffer<MqttData, RingBuffer<MqttData>> Inbox;
+
+        // returns the id of the new endpoint
+        int attach(const std::shared_ptr<Inbox> & inbox);
+        void detach(int endpoint);
+        void subscribe(int endpoint, const std::string & subscription);
+        void publish(const MqttData & data);
+
+        std::size_t getNumberOfPublishedMessages() const;
+        std::size_t getNumberOfDeliveredMessages() const;
+
+    private:
+        void compileSubscriptions();
+
+        mutable std::mutex _mutex;
+        std::map<int, std::shared_ptr<Inbox>> _inboxes;
+        std::vector<std::pair<std::string, int>> _subscriptionList;
+        SubscriptionMatcher _subscriptions; // subscriber = endpoint id
+        int _nextEndpoint = 0;
+        std::size_t _publishedMessages = 0;
+        std::size_t _deliveredMessages = 0;
+};
+
+// Transport on a LoopbackBus, peers in the same process (simulated motors, test clients)
+// use their own LoopbackTransport on the same bus
+class LoopbackTransport : public ITransport {
+    public:
+        explicit LoopbackTransport(std::shared_ptr<LoopbackBus> bus, std::size_t inboxCapacity = DefaultInboxCapacity);
+        ~LoopbackTransport();
+
+        void setMessageHandler(MessageHandler messageHandler) override {_messageHandler = messageHandler;}
+        void setConnectionHandler(ConnectionHandler connectionHandler) override {_connectionHandler = connectionHandler;}
+        bool connect() override;
+        void disconnect() override;
+        bool subscribe(const std::string & subscription) override;
+        bool publish(const MqttData & data) override;
+        bool loop() override;
+        bool startThreadedLoop() override;
+        void stopThreadedLoop() override;
+
+        bool isConnected() const {return _endpoint >= 0;}
+        std::size_t getDroppedCount() const {return _inbox->GetDroppedCount();}
+
+        static const std::size_t DefaultInboxCapacity = 4096;
+        static const std::chrono::milliseconds LoopTimeout;
+
+    private:
+        std::shared_ptr<LoopbackBus> _bus;
+        std::shared_ptr<LoopbackBus::Inbox> _inbox;
+        std::atomic<int> _endpoint {-1};
+        MessageHandler _messageHandler;
+        ConnectionHandler _connectionHandler;
+        std::vector<MqttData> _received; // only used by loop
+
+        std::atomic<bool> _threadedLoopRunning {false};
+        std::thread _loopThread;
+};
+
+#endif //LOOPBACKTRANSPORT_H
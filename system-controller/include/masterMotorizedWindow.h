@@ -35,6 +35,8 @@ class MasterMotorizedWindow  : public MotorizedWindow  {
         int const maximumStrokeForCalibration = 20000;
         void onPositionUpdate(int newPosition) override;
         bool isOntarget();
+        // the panel lengths follow the stroke of the motor, called when the motor is calibrated
+        void updatePanelLengtsBasedOnstroke();
         
     protected : 
         int _target;   
@@ -47,7 +49,7 @@ class MasterMotorizedWindow  : public MotorizedWindow  {
         void manageOperationalMovement() ;    
         bool calibrateWorker(std::future<void> cancelObj);
         void stopCalibrationWorkers();        
-        void updatePanelLengtsBasedOnstroke();
+        int _calibratedHandlerId;
         
         std::promise<void> _cancelWorkerCalibOpenSignal;
         std::promise<void> _cancelWorkerCalibCloseSignal;
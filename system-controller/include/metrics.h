@@ -0,0 +1,111 @@
+#ifndef METRICS_H
+#define METRICS_H
+
+#include "pch.h"
+#include <array>
+#include <atomic>
+
+// Metrics that are cheap enough to record on every event: no lock and no allocation when recording.
+// A metric is looked up once by name in the MetricsRegistry, the hot path keeps the reference.
+
+// Number of events. Every thread adds to its own shard, threads don't contend on one cache line.
+class Counter {
+    public:
+        void add(uint64_t value = 1) {_shards[getShard()].value.fetch_add(value, std::memory_order_relaxed);}
+        uint64_t get() const;
+
+        static const std::size_t NumberOfShards = 8;
+
+    private:
+        // padded to a cache line, the value of two shards never shares one
+        struct Shard {
+            std::atomic<uint64_t> value {0};
+            char padding[64 - sizeof(std::atomic<uint64_t>)];
+        };
+        static std::size_t getShard();
+
+        std::array<Shard, NumberOfShards> _shards;
+};
+
+// Last value of a level, like a number of pending timers
+class Gauge {
+    public:
+        void set(int64_t value) {_value.store(value, std::memory_order_relaxed);}
+        void add(int64_t value) {_value.fetch_add(value, std::memory_order_relaxed);}
+        int64_t get() const {return _value.load(std::memory_order_relaxed);}
+
+    private:
+        std::atomic<int64_t> _value {0};
+};
+
+// Distribution of values (durations in µs, queue depths) in log-linear buckets like an HDR histogram:
+// every power of two is split in 8 buckets, a percentile is off by at most 12.5%
+class Histogram {
+    public:
+        typedef std::chrono::steady_clock Clock;
+
+        struct Summary {
+            uint64_t count = 0;
+            uint64_t p50 = 0;
+            uint64_t p90 = 0;
+            uint64_t p99 = 0;
+            uint64_t max = 0;
+        };
+
+        void record(uint64_t value);
+        // the µs since start
+        void recordSince(Clock::time_point start) {
+            record((uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count());
+        }
+        Summary getSummary() const;
+
+        static const int SubBucketBits = 3;
+        static const std::size_t NumberOfBuckets = (64 - SubBucketBits + 1) << SubBucketBits;
+        static std::size_t getBucket(uint64_t value);
+        // the highest value that lands in the bucket
+        static uint64_t getBucketLimit(std::size_t bucket);
+
+    private:
+        std::array<std::atomic<uint64_t>, NumberOfBuckets> _buckets {};
+        std::atomic<uint64_t> _max {0};
+};
+
+// records the µs from construction to destruction of the scope
+class ScopedTimer {
+    public:
+        explicit ScopedTimer(Histogram & histogram) : _histogram(histogram), _start(Histogram::Clock::now()) {}
+        ~ScopedTimer() {_histogram.recordSince(_start);}
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+        Histogram & _histogram;
+        const Histogram::Clock::time_point _start;
+};
+
+// All metrics of the process by name, a metric is never removed so its reference stays valid
+class MetricsRegistry {
+    public:
+        static MetricsRegistry& getInstance();
+
+        // the same name always returns the same metric
+        Counter & getCounter(const std::string & name);
+        Gauge & getGauge(const std::string & name);
+        Histogram & getHistogram(const std::string & name);
+
+        // all metrics as one compact JSON object:
+        // {"counters":{name:value},"gauges":{name:value},"histograms":{name:{"n":..,"p50":..,"p90":..,"p99":..,"max":..}}}
+        std::string getSnapshot() const;
+
+    private:
+        MetricsRegistry() = default;
+        MetricsRegistry(const MetricsRegistry&) = delete;
+        MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+        mutable std::mutex _mutex;
+        std::map<std::string, std::unique_ptr<Counter>> _counters;
+        std::map<std::string, std::unique_ptr<Gauge>> _gauges;
+        std::map<std::string, std::unique_ptr<Histogram>> _histograms;
+};
+
+#endif //METRICS_H
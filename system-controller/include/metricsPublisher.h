@@ -0,0 +1,41 @@
+#ifndef METRICSPUBLISHER_H
+#define METRICSPUBLISHER_H
+
+#include "pch.h"
+#include "timerWheel.h"
+#include "topicHandler.h"
+
+// Publishes the snapshot of the MetricsRegistry on systemcontroller/<configId>/metrics for every
+// hosted configuration, every period while started and on a message on systemcontroller/<configId>/metrics/get.
+// The metrics are those of the whole process, every configuration gets the same snapshot.
+class MetricsPublisher : public TopicHandler {
+    public:
+        typedef std::function<std::vector<std::string>()> ConfigIdsFunction;
+        MetricsPublisher(ConfigIdsFunction getConfigIds, std::chrono::milliseconds period = std::chrono::seconds(10), TimerWheel & timerWheel = TimerWheel::getInstance());
+        ~MetricsPublisher();
+        std::string getType() const override {return "METRICS";};
+        void start() override;
+        void stop() override;
+
+        // samples the gauges of the process (log queue, timers) and returns the snapshot
+        static std::string getSnapshot();
+
+    protected:
+        void handleNewInput(const MqttData & inputData) override;
+
+    private:
+        // a running timer callback holds the mutex, detaching the owner waits for it
+        struct TimerGuard {
+            std::mutex mutex;
+            MetricsPublisher * owner = nullptr;
+        };
+        void schedulePublish();
+        void publish(const std::string & configId, const std::string & snapshot);
+
+        ConfigIdsFunction _getConfigIds;
+        const std::chrono::milliseconds _period;
+        TimerWheel & _timerWheel;
+        std::shared_ptr<TimerGuard> _timerGuard;
+};
+
+#endif //METRICSPUBLISHER_H
@@ -3,16 +3,16 @@
 
 #include "pch.h"
 #include "mqttData.h"
+#include <cstring>
 
 
 
 class MosquittoToMqttDataConverter {
     public:
         static MqttData CreateMqttData( const struct mosquitto_message *msg) {
-            
-            std::string msgTopic = (char *) msg->topic;    
-            std::string payload = (msg->payloadlen != 0) ? ((char *) msg->payload) : "";
-            return MqttData(msgTopic,payload);
+            const char * payload = (msg->payloadlen > 0) ? ((const char *) msg->payload) : "";
+            const std::size_t payloadLength = (msg->payloadlen > 0) ? msg->payloadlen : 0;
+            return MqttData(msg->topic, std::strlen(msg->topic), payload, payloadLength);
         }
 };
 
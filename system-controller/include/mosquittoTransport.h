@@ -0,0 +1,35 @@
+#ifndef MOSQUITTOTRANSPORT_H
+#define MOSQUITTOTRANSPORT_H
+
+#include "pch.h"
+#include "transport.h"
+
+// Transport over an MQTT broker with the mosquitto client library
+class MosquittoTransport : public ITransport, public mosqpp::mosquittopp {
+    public:
+        MosquittoTransport(std::string ip, const int port, const std::string & mqttId);
+        ~MosquittoTransport();
+
+        void setMessageHandler(MessageHandler messageHandler) override {_messageHandler = messageHandler;}
+        void setConnectionHandler(ConnectionHandler connectionHandler) override {_connectionHandler = connectionHandler;}
+        bool connect() override;
+        void disconnect() override;
+        bool subscribe(const std::string & subscription) override;
+        bool publish(const MqttData & data) override;
+        bool loop() override;
+        bool startThreadedLoop() override;
+        void stopThreadedLoop() override;
+
+        void on_message(const struct mosquitto_message *msg) override;
+        void on_connect(int rc) override;
+        void on_disconnect(int rc) override;
+
+    private:
+        std::string _ip;
+        int _port;
+        MessageHandler _messageHandler;
+        ConnectionHandler _connectionHandler;
+        bool _threadedLoopStarted = false;
+};
+
+#endif //MOSQUITTOTRANSPORT_H
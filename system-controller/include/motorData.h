@@ -4,6 +4,26 @@
 #include "pch.h"
 
 #include "mqttData.h"
+#include "topicTokenizer.h"
+
+// the commands of the motor api (the level after the serial in the topic)
+enum class MotorCommand {
+    GetStatus,
+    GetMinSpeed,
+    GetMaxSpeed,
+    GetStroke,
+    GetEmergencyRun,
+    SetSpeed,
+    SetPositionMm,
+    SetUserLevel,
+    Open,
+    Close,
+    Stop,
+    CalibClear,
+    Unknown
+};
+MotorCommand toMotorCommand(const StringSpan & command);
+const char * toString(MotorCommand command);
 
 enum class MotorStatus {
     Idle,
@@ -15,10 +35,15 @@ enum class MotorStatus {
 
 struct MotorStatusData {
     int posMm =0;
+    int posPerc=0;
     int speedMm=0;
     bool isLocked=false; 
     bool isOpen=false; 
     bool isClosed=false;
+    int temperature=0;
+    int current=0;
+    int buttons[3] = {0,0,0};
+    bool boolButtons[2] = {false,false};
     bool isCalibrated=false;
     bool isEmergencyRun=false;
 
@@ -39,26 +64,30 @@ class IMotorData {
     virtual ~IMotorData(){}
     virtual std::string getId() const =0;
     virtual std::string getCommand() const =0;    
-    virtual MqttData getMqttData() const =0;
+    virtual const MqttData & getMqttData() const =0;
 };
 
+// The id and command are views on the topic of the (shared) MqttData, parsing does not allocate
 class MotorData : public IMotorData {
     public:
         MotorData(const MqttData &mqttData);
         std::string getId()const  override;
-        std::string getCommand() const {return _command;}       
+        std::string getCommand() const {return _command.str();}       
+        StringSpan getIdSpan() const {return _id;}
+        MotorCommand getMotorCommand() const {return _motorCommand;}
         bool hasInfo() const {return _hasInfo;} 
         bool isAck() const {return _isAck;} 
         void parseOneValue(int & value) const;
         void parseStatusData(MotorStatusData & motorStatus) const ;
-        MqttData getMqttData() const override {return _mqttData;}   
+        const MqttData & getMqttData() const override {return _mqttData;}   
 
     private:
         MqttData _mqttData;
-        std::string _id;
-        std::string _command;
-        bool _hasInfo;
-        bool _isAck;
+        StringSpan _id;         // pn/serial
+        StringSpan _command;
+        MotorCommand _motorCommand = MotorCommand::Unknown;
+        bool _hasInfo = false;
+        bool _isAck = false;
     };
 
 #endif //WINGDATA_H
\ No newline at end of file
@@ -4,6 +4,8 @@
 
 #include "pch.h"
 #include "motorData.h"
+#include "strand.h"
+#include "callbackList.h"
 
 
 // this manager will abstract the communication details
@@ -30,13 +32,23 @@ class  IMotorMotionManager {
         virtual int addOnPositionUpdatehandler(std::function<void(int)> onPositionUpdatehandler) =0;
         virtual int addOnMotorStatusUpdatehandler(std::function<void(MotorStatus)> onMotorStatusUpdatehandler) =0;
         virtual int addOnMotorCalibratedhandler(std::function<void(void)> onMotorCalibratedhandler) =0;
+        // the owner of a handler removes it before it is destroyed, the motor can outlive it (configuration reload)
+        virtual void removeOnPositionUpdatehandler(int handlerId) =0;
+        virtual void removeOnMotorStatusUpdatehandler(int handlerId) =0;
+        virtual void removeOnMotorCalibratedhandler(int handlerId) =0;
+        // hint that the motor status is needed more often for a while (for example a sibling is close)
+        virtual void requestFastPolling() {}
+        // the handlers are called on the strand instead of on the thread that updates the motor status,
+        // without a strand (nullptr) they are called directly
+        virtual void setCallbackStrand(const std::shared_ptr<Strand> & strand) {std::atomic_store(&_callbackStrand, strand);}
 
     protected:
-        std::map<int,std::function<void(int)>> _onPositionUpdateHandlers;
-        std::map<int,std::function<void(MotorStatus)>> _onMotorStatusUpdateHandlers;
-        std::map<int,std::function<void(void)>> _onMotorCalibratedHandlers;
+        CallbackList<void(int)> _onPositionUpdateHandlers;
+        CallbackList<void(MotorStatus)> _onMotorStatusUpdateHandlers;
+        CallbackList<void()> _onMotorCalibratedHandlers;
         MotorStatus _lastMotorStatus = MotorStatus::Idle;
         bool _lastCalibratedStatus = false;
+        std::shared_ptr<Strand> _callbackStrand; // only accessed with std::atomic_load/store
 };
 
 
@@ -49,8 +61,15 @@ class MotorMotionManager : public IMotorMotionManager {
         int addOnPositionUpdatehandler(std::function<void(int)> onPositionUpdatehandler) override;
         int addOnMotorStatusUpdatehandler(std::function<void(MotorStatus)> onMotorStatusUpdatehandler) override;
         int addOnMotorCalibratedhandler(std::function<void(void)> onMotorCalibratedhandler) override;
+        void removeOnPositionUpdatehandler(int handlerId) override;
+        void removeOnMotorStatusUpdatehandler(int handlerId) override;
+        void removeOnMotorCalibratedhandler(int handlerId) override;
     protected:
         void updateMotionData(MotorStatusData data);
+    private:
+        void notifyHandlers(MotorStatus status, int posMm, bool isStatusChanged, bool isCalibrated);
+        // recursive as a handler can register another handler on the same motor
+        std::recursive_mutex _handlersMutex;
 };
 
 
@@ -75,17 +94,17 @@ class EmptyMotionManager: public IMotorMotionManager {
         std::future<bool> clearCalibration() override {return std::async(std::launch::async,[](){return true;});}
 
         int addOnPositionUpdatehandler(std::function<void(int)> onPositionUpdatehandler) override {
-            throw new std::logic_error("Empty motion manager has not motor position to change and doesn't need a handler!");
-            return -1;
+            throw std::logic_error("Empty motion manager has not motor position to change and doesn't need a handler!");
         }
         int addOnMotorStatusUpdatehandler(std::function<void(MotorStatus)> onMotorStatusUpdatehandler) override {
-            throw new std::logic_error("Empty motion manager has no motor status to change and doesn't need a handler!");
-            return -1;
+            throw std::logic_error("Empty motion manager has no motor status to change and doesn't need a handler!");
         }
         int addOnMotorCalibratedhandler(std::function<void(void)> onMotorCalibratedhandler) override {
-            throw new std::logic_error("Empty motion manager has no motor to calibrate and doesn't need a calibtraion handler!");
-            return -1;
+            throw std::logic_error("Empty motion manager has no motor to calibrate and doesn't need a calibtraion handler!");
         };
+        void removeOnPositionUpdatehandler(int handlerId) override {}
+        void removeOnMotorStatusUpdatehandler(int handlerId) override {}
+        void removeOnMotorCalibratedhandler(int handlerId) override {}
     
 };
 
@@ -0,0 +1,19 @@
+#ifndef MOTORSTATUSPARSER_H
+#define MOTORSTATUSPARSER_H
+
+#include "pch.h"
+#include "motorData.h"
+
+// Parser for the result of rbus.get.status: {"results":"posMm,posPerc,speedMm,locked,open,closed,..."}
+// The payload is scanned once, no JSON document is built and nothing is allocated.
+// On an invalid payload false is returned and the status is left untouched.
+class MotorStatusParser
+{
+    public:
+        static bool parse(const char * payload, std::size_t length, MotorStatusData & status);
+        static bool parse(const std::string & payload, MotorStatusData & status) {
+            return parse(payload.data(), payload.size(), status);
+        }
+};
+
+#endif //MOTORSTATUSPARSER_H
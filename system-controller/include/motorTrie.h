@@ -0,0 +1,40 @@
+#ifndef MOTORTRIE_H
+#define MOTORTRIE_H
+
+#include "pch.h"
+#include "topicTokenizer.h"
+
+class IMqttMotor;
+
+// Immutable trie from a motor id (pn/serial) to the motor.
+// A lookup walks the id once, the cost does not depend on the number of motors.
+// The trie is built once and never changed, so it can be read without a lock;
+// adding a motor means building a new trie.
+class MotorTrie
+{
+    public:
+        MotorTrie();
+        explicit MotorTrie(const std::map<std::string, std::shared_ptr<IMqttMotor>> & motors);
+        // returns nullptr when the id is unknown
+        IMqttMotor * find(const StringSpan & id) const;
+        std::size_t size() const { return _size;}
+
+    private:
+        struct Node {
+            std::uint32_t firstEdge = 0;
+            std::uint32_t edgeCount = 0;
+            IMqttMotor * motor = nullptr;
+        };
+        struct Edge {
+            char c;
+            std::uint32_t child;
+        };
+        typedef std::vector<std::pair<std::string, IMqttMotor *>> Keys;
+        std::uint32_t build(const Keys & keys, std::size_t begin, std::size_t end, std::size_t depth);
+
+        std::vector<Node> _nodes;
+        std::vector<Edge> _edges;
+        std::size_t _size = 0;
+};
+
+#endif //MOTORTRIE_H
@@ -8,7 +8,7 @@
 
 class MotorizedWindow  : public MovingWindow ,public std::enable_shared_from_this<MotorizedWindow> {
     public:
-        virtual ~MotorizedWindow() {}
+        virtual ~MotorizedWindow();
         MotorizedWindow( int length, std::shared_ptr<IMotorMotionManager> motionManager);
         void push(PushType push) override;
         void stopWindow() override;      
@@ -16,7 +16,8 @@ class MotorizedWindow  : public MovingWindow ,public std::enable_shared_from_thi
         virtual void clearCalibration();
         std::vector<std::shared_ptr<MotorizedWindow>> getSlaveMotors() const ;
     private:
-        void getMotorsRecursive(std::vector<std::shared_ptr<MotorizedWindow>> & motors, std::shared_ptr<IMovingWindow> curr) const;
+        int _positionHandlerId;
+        static void getMotorsRecursive(std::vector<std::shared_ptr<MotorizedWindow>> & motors, const IMovingWindow & curr);
 };
 
 
@@ -6,20 +6,36 @@
 #include "motorizedWindow.h"
 #include "motorData.h"
 #include "mqttMotor.h"
+#include "motorTrie.h"
+#include <atomic>
 
+// The input can be spread over multiple shards, all input of one motor is handled by the same shard
 class MotorsHandler : public TopicHandler {
     public:
-        MotorsHandler();
-        ~MotorsHandler(){};
+        explicit MotorsHandler(std::size_t numberOfShards = 1);
+        ~MotorsHandler();
         void handleNewInput ( const MqttData & inputData) override;
         void handleOutput(const MqttData & data);
+        // a motor added while running is connected right away
         void addMotor(const std::shared_ptr<IMqttMotor>& motionHanlder);
+        // disconnects the motor, its input is ignored from then on
+        void removeMotor(const std::string & motorId);
         void start() override;
         void stop() override;
         std::string getType() const override {return "MOTORS";};        
+    protected:
+        // rbus/<pn>/<serial>
+        std::size_t getShardKey(const MqttData & data) const override {return hashTopicLevels(data.getTopic(), 3);}
     private :
+        void publishMotorTrie();
         std::map<std::string,std::shared_ptr<IMqttMotor>> _motors;
         std::mutex _motorsMap_mutex;
+        // the input lookup reads the current trie without a lock (a snapshot), adding a motor 
+        // publishes a new trie. Old tries are kept until destruction as a reader can still use them.
+        std::atomic<const MotorTrie *> _motorTrie;
+        std::vector<std::unique_ptr<const MotorTrie>> _motorTries;
+        // an old trie can still hand input to a removed motor, it is kept alive as well
+        std::vector<std::shared_ptr<IMqttMotor>> _removedMotors;
 };
 
 #endif //MOTORSHANDLER_H
\ No newline at end of file
@@ -3,6 +3,7 @@
 #define MOVINGWINDOW_H
 
 #include "pch.h"
+#include <atomic>
 #include "motorMotionManager.h"
 #include "motorData.h"
 #include "systemSettings.h"
@@ -32,7 +33,8 @@ class IMovingWindow {
         
         virtual ~IMovingWindow() {}
         virtual void addSlave(std::shared_ptr<IMovingWindow> slave, SlaveType slaveType) =0;
-        virtual std::vector<std::shared_ptr<IMovingWindow>> getSlaves() const = 0;
+        virtual const std::vector<std::shared_ptr<IMovingWindow>> & getSlaves() const = 0;
+        virtual const std::vector<SlaveType> & getSlaveTypes() const = 0; // same order as getSlaves
         virtual int getPosition() =0 ; 
         virtual int getTarget()=0;
         virtual int getSpeed() =0;
@@ -56,7 +58,8 @@ class MovingWindow: public IMovingWindow {
     public:
         virtual ~MovingWindow() {}
         void addSlave(std::shared_ptr<IMovingWindow> slave, SlaveType slaveType) override;        
-        std::vector<std::shared_ptr<IMovingWindow>> getSlaves() const override;  
+        const std::vector<std::shared_ptr<IMovingWindow>> & getSlaves() const override {return _slaveWindows;}
+        const std::vector<SlaveType> & getSlaveTypes() const override {return _slaveTypes;}
         int getPosition() override {return _position;}
         int getTarget() override {return _position;} // should be overriden by master
         int getSpeed() override {return _speed;}
@@ -69,6 +72,8 @@ class MovingWindow: public IMovingWindow {
         void updateWithCurrentPosition() override;
         static MovementFreedom GetLeastAllowedMovement (MovementFreedom  m1 , MovementFreedom m2);
         void updateAllPanelLenghts( int newPanelLength) override;
+        // changes each time a slave is added somewhere below this window
+        unsigned int getStructureVersion() const {return _structureVersion;}
 
         
     protected:
@@ -81,11 +86,27 @@ class MovingWindow: public IMovingWindow {
         PushType _pushType;
         MovementFreedom _freeToMove = MovementFreedom::None;  
         std::shared_ptr<IMotorMotionManager> _motionManager;
-        // store slaves with a slave type to identify 
-        std::vector<std::tuple<std::shared_ptr<IMovingWindow>,SlaveType>> _slaves; 
+        // the slaves and their slave type, same index in both
+        std::vector<std::shared_ptr<IMovingWindow>> _slaveWindows;
+        std::vector<SlaveType> _slaveTypes;
+        MovingWindow * _master = nullptr;
+        std::atomic<unsigned int> _structureVersion {0};
         
     private:
-        void handleSlaveOnPushOpen(MovementFreedom & canStartOwnMovement, const std::shared_ptr<IMovingWindow>& slave, SlaveType slaveType) ;
-        void handleSlaveOnPullClose(MovementFreedom & canStartOwnMovement, std::shared_ptr<IMovingWindow> slave, SlaveType slaveType) ;
+        // the distances of the push zones for one settings snapshot and panel length,
+        // only computed again when one of them changed
+        struct PushThresholds {
+            const SystemSettingsSnapshot * settings = nullptr;
+            int length = 0;
+            int openChicanZone = 0; // chican zone measured from the position (own length already subtracted)
+            int openChicanOverlap = 0;
+            int chicanZone = 0;
+            int chicanOverlap = 0;
+            int slowdownDist = 0;
+        };
+        PushThresholds _thresholds;
+        const PushThresholds & getThresholds();
+        void handleSlaveOnPushOpen(MovementFreedom & canStartOwnMovement, const PushThresholds & thresholds, const std::shared_ptr<IMovingWindow>& slave, SlaveType slaveType) ;
+        void handleSlaveOnPullClose(MovementFreedom & canStartOwnMovement, const PushThresholds & thresholds, const std::shared_ptr<IMovingWindow>& slave, SlaveType slaveType) ;
 };
 #endif //MOVINGWINDOW_H
\ No newline at end of file
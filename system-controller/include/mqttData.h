@@ -3,8 +3,11 @@
 
 #include "pch.h"
 #include "buffer.h"
+#include "sharedText.h"
 #include <unordered_set>
 
+// The topic is interned and the payload is a shared immutable text,
+// copying an MqttData (for example to multiple topicHandlers) never copies the text itself
 class MqttData {
     public:
         MqttData(){};
@@ -12,27 +15,28 @@ class MqttData {
         MqttData(const std::string & topic , const std::string & payload);
         MqttData(const std::string & topic , const std::string & parameter, const std::string & id);
         MqttData(const std::string & topic , int parameterValue, const std::string & id);
+        MqttData(const char * topic, std::size_t topicLength, const char * payload, std::size_t payloadLength);
 
-        std::string getTopic() const { return _topic;}
-        std::string getPayload() const { return _payload;}
+        const std::string & getTopic() const { return _topic.str();}
+        const std::string & getPayload() const { return _payload.str();}
         std::size_t getHash() const {
-            std::size_t h1 = std::hash<std::string>{}(_topic);
-            std::size_t h2 = std::hash<std::string>{}(_payload);
+            std::size_t h1 = std::hash<std::string>{}(_topic.str());
+            std::size_t h2 = std::hash<std::string>{}(_payload.str());
             return h1 ^ (h2 << 1); // combine hash
         }
 
         rapidjson::Document  getParsedJsonDoc() const ;     
         operator std::string() const { 
-            if (_payload.find("\"parameters\":\"\"") != std::string::npos) {
-                return _topic + " [ no params ]";
+            if (getPayload().find("\"parameters\":\"\"") != std::string::npos) {
+                return getTopic() + " [ no params ]";
             } else  {
-                return _topic + " [" + _payload + "]"; 
+                return getTopic() + " [" + getPayload() + "]"; 
             }
         }
 
     private:
-        std::string _topic;
-        std::string _payload;
+        SharedText _topic;
+        SharedText _payload;
         
 };
 
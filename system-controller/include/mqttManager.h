@@ -3,7 +3,9 @@
 
 #include "pch.h"
 #include "topicHandler.h"
-#include <mosquittoToMqttData.h>
+#include "subscriptionMatcher.h"
+#include "transport.h"
+#include "outbox.h"
 
 
 // The MqttManager handles only incoming MQTT messages and outgoing messages
@@ -13,21 +15,27 @@
 // input buffer and will fill the output buffer to be sent.
 
 // Sending Mqtt messages out 
-// -> the outputbuffer of each topic is checked and all messages are pushed out
+// -> all outputbuffers share one notifier, the sending worker wakes up as soon as any 
+//    topicHandler queued a message and pushes out the messages of all outputbuffers
+// -> the messages of one wake-up (plus the flush window) go through an outbox that only sends
+//    the latest speed/stop of a motor and the latest position of a wing
 
 // Reading Mqtt messages
-// -> On_message will be called when an MqttMessage is received. A filter function of the 
-// topics is used to determine if the new message should go to the input bufer of the topic handler
+// -> onMessage will be called by the transport when an MqttMessage is received. The subscriptions of all topic handlers 
+// are compiled in one matcher, one match of the topic gives the topic handlers that should get the message
+// -> by default an own reading worker calls the loop of the transport, optionally the threaded loop 
+//    of the transport (for mosquitto loop_start) is used
 
+// The transport is the mosquitto client by default, a LoopbackTransport runs without a broker
 
 
-class MqttManager : public mosqpp::mosquittopp {
+
+class MqttManager {
     public:
         MqttManager(std::string ip, const int port, const std::string &mqttId , std::vector<std::shared_ptr <TopicHandler>> topicHandlers);
-        ~MqttManager();
-        void on_message (const struct mosquitto_message *msg) override;
-        void on_connect(int rc) override;
-        void on_disconnect(int rc) override;        
+        MqttManager(std::shared_ptr<ITransport> transport, std::vector<std::shared_ptr <TopicHandler>> topicHandlers);
+        virtual ~MqttManager();
+        void onMessage(const MqttData & data);
         void stop();
         void start();
 
@@ -37,27 +45,40 @@ class MqttManager : public mosqpp::mosquittopp {
         void waitForDisconnection();
 
         void addTopicHandler(std::shared_ptr<TopicHandler> topicHandler);        
+        // use the network thread of the transport instead of an own reading worker, set before start
+        void setUseThreadedLoop(const bool useThreadedLoop);
+        // time the sending worker waits after a wake-up to gather more messages, set before start
+        void setFlushWindow(const std::chrono::milliseconds flushWindow);
+        // publishes left out because a later message on the same topic replaced them
+        std::uint64_t getNumberOfElidedPublishes() const {return _outbox.getElidedCount();}
+    protected:
+        virtual bool publishMessage(const MqttData & data);
     private:
+        void onConnectionChanged(const bool connected);
         void setConnected(const bool connected);
         void setReadingRunning(const bool running);
         void setSendingRunning(const bool running);
 
         void mqttReading();
         void mqttSending();
-
-        std::string getConnectionError(int rc );
+        void compileSubscriptions();
 
 
     private:
         mutable std::mutex m_connectedMutex;
         mutable std::mutex m_runningMutex;
 
+        std::shared_ptr<ITransport> _transport;
         std::vector<std::shared_ptr<TopicHandler>> _topicHandlers;
+        std::shared_ptr<BufferNotifier> _outputNotifier;
+        SubscriptionMatcher _subscriptions;    // subscriber = index in _topicHandlers
+        std::vector<std::size_t> _matchedHandlers; // only used by onMessage
+        Outbox _outbox; // only used by the sending worker
+        std::chrono::milliseconds _flushWindow {0};
         bool m_sendingRunning;
         bool m_readingRunning;
-
-        std::string m_ip;
-        int m_port;
+        bool m_useThreadedLoop;
+        bool m_threadedLoopStarted;
 
         std::thread m_sendingWorker;
         std::thread m_readingWorker;
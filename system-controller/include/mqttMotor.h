@@ -33,6 +33,7 @@ class MqttMotor: public MotorMotionManager, public IMqttMotor {
         void open() override ;    
         
         void setPosition(int position) override;        
+        void requestFastPolling() override;
         void onMotorInput(const MotorData & data) override;
         void onMotorConnected() override;
         void onMotorDisconnected() override;
@@ -48,6 +49,14 @@ class MqttMotor: public MotorMotionManager, public IMqttMotor {
         
         std::future<bool> clearCalibration() override ;
         void cancelAsyncTasks();
+
+        // polling cadence: fast while moving or recently commanded, slow when idle and closed
+        static const std::chrono::milliseconds ConfigurationInterval;
+        static const std::chrono::milliseconds MinPollInterval;
+        static const std::chrono::milliseconds ResponseTimeout;
+        static const std::chrono::milliseconds IdlePollInterval;
+        static const std::chrono::milliseconds ClosedPollInterval;
+        static const std::chrono::milliseconds FastPollHold;
  
         MotorStatusData getMotorStatusData() const override {return _currentMotorStatusData;}
     protected:
@@ -73,15 +82,18 @@ class MqttMotor: public MotorMotionManager, public IMqttMotor {
         
 
         // worker related members
-        std::condition_variable _cv;
-        bool _pollingActive = false;
-        std::thread _workerThread;
         std::mutex _mutex;
-
         std::promise<void> _cancelWorkerSignal;
 
-        // send related messages        
-        void polStatus();
+        // polling related members, the steps are driven by the shared PollScheduler
+        int _pollHandle = -1;
+        bool _isPolling = false;
+        bool _statusReceived = false;
+        std::chrono::steady_clock::time_point _lastPoll;
+        std::chrono::steady_clock::time_point _fastPollUntil;
+        std::chrono::milliseconds pollStep();
+        void requestConfiguration();
+        std::chrono::milliseconds getPollInterval(std::chrono::steady_clock::time_point now);
         
     
 };
@@ -0,0 +1,37 @@
+#ifndef OUTBOX_H
+#define OUTBOX_H
+
+#include "pch.h"
+#include <atomic>
+#include "mqttData.h"
+#include "subscriptionMatcher.h"
+
+// Messages gathered by the sending worker of the MqttManager between two flushes.
+// On a coalesced topic only the latest message of a flush is published: a motor gets
+// the speed or stop it should have now, not every one it had in between. A coalesced message takes
+// the place of its last occurrence, the order of the published messages is kept.
+// A message that repeats the message right before it is never published twice.
+// Only used from the sending worker, the elided counter can be read from any thread.
+class Outbox {
+    public:
+        Outbox();
+        // subscription syntax, so '+' and '#' can be used
+        void addCoalescedTopic(const std::string & subscription);
+        void add(const MqttData & data);
+        void flush(const std::function<void(const MqttData &)> & publish);
+        bool empty() const {return _pending.empty();}
+        // messages that were not published because a later one replaced them
+        std::uint64_t getElidedCount() const {return _elided.load(std::memory_order_relaxed);}
+
+        static const std::vector<std::string> & getDefaultCoalescedTopics();
+
+    private:
+        SubscriptionMatcher _coalesced;
+        std::vector<MqttData> _pending;
+        // (interned topic, index in _pending) of the coalesced messages, reused between flushes
+        std::vector<std::pair<const std::string *, std::size_t>> _coalescedIndices;
+        std::vector<bool> _isElided;
+        std::atomic<std::uint64_t> _elided {0};
+};
+
+#endif //OUTBOX_H
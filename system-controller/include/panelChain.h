@@ -0,0 +1,42 @@
+#ifndef PANELCHAIN_H
+#define PANELCHAIN_H
+
+#include "pch.h"
+#include "masterMotorizedWindow.h"
+
+/*
+ * The panels of one wing flattened into arrays, master first and every slave after its master.
+ * Compiled from the slave tree when the wing is complete and only again when a slave is added.
+ * Only the layout is stored here: positions, speeds and freedoms change on every motor update
+ * and stay in the windows.
+ */
+class PanelChain {
+    public:
+        PanelChain() = default;
+        explicit PanelChain(const std::shared_ptr<MasterMotorizedWindow> & master);
+
+        std::size_t size() const {return _windows.size();}
+        IMovingWindow * getWindow(std::size_t index) const {return _windows[index];}
+        // the master window is seen as a motor
+        SlaveType getType(std::size_t index) const {return _types[index];}
+        // index of the window this panel is a slave of, -1 for the master window
+        int getMasterIndex(std::size_t index) const {return _masterIndices[index];}
+        int getLength(std::size_t index) const {return _windows[index]->getLength();}
+        // the slave motors in chain order, the master window last
+        const std::vector<std::shared_ptr<MotorizedWindow>> & getMotors() const {return _motors;}
+        // the panel furthest from the master, following the first slave of each panel
+        IMovingWindow * getTail() const {return _windows.empty() ? nullptr : _windows[_tailIndex];}
+        unsigned int getStructureVersion() const {return _structureVersion;}
+
+    private:
+        void addSlaves(const IMovingWindow & window, int windowIndex);
+
+        std::vector<IMovingWindow *> _windows;
+        std::vector<SlaveType> _types;
+        std::vector<int> _masterIndices;
+        std::vector<std::shared_ptr<MotorizedWindow>> _motors;
+        std::size_t _tailIndex = 0;
+        unsigned int _structureVersion = 0;
+};
+
+#endif //PANELCHAIN_H
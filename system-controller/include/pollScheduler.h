@@ -0,0 +1,45 @@
+#ifndef POLLSCHEDULER_H
+#define POLLSCHEDULER_H
+
+#include "pch.h"
+#include "timerWheel.h"
+
+// Owns the polling cadence of all motors on one timer wheel instead of a
+// thread per motor. A client is a step function that does its polling work
+// and returns the delay until it wants to be stepped again.
+// The first step of the clients is staggered so they don't all poll in the same tick.
+class PollScheduler {
+    public:
+        typedef std::function<std::chrono::milliseconds(void)> PollStep;
+
+        explicit PollScheduler(TimerWheel & timerWheel);
+        ~PollScheduler();
+        static PollScheduler& getInstance();
+
+        // the first step is after the delay plus the stagger phase, returns the handle to remove the client
+        int add(PollStep pollStep, std::chrono::milliseconds firstStepDelay = std::chrono::milliseconds(0));
+        // when the client is being stepped this waits until the step is done,
+        // the step is never called afterwards (don't call from within the step itself)
+        void remove(int handle);
+        std::size_t getNumberOfClients() const;
+
+        static const std::chrono::milliseconds StaggerStep;
+        static const int StaggerPhases = 10;
+
+    private:
+        struct Client {
+            std::mutex mutex;
+            bool isActive = true;
+            PollStep pollStep;
+            TimerWheel::TimerId timerId = 0;
+        };
+        void scheduleStep(const std::shared_ptr<Client> & client, std::chrono::milliseconds delay);
+        void step(const std::shared_ptr<Client> & client);
+
+        TimerWheel & _timerWheel;
+        std::map<int, std::shared_ptr<Client>> _clients;
+        int _nextHandle = 0;
+        mutable std::mutex _mutex;
+};
+
+#endif // POLLSCHEDULER_H
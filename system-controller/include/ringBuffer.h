@@ -0,0 +1,114 @@
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+// Bounded lock-free queue (Dmitry Vyukov's sequence-per-cell design).
+// Safe for multiple producers and multiple consumers; in this project it is used as 
+// MPSC but the drop-oldest policy of the Buffer lets a producer pop as well.
+// The capacity is rounded up to a power of two.
+template<typename T>
+class RingBuffer
+{
+    public:
+        explicit RingBuffer(std::size_t capacity)
+            : _mask(roundUpToPowerOfTwo(capacity) - 1)
+            , _cells(new Cell[_mask + 1])
+            , _enqueuePos(0)
+            , _dequeuePos(0)
+        {
+            for (std::size_t i = 0; i <= _mask; ++i) {
+                _cells[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+        RingBuffer(const RingBuffer &) = delete;
+        RingBuffer & operator=(const RingBuffer &) = delete;
+
+        // returns false when full, value is only moved from on success
+        bool tryPush(T && value)
+        {
+            Cell * cell;
+            std::size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+            for (;;) {
+                cell = &_cells[pos & _mask];
+                const std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+                const std::intptr_t diff = (std::intptr_t)seq - (std::intptr_t)pos;
+                if (diff == 0) {
+                    if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (diff < 0) {
+                    return false;
+                } else {
+                    pos = _enqueuePos.load(std::memory_order_relaxed);
+                }
+            }
+            cell->data = std::move(value);
+            cell->sequence.store(pos + 1, std::memory_order_release);
+            return true;
+        }
+        // returns false when empty
+        bool tryPop(T & value)
+        {
+            Cell * cell;
+            std::size_t pos = _dequeuePos.load(std::memory_order_relaxed);
+            for (;;) {
+                cell = &_cells[pos & _mask];
+                const std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+                const std::intptr_t diff = (std::intptr_t)seq - (std::intptr_t)(pos + 1);
+                if (diff == 0) {
+                    if (_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                        break;
+                    }
+                } else if (diff < 0) {
+                    return false;
+                } else {
+                    pos = _dequeuePos.load(std::memory_order_relaxed);
+                }
+            }
+            value = std::move(cell->data);
+            cell->sequence.store(pos + _mask + 1, std::memory_order_release);
+            return true;
+        }
+        // only a snapshot when used concurrently
+        std::size_t size() const 
+        {
+            const std::size_t dequeuePos = _dequeuePos.load(std::memory_order_acquire);
+            const std::size_t enqueuePos = _enqueuePos.load(std::memory_order_acquire);
+            return enqueuePos > dequeuePos ? enqueuePos - dequeuePos : 0;
+        }
+        bool empty() const { return size() == 0;}
+        std::size_t capacity() const { return _mask + 1;}
+
+    private:
+        static const std::size_t CacheLineSize = 64;
+
+        struct Cell 
+        {
+            std::atomic<std::size_t> sequence;
+            T data;
+        };
+
+        static std::size_t roundUpToPowerOfTwo(std::size_t value)
+        {
+            std::size_t result = 2;
+            while (result < value) {
+                result <<= 1;
+            }
+            return result;
+        }
+
+        // padding keeps the producer and consumer index on their own cache line
+        char _pad0[CacheLineSize];
+        const std::size_t _mask;
+        const std::unique_ptr<Cell[]> _cells;
+        char _pad1[CacheLineSize];
+        std::atomic<std::size_t> _enqueuePos;
+        char _pad2[CacheLineSize - sizeof(std::atomic<std::size_t>)];
+        std::atomic<std::size_t> _dequeuePos;
+        char _pad3[CacheLineSize - sizeof(std::atomic<std::size_t>)];
+};
+
+#endif // RINGBUFFER_H
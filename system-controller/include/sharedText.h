@@ -0,0 +1,44 @@
+#ifndef SHAREDTEXT_H
+#define SHAREDTEXT_H
+
+#include "pch.h"
+#include <atomic>
+
+// Immutable, reference counted text used for the topic and payload of MqttData.
+// Copying a SharedText only touches a reference count, the text itself is never copied.
+// - copyOf: the text is stored in a pooled string; released strings keep their capacity
+//   and are reused, so after warm-up creating a message does not allocate
+// - intern: the text is stored once in a process wide table (topics are a small set);
+//   interned texts live forever and copying them does not even touch the reference count.
+//   When the table is full, intern falls back to copyOf
+class SharedText
+{
+    public:
+        SharedText() : _node(nullptr) {}
+        SharedText(const SharedText & other);
+        SharedText(SharedText && other);
+        SharedText & operator=(const SharedText & other);
+        SharedText & operator=(SharedText && other);
+        ~SharedText();
+
+        static SharedText copyOf(const char * data, std::size_t length);
+        static SharedText intern(const char * data, std::size_t length);
+
+        const std::string & str() const;
+        bool isInterned() const;
+
+        // limits of the pool and the intern table
+        static const std::size_t MaxPooledTexts = 4096;
+        static const std::size_t MaxPooledCapacity = 4096;
+        static const std::size_t MaxInternedTexts = 4096;
+    
+    public:
+        struct Node;
+    private:
+        explicit SharedText(Node * node) : _node(node) {}
+        void release();
+
+        Node * _node;
+};
+
+#endif //SHAREDTEXT_H
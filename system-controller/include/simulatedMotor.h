@@ -0,0 +1,93 @@
+#ifndef SIMULATEDMOTOR_H
+#define SIMULATEDMOTOR_H
+
+#include "pch.h"
+#include "motorMotionManager.h"
+
+// Time of a simulation, it only moves when the simulation advances it
+class VirtualClock {
+    public:
+        std::chrono::milliseconds now() const {return _now;}
+        void advance(std::chrono::milliseconds duration) {_now += duration;}
+    private:
+        std::chrono::milliseconds _now{0};
+};
+
+// In-process motor with a simple physics model, no broker involved.
+// The motor drives with the selected speed (min or max speed of the motor) towards
+// its target and stops at the ends of its stroke. It does nothing on its own: the owner
+// steps it on the virtual clock and the status is reported with the polling cadence of an MqttMotor.
+// After clearing the calibration the motor is calibrated again once it reached both ends.
+class SimulatedMotor : public MotorMotionManager {
+    public:
+        SimulatedMotor(const std::string & id, int stroke, const VirtualClock & clock, int minSpeed = DefaultMinSpeed, int maxSpeed = DefaultMaxSpeed);
+        void setHighSpeed() override;
+        void setLowSpeed() override;
+        int getLowSpeed() const override {return _lowSpeed;}
+
+        void stop() override;
+        void close() override;
+        void open() override;
+        void setPosition(int position) override;
+        void requestFastPolling() override;
+        int getStroke() const override {return isCalibrated() ? _stroke : -1;}
+        std::future<bool> clearCalibration() override;
+        MotorStatusData getMotorStatusData() const override {return _reportedStatusData;}
+        std::string getId() const override {return _id;}
+        bool isCalibrated() const override {return _isCalibrated;}
+        bool getIsConfigured() const override {return true;}
+
+        // moves the motor over the duration, returns true when the status was reported afterwards
+        bool step(std::chrono::milliseconds duration);
+        // reports the current state to the handlers, as an answered status poll
+        void reportStatus();
+        void jumpToPosition(int position);
+
+        int getActualPosition() const {return (int)std::lround(_position);}
+        bool isMoving() const {return _isMoving;}
+        // messages an MqttMotor would exchange with the broker (commands after deduplication, status polls)
+        uint64_t getNumberOfCommands() const {return _numberOfCommands;}
+        uint64_t getNumberOfStatusReports() const {return _numberOfStatusReports;}
+
+        static const int DefaultMinSpeed = 50;  // mm/s
+        static const int DefaultMaxSpeed = 150; // mm/s
+
+    private:
+        void moveTo(int target);
+        void limitSpeedIfNeeded();
+        struct SentParam {
+            int value = -1;
+            std::chrono::milliseconds time{0};
+        };
+        void countMovementCommand(MotorCommand command);
+        void countParamCommand(SentParam & sentParam, int value);
+        MotorStatusData getActualStatusData() const;
+
+        std::string _id;
+        int _stroke;
+        const VirtualClock & _clock;
+        int _lowSpeed;
+        int _highSpeed;
+        int _currentSpeed;
+
+        double _position = 0;
+        int _target = 0;
+        bool _isMoving = false;
+        bool _isCalibrated = true;
+        bool _reachedOpenEnd = false;
+        bool _reachedClosedEnd = false;
+        bool _isMotorStopped = true;
+        MotorStatusData _reportedStatusData;
+
+        std::chrono::milliseconds _nextStatusReport{0};
+        std::chrono::milliseconds _fastPollUntil{0};
+        // the commands manager drops a movement repeated within 500ms and an unchanged parameter within 1s
+        MotorCommand _lastMovementCommand = MotorCommand::Unknown;
+        std::chrono::milliseconds _lastMovementTime{0};
+        SentParam _sentSpeed;
+        SentParam _sentPosition;
+        uint64_t _numberOfCommands = 0;
+        uint64_t _numberOfStatusReports = 0;
+};
+
+#endif // SIMULATEDMOTOR_H
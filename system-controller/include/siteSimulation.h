@@ -0,0 +1,56 @@
+#ifndef SITESIMULATION_H
+#define SITESIMULATION_H
+
+#include "pch.h"
+#include "simulatedMotor.h"
+#include "wing.h"
+
+// Runs a full configuration against simulated motors on a virtual clock.
+// Everything runs on the calling thread so the same scenario always gives the same
+// decisions, and a run takes a fraction of the time it would take with real motors.
+class SiteSimulation {
+    public:
+        struct Counters {
+            uint64_t statusReports = 0;   // status polls answered by the motors
+            uint64_t wingEvaluations = 0; // periodic updateWingMovement calls (as done by the WingsHandler)
+            uint64_t motorCommands = 0;   // commands that would be published to the motors
+            uint64_t wingMessages = 0;    // messages published by the wings
+            uint64_t getDecisions() const {return statusReports + wingEvaluations;}
+            uint64_t getMessages() const {return 2 * statusReports + motorCommands + wingMessages;}
+        };
+        // called with the wall time spent on one status report or wing evaluation
+        typedef std::function<void(std::chrono::nanoseconds)> UpdateObserver;
+
+        // motors get the length of their element as stroke, they start closed and calibrated
+        explicit SiteSimulation(const std::string & jsonConfig);
+
+        void run(std::chrono::milliseconds duration);
+        // runs until the condition holds or the timeout passed, returns the condition
+        bool runUntil(std::function<bool(void)> condition, std::chrono::milliseconds timeout);
+        bool areAllWingsOpen() const;
+        bool areAllWingsClosed() const;
+        bool areAllMotorsStopped() const;
+
+        const std::vector<std::shared_ptr<IWing>> & getWings() const {return _wings;}
+        const std::vector<std::shared_ptr<SimulatedMotor>> & getMotors() const {return _motors;}
+        const VirtualClock & getClock() const {return _clock;}
+        Counters getCounters() const;
+        void setUpdateObserver(UpdateObserver observer) {_updateObserver = observer;}
+
+        static const std::chrono::milliseconds PhysicsStep;
+        static const std::chrono::milliseconds EvaluationInterval;
+
+    private:
+        void step();
+        bool areAllWingsIn(MotorStatus status) const;
+
+        VirtualClock _clock;
+        std::vector<std::shared_ptr<IWing>> _wings;
+        std::vector<std::shared_ptr<SimulatedMotor>> _motors;
+        std::chrono::milliseconds _nextEvaluation{0};
+        uint64_t _wingEvaluations = 0;
+        uint64_t _wingMessages = 0;
+        UpdateObserver _updateObserver;
+};
+
+#endif // SITESIMULATION_H
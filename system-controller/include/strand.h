@@ -0,0 +1,58 @@
+#ifndef STRAND_H
+#define STRAND_H
+
+#include "pch.h"
+#include <deque>
+
+// Fixed number of worker threads running posted tasks in any order
+class ThreadPool {
+    public:
+        explicit ThreadPool(std::size_t numberOfThreads = getDefaultNumberOfThreads());
+        ~ThreadPool();
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        void post(std::function<void()> task);
+        std::size_t getNumberOfThreads() const {return _threads.size();}
+        static std::size_t getDefaultNumberOfThreads();
+
+    private:
+        void run();
+
+        std::mutex _mutex;
+        std::condition_variable _cv;
+        std::deque<std::function<void()>> _tasks;
+        bool _isRunning = true;
+        std::vector<std::thread> _threads;
+};
+
+// Serial executor on a ThreadPool: the tasks of one strand run in the order they are posted
+// and never at the same time, tasks of different strands run in parallel.
+// All state that is only touched from within one strand needs no locking.
+// The owner of the strands keeps the pool alive, a strand only refers to it.
+class Strand : public std::enable_shared_from_this<Strand> {
+    public:
+        explicit Strand(const std::shared_ptr<ThreadPool> & pool);
+
+        void post(std::function<void()> task);
+        // runs the task immediately when already called from within this strand
+        void dispatch(std::function<void()> task);
+        bool isRunningInThisThread() const;
+        // blocks until all tasks posted before are done, don't call from within the strand
+        void waitUntilIdle();
+
+        // tasks run in one go before the pool thread is handed to another strand
+        static const std::size_t MaxTasksPerTurn = 64;
+
+    private:
+        void schedule();
+        void runTasks();
+
+        std::weak_ptr<ThreadPool> _pool;
+        std::mutex _mutex;
+        std::condition_variable _idle;
+        std::deque<std::function<void()>> _tasks;
+        bool _isScheduled = false; // a turn of this strand is posted or running on the pool
+};
+
+#endif // STRAND_H
@@ -0,0 +1,37 @@
+#ifndef SUBSCRIPTIONMATCHER_H
+#define SUBSCRIPTIONMATCHER_H
+
+#include "pch.h"
+#include "topicTokenizer.h"
+
+// MQTT subscriptions compiled into one trie of topic levels.
+// Matching a topic is one walk over its levels and returns every subscriber with 
+// a matching subscription, following the MQTT rules:
+// - '+' matches exactly one level (which can be empty)
+// - '#' as last level matches the parent level and everything below it
+// - topics starting with '$' are not matched by a wildcard on the first level
+class SubscriptionMatcher
+{
+    public:
+        SubscriptionMatcher();
+        void add(const std::string & subscription, std::size_t subscriber);
+        void clear();
+        // appends the matching subscribers to 'subscribers' (each subscriber once)
+        void match(const StringSpan & topic, std::vector<std::size_t> & subscribers) const;
+        bool matches(const StringSpan & topic) const;
+
+    private:
+        struct Node {
+            std::vector<std::pair<std::string, std::uint32_t>> children;
+            std::int32_t plusChild = -1;
+            std::vector<std::size_t> subscribers;       // subscription ends on this level
+            std::vector<std::size_t> hashSubscribers;   // subscription ends with '#' after this level
+        };
+        void matchLevel(std::uint32_t node, const StringSpan & topic, std::size_t levelBegin, std::vector<std::size_t> & subscribers) const;
+        bool matchesLevel(std::uint32_t node, const StringSpan & topic, std::size_t levelBegin) const;
+        static void addUnique(const std::vector<std::size_t> & from, std::vector<std::size_t> & to);
+
+        std::vector<Node> _nodes;
+};
+
+#endif //SUBSCRIPTIONMATCHER_H
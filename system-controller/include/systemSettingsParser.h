@@ -23,25 +23,28 @@ static void parseJsonToSettings(std::string & json) {
     }
     try {
         rapidjson::Value& systemSettingsVal = doc["systemsettings"];
+        // all settings of the file are published at once, an evaluation never sees half of them
+        SystemSettingsSnapshot settings = *SystemSettings::getSnapshot();
 
         if ( systemSettingsVal.HasMember("chicanoverlap") && systemSettingsVal["chicanoverlap"].IsInt()) {
-            SystemSettings::getInstance().setChicanOverlap(systemSettingsVal["chicanoverlap"].GetInt());
+            settings.chicanOverlap = systemSettingsVal["chicanoverlap"].GetInt();
         }
         if ( systemSettingsVal.HasMember("chicanzone") && systemSettingsVal["chicanzone"].IsInt()) {
-            SystemSettings::getInstance().setChicanZone(systemSettingsVal["chicanzone"].GetInt());
+            settings.chicanZone = systemSettingsVal["chicanzone"].GetInt();
         }
         if ( systemSettingsVal.HasMember("slowdowndist") && systemSettingsVal["slowdowndist"].IsInt()) {
-            SystemSettings::getInstance().setSlowdownDist(systemSettingsVal["slowdowndist"].GetInt());
+            settings.slowdownDist = systemSettingsVal["slowdowndist"].GetInt();
         }
         if ( systemSettingsVal.HasMember("cornerzone") && systemSettingsVal["cornerzone"].IsInt()) {
-            SystemSettings::getInstance().setCornerZone(systemSettingsVal["cornerzone"].GetInt());
+            settings.cornerZone = systemSettingsVal["cornerzone"].GetInt();
         }
         if ( systemSettingsVal.HasMember("oppositezone") && systemSettingsVal["oppositezone"].IsInt()) {
-            SystemSettings::getInstance().setOppositeZone(systemSettingsVal["oppositezone"].GetInt());
+            settings.oppositeZone = systemSettingsVal["oppositezone"].GetInt();
         }
         if ( systemSettingsVal.HasMember("triggerpushwingdistance") && systemSettingsVal["triggerpushwingdistance"].IsInt()) {
-            SystemSettings::getInstance().setTriggerPushWingDistance(systemSettingsVal["triggerpushwingdistance"].GetInt());        
+            settings.triggerPushWingDistance = systemSettingsVal["triggerpushwingdistance"].GetInt();
         }
+        SystemSettings::getInstance().setSettings(settings);
 
    
     }catch(...) {
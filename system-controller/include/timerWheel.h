@@ -0,0 +1,52 @@
+#ifndef TIMERWHEEL_H
+#define TIMERWHEEL_H
+
+#include "pch.h"
+#include <unordered_set>
+
+// Hashed timer wheel: a single thread drives all timers with a fixed tick.
+// Timers that expire in the same tick are fired together, callbacks run on
+// the wheel thread and should be short (no sleeping, no waiting on replies).
+class TimerWheel {
+    public:
+        typedef uint64_t TimerId; // 0 is never a valid id
+
+        explicit TimerWheel(std::chrono::milliseconds tick = std::chrono::milliseconds(5), std::size_t numberOfSlots = 512);
+        ~TimerWheel();
+        TimerWheel(const TimerWheel&) = delete;
+        TimerWheel& operator=(const TimerWheel&) = delete;
+
+        // wheel shared by the whole process (motor polling, command retries)
+        static TimerWheel& getInstance();
+
+        // the callback runs once, after at least the delay (rounded up to the next tick)
+        TimerId schedule(std::chrono::milliseconds delay, std::function<void()> callback);
+        // returns true when the timer was still pending, the callback will not run anymore
+        bool cancel(TimerId id);
+
+        std::chrono::milliseconds getTick() const {return _tick;}
+        std::size_t getNumberOfPendingTimers() const;
+
+    private:
+        struct Timer {
+            TimerId id;
+            uint64_t dueTick;
+            std::function<void()> callback;
+        };
+        void run();
+        void collectExpired(uint64_t tick, std::vector<Timer> & expired);
+
+        const std::chrono::milliseconds _tick;
+        std::vector<std::vector<Timer>> _slots;
+        std::unordered_set<TimerId> _pendingIds;
+        TimerId _nextId = 1;
+        uint64_t _currentTick = 0;
+        std::chrono::steady_clock::time_point _start;
+
+        mutable std::mutex _mutex;
+        std::condition_variable _cv;
+        bool _isRunning = true;
+        std::thread _workerThread;
+};
+
+#endif // TIMERWHEEL_H
@@ -3,32 +3,51 @@
 
 #include "pch.h"
 #include "buffer.h"
+#include "ringBuffer.h"
 #include "mqttData.h"
+#include "subscriptionMatcher.h"
 
+// the in- and outputbuffers of the topicHandlers are lock-free and bounded
+typedef Buffer<MqttData, RingBuffer<MqttData>> MqttBuffer;
+
+// The input is handled by one or more shards, each with its own inputbuffer and worker.
+// All messages with the same shard key (by default the topic) are handled by the same shard in order.
 class TopicHandler {
     public:    
         virtual ~TopicHandler();
-        TopicHandler(std::vector<std::string> subscribeStrs);
+        TopicHandler(std::vector<std::string> subscribeStrs, std::size_t numberOfShards = 1);
         TopicHandler(TopicHandler &&) = default; // move constructor
         virtual void start();
         virtual void stop();
         bool isRunning() const;
-        const std::shared_ptr<Buffer<MqttData>> getInputBuffer();
-        const std::shared_ptr<Buffer<MqttData>> getOutputBuffer();
+        // routes the input to the inputbuffer of its shard
+        void queueInput(const MqttData & data);
+        // inputbuffer of the first shard, the only one when not sharded
+        const std::shared_ptr<MqttBuffer> getInputBuffer();
+        std::size_t getNumberOfShards() const {return _pInTypeBuffers.size();}
+        const std::shared_ptr<MqttBuffer> getOutputBuffer();
         std::vector<std::string> getSubscribeStrs();
         bool isTopicValidForHandling(const std::string & topic);
         virtual std::string getType() const {return "TOPIC";}
+        // a full inputbuffer drops the oldest (stale) input, a full outputbuffer blocks the handler
+        static const std::size_t InputBufferCapacity = 1024;
+        static const std::size_t OutputBufferCapacity = 1024;
     protected:
         TopicHandler();
         virtual void handleNewInput ( const MqttData & inputData) ;
-        void run();
+        // messages with the same key are handled in order by the same shard
+        virtual std::size_t getShardKey(const MqttData & data) const;
+        // hash of the first levels of the topic, without copying the topic
+        static std::size_t hashTopicLevels(const std::string & topic, std::size_t numberOfLevels);
+        void run(std::size_t shard);
     protected:
         bool _running;
         std::vector<std::string> _subscribeStrs;        
-        std::thread _workerThread;
+        SubscriptionMatcher _subscriptionMatcher;
+        std::vector<std::thread> _workerThreads;
 
-        std::shared_ptr<Buffer<MqttData>> _pInTypeBuffer;
-        std::shared_ptr<Buffer<MqttData>> _pOutTypeBuffer;
+        std::vector<std::shared_ptr<MqttBuffer>> _pInTypeBuffers;
+        std::shared_ptr<MqttBuffer> _pOutTypeBuffer;
 };
 
 #endif //TOPICHANDLER_H
@@ -0,0 +1,82 @@
+#ifndef TOPICTOKENIZER_H
+#define TOPICTOKENIZER_H
+
+#include "pch.h"
+#include <cstring>
+
+// Non-owning view on a part of a string (the project is C++11, no std::string_view).
+// The viewed string should outlive the span.
+class StringSpan
+{
+    public:
+        StringSpan() : _data(""), _size(0) {}
+        StringSpan(const char * data, std::size_t size) : _data(data), _size(size) {}
+        StringSpan(const std::string & str) : _data(str.data()), _size(str.size()) {}
+
+        const char * data() const { return _data;}
+        std::size_t size() const { return _size;}
+        bool empty() const { return _size == 0;}
+        char operator[](std::size_t i) const { return _data[i];}
+        const char * begin() const { return _data;}
+        const char * end() const { return _data + _size;}
+
+        bool equals(const char * str, std::size_t size) const {
+            return _size == size && std::memcmp(_data, str, size) == 0;
+        }
+        bool operator==(const StringSpan & other) const { return equals(other._data, other._size);}
+        bool operator!=(const StringSpan & other) const { return !(*this == other);}
+        bool equalsIgnoreCase(const StringSpan & other) const {
+            if (_size != other._size) { return false;}
+            for (std::size_t i = 0; i < _size; ++i) {
+                if (std::tolower((unsigned char)_data[i]) != std::tolower((unsigned char)other._data[i])) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        bool isDigits() const {
+            for (std::size_t i = 0; i < _size; ++i) {
+                if (_data[i] < '0' || _data[i] > '9') { return false;}
+            }
+            return true;
+        }
+        std::size_t find(const char * str) const {
+            const std::size_t length = std::strlen(str);
+            for (std::size_t i = 0; i + length <= _size; ++i) {
+                if (std::memcmp(_data + i, str, length) == 0) { return i;}
+            }
+            return std::string::npos;
+        }
+        std::string str() const { return std::string(_data, _size);}
+
+    private:
+        const char * _data;
+        std::size_t _size;
+};
+
+// Splits an MQTT topic on '/' without allocating
+class TopicTokenizer
+{
+    public:
+        // fills parts with the last 'count' levels of the topic (in topic order)
+        // returns false when the topic has less levels or when one of the levels is empty
+        // the levels should also be preceded by a '/' (like the anchored topic regexes did)
+        static bool lastLevels(const StringSpan & topic, StringSpan * parts, const std::size_t count)
+        {
+            std::size_t end = topic.size();
+            for (std::size_t i = count; i > 0; --i) {
+                std::size_t begin = end;
+                while (begin > 0 && topic[begin - 1] != '/') {
+                    --begin;
+                }
+                if (begin == 0 || begin == end) {
+                    return false;
+                }
+                parts[i - 1] = StringSpan(topic.data() + begin, end - begin);
+                end = begin - 1;
+            }
+            return true;
+        }
+};
+
+#endif //TOPICTOKENIZER_H
@@ -0,0 +1,31 @@
+#ifndef TRANSPORT_H
+#define TRANSPORT_H
+
+#include "pch.h"
+#include "mqttData.h"
+
+// The connection of the MqttManager to the message bus (a broker or an in-process bus).
+// The handlers are set before connecting, received messages are given to the message handler
+// from loop() or, after startThreadedLoop(), from a thread of the transport itself.
+class ITransport {
+    public:
+        typedef std::function<void(const MqttData &)> MessageHandler;
+        typedef std::function<void(bool isConnected)> ConnectionHandler;
+
+        virtual ~ITransport() {}
+        virtual void setMessageHandler(MessageHandler messageHandler) = 0;
+        virtual void setConnectionHandler(ConnectionHandler connectionHandler) = 0;
+
+        // returns false when the connection could not be started
+        virtual bool connect() = 0;
+        virtual void disconnect() = 0;
+        virtual bool subscribe(const std::string & subscription) = 0;
+        virtual bool publish(const MqttData & data) = 0;
+        // handles the pending traffic (waits a short while when there is none),
+        // returns false when there is no connection
+        virtual bool loop() = 0;
+        virtual bool startThreadedLoop() = 0;
+        virtual void stopThreadedLoop() = 0;
+};
+
+#endif //TRANSPORT_H
@@ -8,6 +8,7 @@
 #include "canCalibrate.h"
 #include "wingStatus.h"
 #include "masterMotorizedWindow.h"
+#include "panelChain.h"
 #include "windowPushZone.h"
 #include "wingRelationManager.h"
 #include "wingStatusPublisher.h"
@@ -24,9 +25,11 @@ class IWing : public  IPositionTrack ,  public ICanCalibrate {
         virtual void setPositionMm(int positionMm)=0;
         virtual void setPositionPerc(double positionPerc)=0;        
         const virtual std::string getWingId() const=0;
+        // a wing rebuilt by a configuration reload keeps the id of the wing it replaces
+        virtual void setWingId(const std::string & wingId)=0;
         virtual void addSibling(std::shared_ptr<IWing> sibling, WingSiblingType siblingType)=0;        
         virtual std::shared_ptr<MasterMotorizedWindow> getMasterWindow() const =0;
-        const virtual std::vector<std::shared_ptr<MotorizedWindow>> getMotors() const =0;        
+        virtual const std::vector<std::shared_ptr<MotorizedWindow>> & getMotors() const =0;        
         const virtual std::shared_ptr<IWindowPushZone> getCornerPushZone() const =0;
         const virtual std::shared_ptr<IWindowPushZone> getOppositePushZone() const =0;
         const virtual std::shared_ptr<std::vector<std::tuple<std::shared_ptr<IWing>,WingSiblingType>>> getSiblings() const =0; 
@@ -46,6 +49,7 @@ class Wing : public IWing , public std::enable_shared_from_this<Wing>{
             std::shared_ptr<IWingStatusPublisher> wingStatusPublisher, 
             //const std::string & wingName,
             bool hasOpeningLeft =true);
+        ~Wing();
         void open() override;
         void close() override;
         void stop() override;        
@@ -64,9 +68,11 @@ class Wing : public IWing , public std::enable_shared_from_this<Wing>{
         bool hasCalibratedMotors() override;
         bool isCalibrated() override {return _isFullSetupCalibDone || hasCalibratedMotors();}
         const std::string getWingId() const override {return _wingName;}
+        void setWingId(const std::string & wingId) override {_wingName = wingId;}
         void addSibling(std::shared_ptr<IWing> sibling, WingSiblingType siblingType) override;
         std::shared_ptr<MasterMotorizedWindow> getMasterWindow() const override;
-        const std::vector<std::shared_ptr<MotorizedWindow>> getMotors() const override;
+        const std::vector<std::shared_ptr<MotorizedWindow>> & getMotors() const override {return getPanelChain().getMotors();}
+        const PanelChain & getPanelChain() const;
         const std::shared_ptr<IWindowPushZone> getCornerPushZone() const override {return _currentWingStatus->getCornerPushZone();}
         const std::shared_ptr<IWindowPushZone> getOppositePushZone() const override {return _currentWingStatus->getOppositePushZone();}
         const std::shared_ptr<std::vector<std::tuple<std::shared_ptr<IWing>,WingSiblingType>>> getSiblings() const override {return _siblings;}
@@ -104,6 +110,10 @@ class Wing : public IWing , public std::enable_shared_from_this<Wing>{
 
         void validateRelation(std::tuple<std::shared_ptr<IWing>,WingSiblingType> & wingInfo, int position);
         std::string _wingName;
+        int _positionHandlerId;
+        int _statusHandlerId;
+        mutable std::mutex _panelChainMutex;
+        mutable PanelChain _panelChain;
 
         
         std::promise<void> _cancelCalibrationWorkerSignal;
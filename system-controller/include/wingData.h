@@ -5,6 +5,7 @@
 
 
 #include "mqttData.h"
+#include "topicTokenizer.h"
 
 enum class WingComandType {
     Stop,
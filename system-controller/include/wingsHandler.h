@@ -4,26 +4,64 @@
 #include "pch.h"
 #include "topicHandler.h"
 #include "wing.h"
+#include "strand.h"
 #include "wingInputTranslator.h"
 
 
 
 
+// Wings are only evaluated (updateWingMovement) when something changed for them:
+// the status of their own motor, the position of a sibling or a new target.
+// The evaluation worker sleeps until a wing is marked, a slow sweep over all wings is the safety net.
+// Once started every group of connected wings (siblings) runs on its own strand: commands, evaluations
+// and the callbacks of their motors are serialized per group, different groups run in parallel on the pool.
 class WingsHandler : public TopicHandler {
     public:
-        WingsHandler(const std::string & configId , std::shared_ptr<IWingInputTranslator> inputTranslator);
+        WingsHandler(const std::string & configId , std::shared_ptr<IWingInputTranslator> inputTranslator,
+                    std::shared_ptr<ThreadPool> threadPool = nullptr);
+        ~WingsHandler();
         void handleNewInput ( const MqttData & inputData) override;
         std::string addWing(const std::shared_ptr<IWing>& wing);
+        // swaps all wings at once (configuration reload), the input and the evaluations keep running.
+        // The old wings are released when the work already posted for them is done.
+        void replaceWings(const std::vector<std::shared_ptr<IWing>> & wings);
+        // marks the wing to be evaluated by the evaluation worker, can be called from any thread
+        void requestEvaluation(const std::string & wingId);
         void start();
         void stop();
         std::string getType() const override {return "WING";};        
+
+        static const std::chrono::milliseconds SweepInterval;
     private :
+        // shared with the handlers registered on the motors, they can outlive the wingsHandler
+        struct DirtyWings {
+            std::mutex mutex;
+            std::condition_variable cv;
+            std::set<std::string> wingIds;
+            bool isRunning = false;
+            void mark(const std::string & wingId);
+        };
         std::map<std::string,std::shared_ptr<IWing>> _wings;
         std::string _configId;
         std::mutex _wingsMap_mutex;
-        bool _isUpdateWingMovementRunning = false;
+        std::shared_ptr<DirtyWings> _dirtyWings;
         std::thread _workerThreadWingMovement;
-        void evaluateAllWings();
+        std::shared_ptr<ThreadPool> _threadPool;
+        std::map<std::string,std::shared_ptr<Strand>> _strands; // by wingId, only filled while started
+        // the handlers registered on the motor of a wing, removed when the wing is replaced
+        struct MotorHandlers {
+            std::shared_ptr<IMotorMotionManager> motionManager;
+            int statusHandlerId;
+            int positionHandlerId;
+        };
+        std::vector<MotorHandlers> _motorHandlers;
+        void addWingLocked(const std::shared_ptr<IWing>& wing);
+        void assignStrands();
+        void assignStrandsLocked();
+        void releaseStrands();
+        // runs the work on the strand of the wing or directly when not started, call with the wingsMap locked
+        void runForWing(const std::string & wingId, std::function<void()> work);
+        void evaluateDirtyWings();
         void handleOutput(const MqttData & data);
         std::shared_ptr<IWingInputTranslator> _inputTranslator;
 };
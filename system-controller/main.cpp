@@ -7,18 +7,25 @@
 #include "wingsHandler.h"
 #include "motorsHandler.h"
 #include "configBuilder.h"
+#include "configurationHost.h"
 #include "wingInputTranslator.h"
-#include "systemSettingsParser.h"
 
 
 using namespace std;
 
 
 // Run this program with at least one command option -c containing the path of the configuration file
+// or -d containing a directory of configuration files that are all hosted by this process
 // Ex: ./systemController  -c ../../mqtt-simulated-motor/monitor/output/simulatedConfig.json -p 1883 -s
+// Add -t to let the network loop of mosquitto handle the reading instead of an own worker
+// Add -m <n> to handle the motor input with n workers (large installations)
+// Add -v <level> to log from that level on (trace, debug, info, warning, error, critical), default trace
+// A configuration is reloaded without a restart by publishing on systemcontroller/<id>/config/reload
+// (an empty payload reloads its file)
+// The log levels are changed while running by publishing on systemcontroller/<id>/diag/loglevel
 
-void enableLogging(std::string logFolder) {
-    Log::Init(logFolder);
+void enableLogging(std::string logFolder, std::string logLevel) {
+    Log::Init(logFolder, spdlog::level::from_str(logLevel));
     
     LOG_INFO("System controller started... logs saved @" + logFolder);    
     LOG_CRITICAL("[LOG CHECK]--- critical logging is on");
@@ -33,7 +40,7 @@ int main (int argc , char **argv) {
     
     CommandLineParser cmdParser("logs");
     bool validCmds = cmdParser.tryParse(argc,argv);
-    enableLogging(cmdParser.getLogPath());
+    enableLogging(cmdParser.getLogPath(), cmdParser.getLogLevel());
             
     if (!validCmds) {
         LOG_ERROR("Nothing started: Failed to parse command line parameters");
@@ -41,15 +48,14 @@ int main (int argc , char **argv) {
         return -1;
     }
         
-    ifstream f(cmdParser.getConfigFilePath());
-    ostringstream ss;
-    ss << f.rdbuf(); // reading data
-    
-    std::string json = ss.str();
-    SystemSettingsParser::parseJsonToSettings(json);
-    std::string configurationId;
+    std::vector<std::string> configFiles;
+    if (cmdParser.getConfigDirectory().empty()) {
+        configFiles.push_back(cmdParser.getConfigFilePath());
+    } else {
+        configFiles = ConfigurationHost::listConfigFiles(cmdParser.getConfigDirectory());
+    }
 
-    auto writeWingCommandsToFiles = [&](std::string guid, int counter ) {
+    auto writeWingCommandsToFiles = [&](const std::string & configurationId, std::string guid, int counter ) {
         auto writeToFile = [&](std::string command ) {
             std::ofstream out( command+ "-"+std::to_string(counter)+ ".sh");
             out << "mosquitto_pub -t \"systemcontroller/"+ configurationId +"/wing/" +guid+ "/"+ command + "\" -m \"\"" +  " -p " + std::to_string(cmdParser.getPort());
@@ -58,40 +64,39 @@ int main (int argc , char **argv) {
         writeToFile("stop"); writeToFile("open");writeToFile("close");writeToFile("calibrate");
     };
 
-
-    
-
-    std::vector<std::shared_ptr<IWing>> wings;
-    //get wings;    
-    ConfigBuilder::parseFromJson(json,wings,configurationId);
-    LOG_INFO("parsed " + std::to_string(wings.size()) + " wings from JSON configuration '" +cmdParser.getConfigFilePath()+"'" );
-    Log::GetLogger()->flush();
-    
-
-    auto wingsHandler = make_shared<WingsHandler>(configurationId, std::make_shared<WingInputTranslator>());    
-    auto motorsHandler = make_shared<MotorsHandler>();     
-    std::vector<std::shared_ptr<TopicHandler>> topicHandlers;
+    // all configurations share the motors handler, the wing thread pool and the MQTT connection
+    ConfigurationHost host(cmdParser.getNumberOfMotorShards());
     int wingCounter=0;
-
-    for(auto &  wing : wings) {
-        wingCounter++;
-        
-        std::string wingGuid = wingsHandler->addWing(wing);
-        LOG_DEBUG("Added wing " + std::to_string(wingCounter) + " with guid " + wingGuid + " to wing handler");   
-        if ( cmdParser.generateScriptsOn()) {
-            writeWingCommandsToFiles(wingGuid,wingCounter);
+    for (auto & configFile : configFiles) {
+        std::string configurationId;
+        try {
+            configurationId = host.addConfigurationFile(configFile);
+        } catch (const std::exception * e) {
+            LOG_ERROR("Skipped configuration '" + configFile + "': " + e->what());
+            delete e;
+            continue;
         }
-        LOG_DEBUG("Number of motors on the wing:" + std::to_string(wing->getMotors().size()));
-        for ( auto & m : wing->getMotors())  {
-            LOG_INFO("Adding motor " + m->getMotionManager()->getId());
-            motorsHandler->addMotor(std::dynamic_pointer_cast<IMqttMotor>(m->getMotionManager()));
+        const auto wings = host.getWings(configurationId);
+        LOG_INFO("parsed " + std::to_string(wings.size()) + " wings from JSON configuration '" + configFile + "'" );
+        for(auto &  wing : wings) {
+            wingCounter++;
+            LOG_DEBUG("Added wing " + std::to_string(wingCounter) + " with guid " + wing->getWingId() + " to wing handler of " + configurationId);   
+            if ( cmdParser.generateScriptsOn()) {
+                writeWingCommandsToFiles(configurationId, wing->getWingId(), wingCounter);
+            }
+            LOG_DEBUG("Number of motors on the wing:" + std::to_string(wing->getMotors().size()));
         }
+        Log::GetLogger()->flush();
+    }
+    if (host.getConfigurationIds().empty()) {
+        LOG_ERROR("Nothing started: no valid configuration found");
+        return -1;
     }
-  
-    topicHandlers.push_back(motorsHandler);
-    topicHandlers.push_back(wingsHandler);
+    std::vector<std::shared_ptr<TopicHandler>> topicHandlers = host.getTopicHandlers();
 
     MqttManager mqtt("localhost",cmdParser.getPort(),"systemcontroller",topicHandlers);
+    mqtt.setUseThreadedLoop(cmdParser.useThreadedMqttLoop());
+    mqtt.setFlushWindow(std::chrono::milliseconds(10)); // the commands of one evaluation go out as one flush
     const bool connected = mqtt.waitForConnection(std::chrono::milliseconds(500));
     if (connected == false) {
         LOG_WARNING("Did not connect to Mqtt broker at port " +  std::to_string(cmdParser.getPort()));
@@ -1,11 +1,16 @@
 #include "commandLineParser.h"
 #include "log.h"
+#include <sys/stat.h>
 
 bool CommandLineParser::tryParse(int argc, char **argv) {
     bool isGenerateScriptsOn= false;
+    bool isThreadedMqttLoopOn = false;
     char *configValue = NULL;
+    char *configDirectoryValue = NULL;
     char *logValue = NULL;
+    char *logLevelValue = NULL;
     char *portValue = NULL;  
+    char *motorShardsValue = NULL;
     int cmdLineArgument;
 
      std::cout << "You have entered " << argc 
@@ -15,21 +20,33 @@ bool CommandLineParser::tryParse(int argc, char **argv) {
         std::cout << argv[i] << "\n"; 
     
     char* errorMsg;
-    while ((cmdLineArgument = getopt (argc, argv, "sl:c:p:")) != -1){
+    while ((cmdLineArgument = getopt (argc, argv, "stl:v:c:d:p:m:")) != -1){
         switch (cmdLineArgument)
         {
         case 's':
             isGenerateScriptsOn = true;
             break;
+        case 't':
+            isThreadedMqttLoopOn = true;
+            break;
         case 'c':
             configValue = optarg;
             break;
+        case 'd':
+            configDirectoryValue = optarg;
+            break;
         case 'l':
             logValue = optarg;
             break;
+        case 'v':
+            logLevelValue = optarg;
+            break;
         case 'p':
             portValue = optarg;
             break;
+        case 'm':
+            motorShardsValue = optarg;
+            break;
         case ':':
             sprintf(errorMsg, "Missing ??? %c", optopt);
             if ( errorMessage.gcount() >1) { errorMessage << "\n";}
@@ -37,7 +54,7 @@ bool CommandLineParser::tryParse(int argc, char **argv) {
             break;
 
         case '?':
-            if (optopt == 'c' || optopt == 'p')
+            if (optopt == 'c' || optopt == 'd' || optopt == 'p' || optopt == 'm' || optopt == 'v')
                 sprintf (errorMsg,"Option -%c requires an argument.", optopt );
             else if (isprint (optopt))
                 sprintf (errorMsg, "Unknown option `-%c'.", optopt);
@@ -58,29 +75,58 @@ bool CommandLineParser::tryParse(int argc, char **argv) {
         _port = atoi(portValue);
         if (_port == 0) return false;
     } 
-    // check if file exists
-    if (configValue == NULL || access( configValue, F_OK ) == -1 )
-    {
-        if ( errorMessage.gcount() >1) { errorMessage << "\n";}
-        errorMessage << "No valid config file is given";
-        return false;
-    } 
-    // check if file is a JSON file
-    _filePathOfConfig = std::string(configValue);
-    if(_filePathOfConfig.substr(_filePathOfConfig.find_last_of(".") + 1) != "json" && _filePathOfConfig.substr(_filePathOfConfig.find_last_of(".") + 1) != "JSON"  ) {
-        if ( errorMessage.gcount() >1) { errorMessage << "\n";}
-        errorMessage<< "The configuration file '" << _filePathOfConfig << "' is not a JSON file.";
-        return false;
+    // number of workers handling the motor input
+    if(motorShardsValue != NULL ) {
+        const int motorShards = atoi(motorShardsValue);
+        if (motorShards < 1) return false;
+        _numberOfMotorShards = motorShards;
     } 
+    // a directory with the config files
+    if (configDirectoryValue != NULL && configValue == NULL) {
+        struct stat info;
+        if (stat(configDirectoryValue, &info) != 0 || !S_ISDIR(info.st_mode)) {
+            if ( errorMessage.gcount() >1) { errorMessage << "\n";}
+            errorMessage << "No valid config directory is given";
+            return false;
+        }
+        _configDirectory = std::string(configDirectoryValue);
+    } else {
+        // check if file exists
+        if (configValue == NULL || access( configValue, F_OK ) == -1 )
+        {
+            if ( errorMessage.gcount() >1) { errorMessage << "\n";}
+            errorMessage << "No valid config file is given";
+            return false;
+        } 
+        // check if file is a JSON file
+        _filePathOfConfig = std::string(configValue);
+        if(_filePathOfConfig.substr(_filePathOfConfig.find_last_of(".") + 1) != "json" && _filePathOfConfig.substr(_filePathOfConfig.find_last_of(".") + 1) != "JSON"  ) {
+            if ( errorMessage.gcount() >1) { errorMessage << "\n";}
+            errorMessage<< "The configuration file '" << _filePathOfConfig << "' is not a JSON file.";
+            return false;
+        } 
+    }
 
     if ( logValue !=NULL){
         _logPath = std::string(logValue);
     }
+    // spdlog takes an unknown name for off
+    if (logLevelValue != NULL) {
+        const std::string logLevel(logLevelValue);
+        if (spdlog::level::from_str(logLevel) == spdlog::level::off && logLevel != "off") {
+            if ( errorMessage.gcount() >1) { errorMessage << "\n";}
+            errorMessage << "Unknown log level '" << logLevel << "'";
+            return false;
+        }
+        _logLevel = logLevel;
+    }
     
     _isGenerateScriptsOn = (bool) isGenerateScriptsOn;
+    _isThreadedMqttLoopOn = isThreadedMqttLoopOn;
 
     std::string generateScriptsStr = _isGenerateScriptsOn ? "ON" : "OFF";
     if ( errorMessage.gcount() >1) { errorMessage << "\n";}
-    errorMessage << "Valid Cmd arguments: configFilePath -> " << _filePathOfConfig << ", port -> " << _port << " option generated scripts " <<  generateScriptsStr;
+    errorMessage << "Valid Cmd arguments: configFilePath -> " << _filePathOfConfig << ", configDirectory -> " << _configDirectory << ", port -> " << _port << " option generated scripts " <<  generateScriptsStr
+                 << " threaded mqtt loop " << (_isThreadedMqttLoopOn ? "ON" : "OFF") << ", motor shards -> " << _numberOfMotorShards << ", log level -> " << _logLevel;
     return true;
 }
\ No newline at end of file
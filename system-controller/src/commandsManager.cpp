@@ -1,74 +1,126 @@
 #include "commandsManager.h"
 #include "log.h"
 
-CommandsManager::CommandsManager() : _lastMoveCommand(std::tuple<std::string,CommandsInfo>("", MqttData("Empty"))) {
+#define LOG_COMMANDS_WARNING(...) LOG_SUBSYSTEM_WARNING(Log::Commands, __VA_ARGS__)
+#define LOG_COMMANDS_DEBUG(...) LOG_SUBSYSTEM_DEBUG(Log::Commands, __VA_ARGS__)
+
+CommandsManager::CommandsManager(TimerWheel & timerWheel) 
+: _lastMoveCommand(std::tuple<std::string,CommandsInfo>("", MqttData("Empty")))
+, _timerWheel(timerWheel)
+, _timerGuard(std::make_shared<TimerGuard>()) {
+    _timerGuard->owner = this;
+}
+CommandsManager::~CommandsManager() {
+    {   // wait for a running resend and make sure no other will run
+        std::lock_guard<std::mutex> lock(_timerGuard->mutex);
+        _timerGuard->owner = nullptr;
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto & c : _commandsBuffer) {
+        cancelResend(c.second);
+    }
+    cancelResend(std::get<1>(_lastMoveCommand));
 }
 
 void CommandsManager::stopEvaluating(){
+    std::lock_guard<std::mutex> lock(_mutex);
     if (!_isRunning) {
-        LOG_WARNING("CommandsManager tried to be stopped twice");
+        LOG_COMMANDS_WARNING("CommandsManager tried to be stopped twice");
         return;
     }
     _isRunning = false;
-    if (_workerThread.joinable()) {
-        _workerThread.join();
+    for (auto & c : _commandsBuffer) {
+        cancelResend(c.second);
     }
-    LOG_DEBUG("CommandsManager stopped");
+    cancelResend(std::get<1>(_lastMoveCommand));
+    LOG_COMMANDS_DEBUG("CommandsManager stopped");
 }
 void CommandsManager::startEvaluating()  {
+    std::lock_guard<std::mutex> lock(_mutex);
     if (_isRunning) {
-        LOG_WARNING("CommandsManager tried to be restarted");
+        LOG_COMMANDS_WARNING("CommandsManager tried to be restarted");
         return;
     }    
     _isRunning = true;
-    _workerThread = std::thread(&CommandsManager::evaluateAllCommandsInBuffer, this);
-    LOG_DEBUG("CommandsManager started");
+    // commands that were send while stopped are not acked yet
+    for (auto & c : _commandsBuffer) {
+        if (!c.second.isAcked) {
+            scheduleResend(c.first, c.second, false);
+        }
+    }
+    if (!std::get<0>(_lastMoveCommand).empty() && !std::get<1>(_lastMoveCommand).isAcked) {
+        scheduleResend(std::get<0>(_lastMoveCommand), std::get<1>(_lastMoveCommand), true);
+    }
+    LOG_COMMANDS_DEBUG("CommandsManager started");
 }
-// evaluate to check if we need to resend a message 
-// evaluate if the resend counter!!
-void CommandsManager::evaluateAllCommandsInBuffer() {
-
-    auto checkCommand = [&](CommandsInfo & c, const std::string&  id) {
-            if ( id.empty() ) {
-                return;
-            }
-            if ( c.isAcked) {
-                c.resendCounter =0;
-                return;
-            }
-            // postpone resend based on previous attempts
-            // extra wait time 
-            int waitTime  =  400 + c.resendCounter * 150; // at least wait 200ms before sending again
-            int extraTime = 0;
-            
-            if ( c.resendCounter >= _maxResendCountBeforeSlowDownOfSending) {                
-                LOG_CRITICAL(std::to_string(c.resendCounter) + " fails of sending command " + (std::string)(c.data));
-                extraTime = (c.resendCounter/4) * 200;                
-            }   
-            
-            int timePassed =std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - c.timeOfPublish).count();
-            if( timePassed > (waitTime + extraTime))
-            {                
-                if ( c.resendCounter > 5) {
-                    LOG_DEBUG("Time passed:" + std::to_string(timePassed) + " ms  WaitTime: " + std::to_string(waitTime + extraTime) + " ms");
-                }
-                send(c.data);
-                c.resendCounter++;
-            }
-    };
-
-    while (_isRunning) {
-        {
-            std::lock_guard<std::mutex> lock(_mutex);
-            if ( _commandsBuffer.size() >1) {
-                for ( auto & c : _commandsBuffer) {
-                    checkCommand(c.second,c.first);
-                }
-            }            
-            checkCommand(std::get<1>(_lastMoveCommand),std::get<0>(_lastMoveCommand));
-        }        
-        std::this_thread::sleep_for(std::chrono::milliseconds(200));
-    };
+// postpone the resend based on previous attempts, the time is relative to the first publish
+std::chrono::milliseconds CommandsManager::getResendDelay(int resendCounter) {
+    int waitTime  =  400 + resendCounter * 150;
+    int extraTime = 0;
+    if ( resendCounter >= _maxResendCountBeforeSlowDownOfSending) {                
+        extraTime = (resendCounter/4) * 200;                
+    }   
+    return std::chrono::milliseconds(waitTime + extraTime);
+}
+// call with the mutex locked
+void CommandsManager::scheduleResend(const std::string & command, CommandsInfo & info, bool isMoveCommand) {
+    if (!_isRunning) {
+        return;
+    }
+    cancelResend(info);
+    const uint64_t generation = _nextRetryGeneration++;
+    info.retryGeneration = generation;
+    // resend when strictly more than the resend delay passed
+    const auto delay = std::chrono::duration_cast<std::chrono::milliseconds>(
+        info.timeOfPublish + getResendDelay(info.resendCounter) - std::chrono::system_clock::now()) + std::chrono::milliseconds(1);
+    std::shared_ptr<TimerGuard> guard = _timerGuard;
+    info.retryTimer = _timerWheel.schedule(delay, [guard, command, generation, isMoveCommand]() {
+        std::lock_guard<std::mutex> lock(guard->mutex);
+        if (guard->owner) {
+            guard->owner->onResendTimer(command, generation, isMoveCommand);
+        }
+    });
+}
+// call with the mutex locked
+void CommandsManager::cancelResend(CommandsInfo & info) {
+    if (info.retryTimer != 0) {
+        _timerWheel.cancel(info.retryTimer);
+        info.retryTimer = 0;
+    }
+    info.retryGeneration = 0; // a resend that is already firing will be ignored
+}
+void CommandsManager::onResendTimer(const std::string & command, uint64_t generation, bool isMoveCommand) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_isRunning) {
+        return;
+    }
+    CommandsInfo * c = nullptr;
+    if (isMoveCommand) {
+        if (std::get<0>(_lastMoveCommand) == command) {
+            c = &std::get<1>(_lastMoveCommand);
+        }
+    } else {
+        auto commandItr = _commandsBuffer.find(command);
+        if (commandItr != _commandsBuffer.end()) {
+            c = &commandItr->second;
+        }
+    }
+    // replaced, acked or rescheduled in the meantime
+    if (c == nullptr || c->retryGeneration != generation || c->isAcked) {
+        return;
+    }
+    c->retryTimer = 0;
+    if ( c->resendCounter >= _maxResendCountBeforeSlowDownOfSending) {                
+        // a motor that never acks repeats this every resend
+        LOG_SUBSYSTEM_LIMITED(Log::Commands, spdlog::level::critical, "resend " + command, "{} fails of sending command {}", c->resendCounter, (std::string)(c->data));
+    }
+    if ( c->resendCounter > 5) {
+        int timePassed =std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - c->timeOfPublish).count();
+        LOG_COMMANDS_DEBUG("Time passed:{} ms  WaitTime: {} ms", timePassed, getResendDelay(c->resendCounter).count());
+    }
+    send(c->data);
+    c->resendCounter++;
+    scheduleResend(command, *c, isMoveCommand);
 }
 int CommandsManager::getNumberOfManagedCommands() const {
     std::lock_guard<std::mutex> lock(_mutex);
@@ -97,9 +149,10 @@ void CommandsManager::pushCommandoToBeSend(MqttData message, CommandType command
             auto simularCommandItr = _commandsBuffer.find(command);
             if ( simularCommandItr == _commandsBuffer.end()) {
                 // add to buffer and send  (the only place where the buffer grows -> new type of setParam- command)
-                _commandsBuffer.insert(std::pair<std::string,CommandsInfo>(command,CommandsInfo(message)));
-                LOG_DEBUG("Send :" + (std::string)(message));
+                auto inserted = _commandsBuffer.insert(std::pair<std::string,CommandsInfo>(command,CommandsInfo(message))).first;
+                LOG_COMMANDS_DEBUG("Send :{}", (std::string)(message));
                 send(message);
+                scheduleResend(command, inserted->second, false);
                 return;
             }
 
@@ -110,15 +163,17 @@ void CommandsManager::pushCommandoToBeSend(MqttData message, CommandType command
             auto prevMessageIsOld =  ((std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - c.timeOfPublish).count()) > 1000);
             if( sendAfterNewMoveCommand || c.data.getPayload() != message.getPayload() || prevMessageIsOld) {
                 // remove 'old' setCommand from the buffer (no need to check any more)
+                cancelResend(simularCommandItr->second);
                 _commandsBuffer.erase(simularCommandItr); // this prevents the buffer from growing !! 
                 // update by inserting new (=latest) command
-                _commandsBuffer.insert(std::pair<std::string,CommandsInfo>(command,CommandsInfo(message)));
-                LOG_DEBUG("Send :" + (std::string)(message));
+                auto inserted = _commandsBuffer.insert(std::pair<std::string,CommandsInfo>(command,CommandsInfo(message))).first;
+                LOG_COMMANDS_DEBUG("Send :{}", (std::string)(message));
                 send(message);
+                scheduleResend(command, inserted->second, false);
                 return;
             }
         }
-        // if command with correct parameters is already in the buffer -> do noting (the evaluator will handle time-outs)
+        // if command with correct parameters is already in the buffer -> do noting (the resend timer will handle time-outs)
         return;
     }   
     if (commandType == CommandType::SetMovement) {
@@ -131,28 +186,40 @@ void CommandsManager::pushCommandoToBeSend(MqttData message, CommandType command
             }   
         }       
 
+        cancelResend(std::get<1>(_lastMoveCommand));
         _lastMoveCommand = std::pair<std::string,CommandsInfo>(command, CommandsInfo(message));
-        LOG_DEBUG("Send :" + (std::string)(message));
+        LOG_COMMANDS_DEBUG("Send :{}", (std::string)(message));
         send(message);
+        scheduleResend(command, std::get<1>(_lastMoveCommand), true);
     }
 
 }
 void CommandsManager::handleAck(const MqttData & ackMessage) {
 
-    std::string topic = ackMessage.getTopic();
-    std::size_t found = topic.find_last_of("/\\");
-    std::string command = topic.substr(0,found);
+    // compare the command part of the topic in place, no substring is created for every ack
+    const std::string & topic = ackMessage.getTopic();
+    const std::size_t found = topic.find_last_of("/\\");
+    const std::size_t commandLength = (found == std::string::npos) ? topic.size() : found;
+    auto isAckOf = [&](const std::string & command) {
+        return command.size() == commandLength && topic.compare(0, commandLength, command) == 0;
+    };
     
     {   // make scope for lock_guard
         std::lock_guard<std::mutex> lock(_mutex);
-        if (command == std::get<0>(_lastMoveCommand)) {
-            std::get<1>(_lastMoveCommand).isAcked = true;
+        auto acked = [&](CommandsInfo & c) {
+            c.isAcked = true;
+            c.resendCounter = 0;
+            cancelResend(c);
+        };
+        if (isAckOf(std::get<0>(_lastMoveCommand))) {
+            acked(std::get<1>(_lastMoveCommand));
             return;
         }
-         // check if in buffer 
-        auto simularCommandItr  = _commandsBuffer.find(command);
+         // check if in buffer (only a few set-commands per motor)
+        auto simularCommandItr = std::find_if(_commandsBuffer.begin(), _commandsBuffer.end(), 
+            [&](const std::pair<const std::string, CommandsInfo> & c) { return isAckOf(c.first);});
         if ( simularCommandItr != _commandsBuffer.end()) {
-            _commandsBuffer.at(command).isAcked = true;
+            acked(simularCommandItr->second);
             return;
         } else {
             //LOG_TRACE("Acked message that was not send from this commandsManager! :" + (std::string)(ackMessage));
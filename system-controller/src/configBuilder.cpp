@@ -158,7 +158,7 @@ void ConfigBuilder::listWings(std::vector<ConfigObject> & configObjects, std::ve
     }
 }
 
-std::shared_ptr<IWing> ConfigBuilder::parseWing(std::vector<ConfigObject>::iterator & startOfWing,std::vector<ConfigObject>::iterator & endOfWing, bool hasOpeningLeft , const std::string &configId)  {
+std::shared_ptr<IWing> ConfigBuilder::parseWing(std::vector<ConfigObject>::iterator & startOfWing,std::vector<ConfigObject>::iterator & endOfWing, bool hasOpeningLeft , const std::string &configId, const MotorFactory & motorFactory)  {
 
     std::shared_ptr<IMovingWindow> lastElement;
     std::shared_ptr<IMovingWindow> currElement;
@@ -188,12 +188,12 @@ std::shared_ptr<IWing> ConfigBuilder::parseWing(std::vector<ConfigObject>::itera
         }
         if ( i->getParseType() == ConfigObjectType::motorized) {
             if ( hasOpeningLeft && i==start ||  !hasOpeningLeft && i==(end-1) ) { 
-                currElement = std::make_shared<MasterMotorizedWindow>(i->length,std::make_shared<MqttMotor>(i->pn,i->serial));
+                currElement = std::make_shared<MasterMotorizedWindow>(i->length,createMotor(*i,motorFactory));
                 master = std::dynamic_pointer_cast<MasterMotorizedWindow>(currElement);               
                 wing =std::make_shared<Wing>(master, std::make_shared<WingRelationManager>(),std::make_shared<WingStatusPublisher>(configId), hasOpeningLeft);  
                         
             } else {
-                currElement = std::make_shared<MotorizedWindow>(i->length,std::make_shared<MqttMotor>(i->pn,i->serial));
+                currElement = std::make_shared<MotorizedWindow>(i->length,createMotor(*i,motorFactory));
             }
         }        
         // handle slave topology
@@ -208,6 +208,11 @@ std::shared_ptr<IWing> ConfigBuilder::parseWing(std::vector<ConfigObject>::itera
         lastElementType = i->getParseType();
     }   
     if ( wing ) {
+        // a motor taken over from a previous configuration (reload) is already calibrated
+        if (master->getMotionManager()->isCalibrated() && master->getMotionManager()->getStroke() > 0) {
+            master->updatePanelLengtsBasedOnstroke();
+        }
+        wing->getMotors(); // the slaves are complete, compile the panel chain before the first motor update
         return wing;
     } else {
         LOG_CRITICAL_THROW("No wing is created! Failed to parse and return a wing");
@@ -216,10 +221,10 @@ std::shared_ptr<IWing> ConfigBuilder::parseWing(std::vector<ConfigObject>::itera
 
 
 
-void ConfigBuilder::connectWingsWithRelationsAndList(std::vector<std::tuple<std::vector<ConfigObject>::iterator,std::vector<ConfigObject>::iterator,bool>> & wingInfos, std::vector<std::shared_ptr<IWing>> & wings, const std::string &configId) {
+void ConfigBuilder::connectWingsWithRelationsAndList(std::vector<std::tuple<std::vector<ConfigObject>::iterator,std::vector<ConfigObject>::iterator,bool>> & wingInfos, std::vector<std::shared_ptr<IWing>> & wings, const std::string &configId, const MotorFactory & motorFactory) {
 
     for ( int j = 0; j< wingInfos.size() ; j++) {
-        wings.push_back(parseWing(std::get<0>(wingInfos[j]),std::get<1>(wingInfos[j]),std::get<2>(wingInfos[j]), configId));
+        wings.push_back(parseWing(std::get<0>(wingInfos[j]),std::get<1>(wingInfos[j]),std::get<2>(wingInfos[j]), configId, motorFactory));
         // when more that one wing there is a relation
         if ( j >= 1 ) {
             if ((std::get<0>(wingInfos[j]) - 1)-> getParseType() == ConfigObjectType::corner) {
@@ -240,10 +245,27 @@ void ConfigBuilder::connectWingsWithRelationsAndList(std::vector<std::tuple<std:
 }
 
 
-void ConfigBuilder::parseFromJson(std::string json, std::vector<std::shared_ptr<IWing>> & wings, std::string & configId) {
+std::shared_ptr<IMotorMotionManager> ConfigBuilder::createMotor(const ConfigObject & motorObject, const MotorFactory & motorFactory) {
+    if ( !motorFactory) {
+        return std::make_shared<MqttMotor>(motorObject.pn,motorObject.serial);
+    }
+    return motorFactory(motorObject);
+}
+
+void ConfigBuilder::parseFromJson(std::string json, std::vector<std::shared_ptr<IWing>> & wings, std::string & configId, const MotorFactory & motorFactory) {
     std::vector<ConfigObject> configObjects;
     parseJsonToObjects(json,configObjects, configId);
     std::vector<std::tuple<std::vector<ConfigObject>::iterator,std::vector<ConfigObject>::iterator,bool>> wingInfos;
     listWings(configObjects,wingInfos);
-    connectWingsWithRelationsAndList(wingInfos,wings, configId);
+    connectWingsWithRelationsAndList(wingInfos,wings, configId, motorFactory);
+}
+
+std::string ConfigBuilder::getGraphSignature(std::string json, std::string & configId) {
+    std::vector<ConfigObject> configObjects;
+    parseJsonToObjects(json,configObjects, configId);
+    std::string signature;
+    for (auto & o : configObjects) {
+        signature += o.type + ":" + std::to_string(o.length) + ":" + o.pn + ":" + o.serial + ";";
+    }
+    return signature;
 }
\ No newline at end of file
@@ -0,0 +1,34 @@
+#include "configReloadHandler.h"
+
+#include <utility>
+#include "log.h"
+
+namespace {
+    const std::string TopicPrefix = "systemcontroller/";
+    const std::string TopicSuffix = "/config/reload";
+}
+
+ConfigReloadHandler::ConfigReloadHandler(ReloadFunction reload)
+: TopicHandler({TopicPrefix + "+" + TopicSuffix}) , _reload(std::move(reload)) {
+}
+
+void ConfigReloadHandler::handleNewInput(const MqttData & inputData) {
+    const std::string & topic = inputData.getTopic();
+    if (topic.size() <= TopicPrefix.size() + TopicSuffix.size()) {
+        return;
+    }
+    const std::string configId = topic.substr(TopicPrefix.size(), topic.size() - TopicPrefix.size() - TopicSuffix.size());
+    LOG_INFO("Reload of configuration " + configId + " requested");
+    std::string result;
+    try {
+        result = _reload(configId, inputData.getPayload()) ? "rebuilt" : "settings";
+    } catch (const std::exception * e) {
+        LOG_ERROR("Reload of configuration " + configId + " failed: " + e->what());
+        delete e;
+        result = "failed";
+    } catch (const std::exception & e) {
+        LOG_ERROR("Reload of configuration " + configId + " failed: " + e.what());
+        result = "failed";
+    }
+    _pOutTypeBuffer->QueueNewMessage(MqttData(topic + "/result", "{\"result\":\"" + result + "\"}"));
+}
@@ -0,0 +1,234 @@
+#include "configurationHost.h"
+
+#include <dirent.h>
+#include <utility>
+#include "log.h"
+#include "systemSettingsParser.h"
+#include "wingInputTranslator.h"
+
+ConfigurationHost::ConfigurationHost(std::size_t numberOfMotorShards, std::shared_ptr<ThreadPool> threadPool)
+    : _threadPool(threadPool ? std::move(threadPool) : std::make_shared<ThreadPool>())
+    , _motorsHandler(std::make_shared<MotorsHandler>(numberOfMotorShards))
+    , _diagnosticsHandler(std::make_shared<DiagnosticsHandler>()) {
+    _reloadHandler = std::make_shared<ConfigReloadHandler>([this](const std::string & configId, const std::string & json) {
+        if (json.empty()) {
+            return reloadConfigurationFile(configId);
+        }
+        std::string jsonConfigId;
+        ConfigBuilder::getGraphSignature(json, jsonConfigId);
+        if (jsonConfigId != configId) {
+            LOG_CRITICAL_THROW("Configuration " + jsonConfigId + " can not replace configuration " + configId);
+        }
+        return reloadConfiguration(json);
+    });
+}
+
+std::string ConfigurationHost::addConfiguration(const std::string & json, const ConfigBuilder::MotorFactory & motorFactory) {
+    return addConfiguration(json, motorFactory, "");
+}
+
+std::string ConfigurationHost::addConfigurationFile(const std::string & path, const ConfigBuilder::MotorFactory & motorFactory) {
+    std::ifstream f(path);
+    if (!f) {
+        LOG_CRITICAL_THROW("Failed to read configuration file " + path);
+    }
+    std::ostringstream ss;
+    ss << f.rdbuf();
+    std::string json = ss.str();
+    // the system settings are shared by all configurations
+    SystemSettingsParser::parseJsonToSettings(json);
+    return addConfiguration(json, motorFactory, path);
+}
+
+std::string ConfigurationHost::addConfiguration(const std::string & json, const ConfigBuilder::MotorFactory & motorFactory, const std::string & file) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::string configId;
+    ConfigBuilder::getGraphSignature(json, configId);
+    if (_configurations.count(configId) > 0) {
+        LOG_CRITICAL_THROW("Configuration " + configId + " is already hosted");
+    }
+    Configuration configuration;
+    configuration.file = file;
+    configuration.motorFactory = motorFactory;
+    buildWings(json, configuration, Configuration());
+
+    configuration.wingsHandler = std::make_shared<WingsHandler>(configId, std::make_shared<WingInputTranslator>(), _threadPool);
+    for (auto & wing : configuration.wings) {
+        configuration.wingsHandler->addWing(wing);
+    }
+    for (auto & motor : configuration.mqttMotors) {
+        LOG_INFO("Adding motor " + motor.first);
+        _motorsHandler->addMotor(motor.second);
+        _motorIds.insert(motor.first);
+    }
+    LOG_INFO("Hosting configuration " + configId + " with " + std::to_string(configuration.wings.size()) + " wings");
+    _configurations.insert(std::make_pair(configId, std::move(configuration)));
+    _configurationOrder.push_back(configId);
+    return configId;
+}
+
+bool ConfigurationHost::reloadConfiguration(const std::string & json) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::string configId;
+    const std::string signature = ConfigBuilder::getGraphSignature(json, configId);
+    auto found = _configurations.find(configId);
+    if (found == _configurations.end()) {
+        LOG_CRITICAL_THROW("Configuration " + configId + " is not hosted and can not be reloaded");
+    }
+    Configuration & current = found->second;
+    std::string settingsJson = json;
+    if (signature == current.signature) {
+        SystemSettingsParser::parseJsonToSettings(settingsJson);
+        LOG_INFO("Reloaded the system settings of configuration " + configId + ", the wings are unchanged");
+        return false;
+    }
+
+    // everything that can fail is done before the running configuration is touched
+    Configuration next;
+    next.file = current.file;
+    next.motorFactory = current.motorFactory;
+    next.wingsHandler = current.wingsHandler;
+    buildWings(json, next, current);
+    SystemSettingsParser::parseJsonToSettings(settingsJson);
+
+    // a wing on the same master motor keeps its id, the commands sent to it stay valid
+    for (auto & wing : next.wings) {
+        for (auto & oldWing : current.wings) {
+            if (wing->getMasterWindow()->getMotionManager() == oldWing->getMasterWindow()->getMotionManager()) {
+                wing->setWingId(oldWing->getWingId());
+                break;
+            }
+        }
+    }
+    next.wingsHandler->replaceWings(next.wings);
+    for (auto & motor : next.mqttMotors) {
+        if (current.mqttMotors.count(motor.first) == 0) {
+            LOG_INFO("Adding motor " + motor.first);
+            _motorsHandler->addMotor(motor.second);
+            _motorIds.insert(motor.first);
+        }
+    }
+    for (auto & motor : current.mqttMotors) {
+        if (next.mqttMotors.count(motor.first) == 0) {
+            LOG_INFO("Removing motor " + motor.first);
+            _motorsHandler->removeMotor(motor.first);
+            _motorIds.erase(motor.first);
+        }
+    }
+    LOG_INFO("Reloaded configuration " + configId + ": " + std::to_string(current.wings.size()) + " wings replaced by "
+        + std::to_string(next.wings.size()) + ", " + std::to_string(current.motors.size()) + " motors before, " + std::to_string(next.motors.size()) + " after");
+    std::swap(current, next); // the old wings are released with next
+    return true;
+}
+
+bool ConfigurationHost::reloadConfigurationFile(const std::string & configId) {
+    std::string file;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        file = getConfiguration(configId).file;
+    }
+    if (file.empty()) {
+        LOG_CRITICAL_THROW("Configuration " + configId + " was not loaded from a file");
+    }
+    std::ifstream f(file);
+    std::ostringstream ss;
+    ss << f.rdbuf();
+    std::string fileConfigId;
+    ConfigBuilder::getGraphSignature(ss.str(), fileConfigId);
+    if (fileConfigId != configId) {
+        LOG_CRITICAL_THROW("Configuration file " + file + " contains configuration " + fileConfigId + " instead of " + configId);
+    }
+    return reloadConfiguration(ss.str());
+}
+
+void ConfigurationHost::buildWings(const std::string & json, Configuration & configuration, const Configuration & previous) const {
+    std::string configId;
+    configuration.signature = ConfigBuilder::getGraphSignature(json, configId);
+    auto motorFactory = [&configuration, &previous](const ConfigObject & motorObject) {
+        const std::string key = motorObject.pn + "/" + motorObject.serial;
+        auto kept = previous.motors.find(key);
+        std::shared_ptr<IMotorMotionManager> motor;
+        if (kept != previous.motors.end()) {
+            motor = kept->second;
+        } else if (configuration.motorFactory) {
+            motor = configuration.motorFactory(motorObject);
+        } else {
+            motor = std::make_shared<MqttMotor>(motorObject.pn, motorObject.serial);
+        }
+        configuration.motors[key] = motor;
+        return motor;
+    };
+    ConfigBuilder::parseFromJson(json, configuration.wings, configId, motorFactory);
+
+    // a motor can only be steered by one configuration, checked before anything is registered
+    for (auto & wing : configuration.wings) {
+        for (auto & m : wing->getMotors()) {
+            auto motor = std::dynamic_pointer_cast<IMqttMotor>(m->getMotionManager());
+            if (!motor) {
+                continue; // not steered over MQTT (simulated)
+            }
+            const bool isUsedElsewhere = _motorIds.count(motor->getId()) > 0 && previous.mqttMotors.count(motor->getId()) == 0;
+            if (isUsedElsewhere || !configuration.mqttMotors.insert(std::make_pair(motor->getId(), motor)).second) {
+                LOG_CRITICAL_THROW("Motor " + motor->getId() + " of configuration " + configId + " is already in use");
+            }
+        }
+    }
+}
+
+std::vector<std::shared_ptr<TopicHandler>> ConfigurationHost::getTopicHandlers() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::vector<std::shared_ptr<TopicHandler>> topicHandlers = {_motorsHandler};
+    for (auto & configId : _configurationOrder) {
+        topicHandlers.push_back(getConfiguration(configId).wingsHandler);
+    }
+    topicHandlers.push_back(_reloadHandler);
+    topicHandlers.push_back(_diagnosticsHandler);
+    return topicHandlers;
+}
+
+std::vector<std::string> ConfigurationHost::getConfigurationIds() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _configurationOrder;
+}
+
+std::vector<std::shared_ptr<IWing>> ConfigurationHost::getWings(const std::string & configId) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return getConfiguration(configId).wings;
+}
+
+std::shared_ptr<WingsHandler> ConfigurationHost::getWingsHandler(const std::string & configId) const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return getConfiguration(configId).wingsHandler;
+}
+
+// call with the configurations locked
+const ConfigurationHost::Configuration & ConfigurationHost::getConfiguration(const std::string & configId) const {
+    auto configuration = _configurations.find(configId);
+    if (configuration == _configurations.end()) {
+        LOG_CRITICAL_THROW("Configuration " + configId + " is not hosted");
+    }
+    return configuration->second;
+}
+
+std::vector<std::string> ConfigurationHost::listConfigFiles(const std::string & directory) {
+    std::vector<std::string> files;
+    DIR * dir = opendir(directory.c_str());
+    if (dir == nullptr) {
+        LOG_ERROR("Failed to open configuration directory " + directory);
+        return files;
+    }
+    while (struct dirent * entry = readdir(dir)) {
+        const std::string name(entry->d_name);
+        const std::size_t dot = name.find_last_of('.');
+        if (dot == std::string::npos || name[0] == '.') {
+            continue;
+        }
+        const std::string extension = name.substr(dot + 1);
+        if (extension == "json" || extension == "JSON") {
+            files.push_back(directory + "/" + name);
+        }
+    }
+    closedir(dir);
+    std::sort(files.begin(), files.end());
+    return files;
+}
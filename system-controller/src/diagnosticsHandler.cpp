@@ -0,0 +1,113 @@
+#include "diagnosticsHandler.h"
+
+#include <stdexcept>
+#include "log.h"
+
+namespace {
+    const std::string TopicPrefix = "systemcontroller/";
+    const std::string TopicSuffix = "/diag/loglevel";
+
+    spdlog::level::level_enum parseLevel(const rapidjson::Value & value) {
+        if (value.IsString()) {
+            const std::string name = value.GetString();
+            const auto level = spdlog::level::from_str(name); // an unknown name is off
+            if (level != spdlog::level::off || name == "off") {
+                return level;
+            }
+        }
+        throw std::invalid_argument("unknown log level");
+    }
+
+    std::string getLevelName(spdlog::level::level_enum level) {
+        const auto name = spdlog::level::to_string_view(level);
+        return std::string(name.data(), name.size());
+    }
+}
+
+DiagnosticsHandler::DiagnosticsHandler()
+: TopicHandler({TopicPrefix + "+" + TopicSuffix}) {
+}
+
+void DiagnosticsHandler::applyLogSettings(const std::string & json) {
+    if (json.empty()) {
+        return;
+    }
+    rapidjson::Document doc;
+    doc.Parse(json.data());
+    if (doc.HasParseError() || !doc.IsObject()) {
+        throw std::invalid_argument("expected a JSON object");
+    }
+    const bool hasLevel = doc.HasMember("level");
+    const auto level = hasLevel ? parseLevel(doc["level"]) : spdlog::level::trace;
+
+    std::vector<std::pair<Log::Subsystem, spdlog::level::level_enum>> subsystemLevels;
+    if (doc.HasMember("subsystems")) {
+        rapidjson::Value & subsystems = doc["subsystems"];
+        if (!subsystems.IsObject()) {
+            throw std::invalid_argument("subsystems should be an object");
+        }
+        for (auto member = subsystems.MemberBegin(); member != subsystems.MemberEnd(); ++member) {
+            Log::Subsystem subsystem;
+            if (!Log::tryGetSubsystem(member->name.GetString(), subsystem)) {
+                throw std::invalid_argument("unknown subsystem");
+            }
+            subsystemLevels.push_back(std::make_pair(subsystem, parseLevel(member->value)));
+        }
+    }
+
+    const bool hasRateLimit = doc.HasMember("rateLimit");
+    int messagesPerPeriod = 0;
+    int periodMs = 0;
+    if (hasRateLimit) {
+        rapidjson::Value & rateLimit = doc["rateLimit"];
+        if (rateLimit.IsObject() && rateLimit.HasMember("messages") && rateLimit["messages"].IsInt()
+            && rateLimit.HasMember("periodMs") && rateLimit["periodMs"].IsInt()) {
+            messagesPerPeriod = rateLimit["messages"].GetInt();
+            periodMs = rateLimit["periodMs"].GetInt();
+        }
+        if (messagesPerPeriod < 0 || periodMs <= 0) {
+            throw std::invalid_argument("rateLimit should have the messages and a periodMs above 0");
+        }
+    }
+
+    if (hasLevel) {
+        Log::GetLogger()->set_level(level);
+    }
+    for (auto & subsystemLevel : subsystemLevels) {
+        Log::setLevel(subsystemLevel.first, subsystemLevel.second);
+    }
+    if (hasRateLimit) {
+        Log::getRateLimiter().setLimit(messagesPerPeriod, std::chrono::milliseconds(periodMs));
+    }
+}
+
+std::string DiagnosticsHandler::getLogSettings() {
+    std::string settings = "{\"level\":\"" + getLevelName(Log::GetLogger()->level()) + "\",\"subsystems\":{";
+    for (int i = 0; i < Log::NumberOfSubsystems; ++i) {
+        const auto subsystem = (Log::Subsystem)i;
+        settings += std::string(i == 0 ? "" : ",") + "\"" + Log::getSubsystemName(subsystem) + "\":\"" + getLevelName(Log::getLevel(subsystem)) + "\"";
+    }
+    const LogRateLimiter & rateLimiter = Log::getRateLimiter();
+    settings += "},\"rateLimit\":{\"messages\":" + std::to_string(rateLimiter.getMessagesPerPeriod())
+        + ",\"periodMs\":" + std::to_string(rateLimiter.getPeriod().count())
+        + "},\"droppedMessages\":" + std::to_string(Log::getNumberOfDroppedMessages()) + "}";
+    return settings;
+}
+
+void DiagnosticsHandler::handleNewInput(const MqttData & inputData) {
+    const std::string & topic = inputData.getTopic();
+    if (topic.size() <= TopicPrefix.size() + TopicSuffix.size()) {
+        return;
+    }
+    std::string result = "ok";
+    try {
+        if (!inputData.getPayload().empty()) {
+            applyLogSettings(inputData.getPayload());
+            LOG_INFO("Log settings changed to " + getLogSettings());
+        }
+    } catch (const std::exception & e) {
+        LOG_ERROR("Log settings not changed: " + std::string(e.what()));
+        result = "failed";
+    }
+    _pOutTypeBuffer->QueueNewMessage(MqttData(topic + "/result", "{\"result\":\"" + result + "\",\"logging\":" + getLogSettings() + "}"));
+}
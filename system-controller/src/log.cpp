@@ -3,9 +3,15 @@
 
 //Loglevels: trace,debug,info,warn,err,critical,off
 std::shared_ptr<spdlog::logger> Log::_logger;
+std::atomic<int> Log::_levels[Log::NumberOfSubsystems] {};
+LogRateLimiter Log::_rateLimiter(10, std::chrono::seconds(10));
+
+namespace {
+    const char * SubsystemNames[Log::NumberOfSubsystems] = {"general", "motor", "wing", "mqtt", "commands"};
+}
 
 
-void Log::Init( std::string logFolder)
+void Log::Init( std::string logFolder, spdlog::level::level_enum level)
 {
     std::string fileName = "systemController.log";
     
@@ -35,9 +41,10 @@ void Log::Init( std::string logFolder)
     
 
     std::vector<spdlog::sink_ptr> sinks {stdout_sink, rotating_sink};
-    _logger = std::make_shared<spdlog::async_logger>("system-controller", sinks.begin(), sinks.end(), spdlog::thread_pool(), spdlog::async_overflow_policy::block);
-    _logger->set_level(spdlog::level::trace);
-    _logger->flush_on(spdlog::level::warn);
+    _logger = std::make_shared<spdlog::async_logger>("system-controller", sinks.begin(), sinks.end(), spdlog::thread_pool(), spdlog::async_overflow_policy::overrun_oldest);
+    _logger->set_level(level);
+    // errors are written through right away, the storms of the same error are rate limited
+    _logger->flush_on(spdlog::level::err);
 
    // spdlog::flush_every(std::chrono::seconds(3));
 
@@ -46,3 +53,30 @@ void Log::Init( std::string logFolder)
 void Log::Init() {
     Init("log");
 }
+
+void Log::setLevel(Subsystem subsystem, spdlog::level::level_enum level) {
+    _levels[subsystem].store(level, std::memory_order_relaxed);
+}
+
+spdlog::level::level_enum Log::getLevel(Subsystem subsystem) {
+    return (spdlog::level::level_enum)_levels[subsystem].load(std::memory_order_relaxed);
+}
+
+const char * Log::getSubsystemName(Subsystem subsystem) {
+    return SubsystemNames[subsystem];
+}
+
+bool Log::tryGetSubsystem(const std::string & name, Subsystem & subsystem) {
+    for (int i = 0; i < NumberOfSubsystems; ++i) {
+        if (name == SubsystemNames[i]) {
+            subsystem = (Subsystem)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+std::size_t Log::getNumberOfDroppedMessages() {
+    auto threadPool = spdlog::thread_pool();
+    return threadPool ? threadPool->overrun_counter() : 0;
+}
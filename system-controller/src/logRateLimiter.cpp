@@ -0,0 +1,67 @@
+#include "logRateLimiter.h"
+
+const std::size_t LogRateLimiter::MaxKeys;
+
+LogRateLimiter::LogRateLimiter(std::size_t messagesPerPeriod, std::chrono::milliseconds period)
+    : _messagesPerPeriod(messagesPerPeriod)
+    , _period(period) {
+}
+
+bool LogRateLimiter::tryAcquire(const std::string & key, std::size_t & suppressed, Clock::time_point now) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    suppressed = 0;
+    if (_messagesPerPeriod == 0) {
+        return true;
+    }
+    auto keyItr = _keys.find(key);
+    if (keyItr == _keys.end()) {
+        if (_keys.size() >= MaxKeys) {
+            forgetPassedPeriods(now);
+        }
+        keyItr = _keys.insert(std::make_pair(key, KeyState())).first;
+        keyItr->second.periodStart = now;
+    } else if (now - keyItr->second.periodStart >= _period) {
+        keyItr->second.periodStart = now;
+        keyItr->second.logged = 0;
+    }
+    KeyState & state = keyItr->second;
+    if (state.logged >= _messagesPerPeriod) {
+        state.suppressed++;
+        return false;
+    }
+    state.logged++;
+    suppressed = state.suppressed;
+    state.suppressed = 0;
+    return true;
+}
+
+// the suppressed counts of a forgotten key are lost, when nothing passed everything is forgotten
+void LogRateLimiter::forgetPassedPeriods(Clock::time_point now) {
+    for (auto keyItr = _keys.begin(); keyItr != _keys.end();) {
+        if (now - keyItr->second.periodStart >= _period) {
+            keyItr = _keys.erase(keyItr);
+        } else {
+            ++keyItr;
+        }
+    }
+    if (_keys.size() >= MaxKeys) {
+        _keys.clear();
+    }
+}
+
+void LogRateLimiter::setLimit(std::size_t messagesPerPeriod, std::chrono::milliseconds period) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _messagesPerPeriod = messagesPerPeriod;
+    _period = period;
+    _keys.clear();
+}
+
+std::size_t LogRateLimiter::getMessagesPerPeriod() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _messagesPerPeriod;
+}
+
+std::chrono::milliseconds LogRateLimiter::getPeriod() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _period;
+}
@@ -0,0 +1,153 @@
+#include "loopbackTransport.h"
+
+#include <utility>
+#include "log.h"
+
+int LoopbackBus::attach(const std::shared_ptr<Inbox> & inbox) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    const int endpoint = _nextEndpoint++;
+    _inboxes[endpoint] = inbox;
+    return endpoint;
+}
+
+void LoopbackBus::detach(int endpoint) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _inboxes.erase(endpoint);
+    _subscriptionList.erase(std::remove_if(_subscriptionList.begin(), _subscriptionList.end(),
+        [endpoint](const std::pair<std::string, int> & s) {return s.second == endpoint;}), _subscriptionList.end());
+    compileSubscriptions();
+}
+
+void LoopbackBus::subscribe(int endpoint, const std::string & subscription) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_inboxes.count(endpoint) == 0) {
+        return;
+    }
+    _subscriptionList.push_back(std::make_pair(subscription, endpoint));
+    _subscriptions.add(subscription, endpoint);
+}
+
+// subscriptions are rarely removed, the matcher is simply rebuilt
+void LoopbackBus::compileSubscriptions() {
+    _subscriptions.clear();
+    for (auto & s : _subscriptionList) {
+        _subscriptions.add(s.first, s.second);
+    }
+}
+
+void LoopbackBus::publish(const MqttData & data) {
+    thread_local std::vector<std::size_t> matched;
+    matched.clear();
+    std::lock_guard<std::mutex> lock(_mutex);
+    _publishedMessages++;
+    _subscriptions.match(data.getTopic(), matched);
+    for (auto endpoint : matched) {
+        auto inbox = _inboxes.find((int)endpoint);
+        if (inbox != _inboxes.end()) {
+            inbox->second->QueueNewMessage(data);
+            _deliveredMessages++;
+        }
+    }
+}
+
+std::size_t LoopbackBus::getNumberOfPublishedMessages() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _publishedMessages;
+}
+
+std::size_t LoopbackBus::getNumberOfDeliveredMessages() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _deliveredMessages;
+}
+
+const std::size_t LoopbackTransport::DefaultInboxCapacity;
+const std::chrono::milliseconds LoopbackTransport::LoopTimeout(100);
+
+LoopbackTransport::LoopbackTransport(std::shared_ptr<LoopbackBus> bus, std::size_t inboxCapacity)
+    : _bus(std::move(bus))
+    , _inbox(std::make_shared<LoopbackBus::Inbox>(inboxCapacity, OverflowPolicy::DropOldest)) {
+}
+
+LoopbackTransport::~LoopbackTransport() {
+    stopThreadedLoop();
+    const int endpoint = _endpoint.exchange(-1);
+    if (endpoint >= 0) {
+        _bus->detach(endpoint);
+    }
+}
+
+bool LoopbackTransport::connect() {
+    if (!isConnected()) {
+        _endpoint = _bus->attach(_inbox);
+    }
+    if (_connectionHandler) {
+        _connectionHandler(true);
+    }
+    return true;
+}
+
+void LoopbackTransport::disconnect() {
+    const int endpoint = _endpoint.exchange(-1);
+    if (endpoint < 0) {
+        return;
+    }
+    _bus->detach(endpoint);
+    if (_connectionHandler) {
+        _connectionHandler(false);
+    }
+}
+
+bool LoopbackTransport::subscribe(const std::string & subscription) {
+    const int endpoint = _endpoint;
+    if (endpoint < 0) {
+        return false;
+    }
+    _bus->subscribe(endpoint, subscription);
+    return true;
+}
+
+bool LoopbackTransport::publish(const MqttData & data) {
+    if (!isConnected()) {
+        return false;
+    }
+    _bus->publish(data);
+    return true;
+}
+
+bool LoopbackTransport::loop() {
+    if (!isConnected()) {
+        return false;
+    }
+    _received.clear();
+    if (_inbox->UnqueueAll(_received) == 0) {
+        _inbox->WaitForMessage(LoopTimeout);
+        _inbox->UnqueueAll(_received);
+    }
+    if (_messageHandler) {
+        for (auto & data : _received) {
+            _messageHandler(data);
+        }
+    }
+    return true;
+}
+
+bool LoopbackTransport::startThreadedLoop() {
+    if (_threadedLoopRunning.exchange(true)) {
+        return true;
+    }
+    _loopThread = std::thread([this]() {
+        while (_threadedLoopRunning) {
+            if (!loop()) {
+                std::this_thread::sleep_for(LoopTimeout);
+            }
+        }
+    });
+    return true;
+}
+
+void LoopbackTransport::stopThreadedLoop() {
+    _threadedLoopRunning = false;
+    if (_loopThread.joinable()) {
+        _loopThread.join();
+    }
+}
@@ -6,10 +6,11 @@
 MasterMotorizedWindow::MasterMotorizedWindow(  int length, std::shared_ptr<IMotorMotionManager> motionManager) 
 : MotorizedWindow(length, std::move(motionManager)) , _target(0) , _targetType(TargetType::None)  {
     
-    getMotionManager()->addOnMotorCalibratedhandler([&]() { updatePanelLengtsBasedOnstroke();});
+    _calibratedHandlerId = getMotionManager()->addOnMotorCalibratedhandler([&]() { updatePanelLengtsBasedOnstroke();});
 }
 
 MasterMotorizedWindow::~MasterMotorizedWindow() {
+    getMotionManager()->removeOnMotorCalibratedhandler(_calibratedHandlerId);
     stopCalibrationWorkers();
 }
 void MasterMotorizedWindow::setTarget(int newTarget){
@@ -241,7 +242,7 @@ void MasterMotorizedWindow::onPositionUpdate(int newPosition) {
     } 
 }
 
-void recursiveGetSlavesCount (int & total , std::vector<std::shared_ptr<IMovingWindow>> slave) {
+void recursiveGetSlavesCount (int & total , const std::vector<std::shared_ptr<IMovingWindow>> & slave) {
     total += slave.size();
     for ( auto &s : slave) {
         recursiveGetSlavesCount(total,s->getSlaves());
@@ -262,15 +263,13 @@ int MasterMotorizedWindow::getTailDistanceToFullyClose() {
         LOG_ERROR("tail position cannot be calculated when the _positionOfTailWhenFullyOpen is not set");
         return 0;
     }
-    std::vector<std::shared_ptr<IMovingWindow>> slaves = getSlaves();
-    if ( slaves.empty()) {
+    if ( _slaveWindows.empty()) {
         return getMotionManager()->getStroke() - getPosition();
     }
 
-    int posOfLastSlave = 0;
-    while (!slaves.empty()) {
-        posOfLastSlave = slaves[0]->getPosition();
-        slaves =  slaves[0]->getSlaves(); // todo change slaves to be only one in stead of array!!
+    IMovingWindow * lastSlave = this;
+    while (!lastSlave->getSlaves().empty()) {
+        lastSlave = lastSlave->getSlaves()[0].get(); // todo change slaves to be only one in stead of array!!
     }
-    return _positionOfTailWhenFullyOpen - posOfLastSlave;
+    return _positionOfTailWhenFullyOpen - lastSlave->getPosition();
 }
\ No newline at end of file
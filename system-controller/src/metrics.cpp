@@ -0,0 +1,139 @@
+#include "metrics.h"
+
+#include <cmath>
+
+const std::size_t Counter::NumberOfShards;
+const int Histogram::SubBucketBits;
+const std::size_t Histogram::NumberOfBuckets;
+
+namespace {
+    std::atomic<std::size_t> nextShard {0};
+    thread_local std::size_t threadShard = nextShard.fetch_add(1, std::memory_order_relaxed) % Counter::NumberOfShards;
+}
+
+std::size_t Counter::getShard() {
+    return threadShard;
+}
+
+uint64_t Counter::get() const {
+    uint64_t sum = 0;
+    for (auto & shard : _shards) {
+        sum += shard.value.load(std::memory_order_relaxed);
+    }
+    return sum;
+}
+
+std::size_t Histogram::getBucket(uint64_t value) {
+    const uint64_t SubBuckets = 1 << SubBucketBits;
+    if (value < SubBuckets) {
+        return (std::size_t)value;
+    }
+    const int exponent = 63 - __builtin_clzll(value);
+    const uint64_t subBucket = (value >> (exponent - SubBucketBits)) & (SubBuckets - 1);
+    return (std::size_t)((exponent - SubBucketBits + 1) * SubBuckets + subBucket);
+}
+
+uint64_t Histogram::getBucketLimit(std::size_t bucket) {
+    const uint64_t SubBuckets = 1 << SubBucketBits;
+    if (bucket < SubBuckets) {
+        return bucket;
+    }
+    const int shift = (int)(bucket / SubBuckets) - 1;
+    const uint64_t lowest = (SubBuckets + bucket % SubBuckets) << shift;
+    return lowest + (((uint64_t)1 << shift) - 1);
+}
+
+void Histogram::record(uint64_t value) {
+    _buckets[getBucket(value)].fetch_add(1, std::memory_order_relaxed);
+    uint64_t max = _max.load(std::memory_order_relaxed);
+    while (value > max && !_max.compare_exchange_weak(max, value, std::memory_order_relaxed)) {
+    }
+}
+
+// the buckets are read one by one while others record, the summary is close but not exact then
+Histogram::Summary Histogram::getSummary() const {
+    Summary summary;
+    std::array<uint64_t, NumberOfBuckets> counts;
+    for (std::size_t i = 0; i < NumberOfBuckets; ++i) {
+        counts[i] = _buckets[i].load(std::memory_order_relaxed);
+        summary.count += counts[i];
+    }
+    summary.max = _max.load(std::memory_order_relaxed);
+    if (summary.count == 0) {
+        return summary;
+    }
+    const auto percentile = [&](double p) {
+        const uint64_t rank = std::max<uint64_t>(1, (uint64_t)std::ceil(p * summary.count));
+        uint64_t seen = 0;
+        for (std::size_t i = 0; i < NumberOfBuckets; ++i) {
+            seen += counts[i];
+            if (seen >= rank) {
+                return std::min(getBucketLimit(i), summary.max);
+            }
+        }
+        return summary.max;
+    };
+    summary.p50 = percentile(0.50);
+    summary.p90 = percentile(0.90);
+    summary.p99 = percentile(0.99);
+    return summary;
+}
+
+MetricsRegistry& MetricsRegistry::getInstance() {
+    static MetricsRegistry instance;
+    return instance;
+}
+
+namespace {
+    template<typename Metric>
+    Metric & getOrAdd(std::map<std::string, std::unique_ptr<Metric>> & metrics, const std::string & name) {
+        auto & metric = metrics[name];
+        if (!metric) {
+            metric.reset(new Metric());
+        }
+        return *metric;
+    }
+}
+
+Counter & MetricsRegistry::getCounter(const std::string & name) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return getOrAdd(_counters, name);
+}
+
+Gauge & MetricsRegistry::getGauge(const std::string & name) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return getOrAdd(_gauges, name);
+}
+
+Histogram & MetricsRegistry::getHistogram(const std::string & name) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return getOrAdd(_histograms, name);
+}
+
+// the names are made by the code (ids, topic handler types), they need no JSON escaping
+std::string MetricsRegistry::getSnapshot() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::ostringstream json;
+    json << "{\"counters\":{";
+    const char * separator = "";
+    for (auto & counter : _counters) {
+        json << separator << "\"" << counter.first << "\":" << counter.second->get();
+        separator = ",";
+    }
+    json << "},\"gauges\":{";
+    separator = "";
+    for (auto & gauge : _gauges) {
+        json << separator << "\"" << gauge.first << "\":" << gauge.second->get();
+        separator = ",";
+    }
+    json << "},\"histograms\":{";
+    separator = "";
+    for (auto & histogram : _histograms) {
+        const Histogram::Summary summary = histogram.second->getSummary();
+        json << separator << "\"" << histogram.first << "\":{\"n\":" << summary.count << ",\"p50\":" << summary.p50
+            << ",\"p90\":" << summary.p90 << ",\"p99\":" << summary.p99 << ",\"max\":" << summary.max << "}";
+        separator = ",";
+    }
+    json << "}}";
+    return json.str();
+}
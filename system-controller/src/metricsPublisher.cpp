@@ -0,0 +1,79 @@
+#include "metricsPublisher.h"
+
+#include <utility>
+#include "log.h"
+#include "metrics.h"
+
+namespace {
+    const std::string TopicPrefix = "systemcontroller/";
+    const std::string TopicSuffix = "/metrics";
+    const std::string GetSuffix = "/get";
+}
+
+MetricsPublisher::MetricsPublisher(ConfigIdsFunction getConfigIds, std::chrono::milliseconds period, TimerWheel & timerWheel)
+: TopicHandler({TopicPrefix + "+" + TopicSuffix + GetSuffix})
+, _getConfigIds(std::move(getConfigIds))
+, _period(period)
+, _timerWheel(timerWheel)
+, _timerGuard(std::make_shared<TimerGuard>()) {
+}
+
+MetricsPublisher::~MetricsPublisher() {
+    std::lock_guard<std::mutex> lock(_timerGuard->mutex);
+    _timerGuard->owner = nullptr;
+}
+
+void MetricsPublisher::start() {
+    const bool wasRunning = isRunning();
+    TopicHandler::start();
+    if (wasRunning) {
+        return; // the publishing is already scheduled
+    }
+    // a new guard, a timer of a previous start never publishes again
+    _timerGuard = std::make_shared<TimerGuard>();
+    _timerGuard->owner = this;
+    schedulePublish();
+}
+
+// a timer that is still pending finds no owner anymore
+void MetricsPublisher::stop() {
+    {
+        std::lock_guard<std::mutex> lock(_timerGuard->mutex);
+        _timerGuard->owner = nullptr;
+    }
+    TopicHandler::stop();
+}
+
+void MetricsPublisher::schedulePublish() {
+    std::shared_ptr<TimerGuard> guard = _timerGuard;
+    _timerWheel.schedule(_period, [guard]() {
+        std::lock_guard<std::mutex> lock(guard->mutex);
+        if (guard->owner) {
+            const std::string snapshot = getSnapshot();
+            for (auto & configId : guard->owner->_getConfigIds()) {
+                guard->owner->publish(configId, snapshot);
+            }
+            guard->owner->schedulePublish();
+        }
+    });
+}
+
+std::string MetricsPublisher::getSnapshot() {
+    MetricsRegistry & registry = MetricsRegistry::getInstance();
+    registry.getGauge("log.droppedMessages").set((int64_t)Log::getNumberOfDroppedMessages());
+    registry.getGauge("timerWheel.pendingTimers").set((int64_t)TimerWheel::getInstance().getNumberOfPendingTimers());
+    return registry.getSnapshot();
+}
+
+void MetricsPublisher::publish(const std::string & configId, const std::string & snapshot) {
+    _pOutTypeBuffer->QueueNewMessage(MqttData(TopicPrefix + configId + TopicSuffix, snapshot));
+}
+
+void MetricsPublisher::handleNewInput(const MqttData & inputData) {
+    const std::string & topic = inputData.getTopic();
+    const std::size_t affixesSize = TopicPrefix.size() + TopicSuffix.size() + GetSuffix.size();
+    if (topic.size() <= affixesSize) {
+        return;
+    }
+    publish(topic.substr(TopicPrefix.size(), topic.size() - affixesSize), getSnapshot());
+}
@@ -0,0 +1,99 @@
+#include "mosquittoTransport.h"
+
+#include <utility>
+#include "mosquittoToMqttData.h"
+#include "log.h"
+
+#define LOG_MQTT_ERROR(...) LOG_SUBSYSTEM_ERROR(Log::Mqtt, __VA_ARGS__)
+#define LOG_MQTT_WARNING(...) LOG_SUBSYSTEM_WARNING(Log::Mqtt, __VA_ARGS__)
+#define LOG_MQTT_INFO(...)  LOG_SUBSYSTEM_INFO(Log::Mqtt, __VA_ARGS__)
+
+MosquittoTransport::MosquittoTransport(std::string ip, const int port, const std::string & mqttId)
+    : mosquittopp(mqttId.data())
+    , _ip(std::move(ip))
+    , _port(port) {
+}
+
+MosquittoTransport::~MosquittoTransport() {
+    stopThreadedLoop();
+}
+
+bool MosquittoTransport::connect() {
+    LOG_MQTT_INFO("Setup connection at " + _ip);
+    const int connRet = mosquittopp::connect(_ip.data(), _port);
+    if (connRet != MOSQ_ERR_SUCCESS) {
+        LOG_MQTT_ERROR("failed to connect to MQTT server: " + std::string(mosqpp::strerror(connRet)));
+        return false;
+    }
+    return true;
+}
+
+void MosquittoTransport::disconnect() {
+    mosquittopp::disconnect();
+}
+
+bool MosquittoTransport::subscribe(const std::string & subscription) {
+    const int subRet = mosquittopp::subscribe(0, subscription.data());
+    if (subRet != MOSQ_ERR_SUCCESS) {
+        LOG_MQTT_WARNING("MQTT subscribe failed " + subscription + ": " + std::string(mosqpp::strerror(subRet)));
+        return false;
+    }
+    return true;
+}
+
+bool MosquittoTransport::publish(const MqttData & data) {
+    const std::string & topic = data.getTopic();
+    const std::string & payload = data.getPayload();
+    const int publishRet = mosquittopp::publish(0, topic.data(), payload.size(), payload.data(), 0, false);
+    if (publishRet != MOSQ_ERR_SUCCESS) {
+        LOG_MQTT_WARNING("MQTT publish failed: " + std::string(mosqpp::strerror(publishRet)));
+        return false;
+    }
+    return true;
+}
+
+bool MosquittoTransport::loop() {
+    return mosquittopp::loop() == MOSQ_ERR_SUCCESS;
+}
+
+bool MosquittoTransport::startThreadedLoop() {
+    const int loopRet = loop_start();
+    if (loopRet != MOSQ_ERR_SUCCESS) {
+        LOG_MQTT_WARNING("MQTT failed to start threaded loop: " + std::string(mosqpp::strerror(loopRet)));
+        return false;
+    }
+    LOG_MQTT_INFO("Mqtt started threaded loop");
+    _threadedLoopStarted = true;
+    return true;
+}
+
+void MosquittoTransport::stopThreadedLoop() {
+    if (_threadedLoopStarted) {
+        loop_stop(true);
+        _threadedLoopStarted = false;
+    }
+}
+
+void MosquittoTransport::on_message(const struct mosquitto_message *msg) {
+    if (_messageHandler) {
+        _messageHandler(MosquittoToMqttDataConverter::CreateMqttData(msg));
+    }
+}
+
+void MosquittoTransport::on_connect(int rc) {
+    if (rc != MOSQ_ERR_SUCCESS) {
+        LOG_MQTT_WARNING("MQTT on connect failed: " + std::string(mosqpp::strerror(rc)));
+    }
+    if (_connectionHandler) {
+        _connectionHandler(true);
+    }
+}
+
+void MosquittoTransport::on_disconnect(int rc) {
+    if (rc != MOSQ_ERR_SUCCESS) {
+        LOG_MQTT_WARNING("MQTT on disconnect failed: " + std::string(mosqpp::strerror(rc)));
+    }
+    if (_connectionHandler) {
+        _connectionHandler(false);
+    }
+}
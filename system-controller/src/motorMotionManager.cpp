@@ -1,82 +1,72 @@
 
 #include "motorMotionManager.h"
+#include <utility>
 
 
 void MotorMotionManager::MotorMotionManager::updateMotionData(MotorStatusData data){
-    
+    bool isStatusChanged = false;
+    bool isCalibrated = false;
     if ( data.getStatus() != _lastMotorStatus) {
         _lastMotorStatus = data.getStatus();
-        for (auto & handler: _onMotorStatusUpdateHandlers) {
-            handler.second(_lastMotorStatus);    
-        }
+        isStatusChanged = true;
     }
     // only call onCalibrated when stroke is already returned 
     if ( data.isCalibrated && !_lastCalibratedStatus && getStroke() > 0) {
         _lastCalibratedStatus = data.isCalibrated; 
-        for (auto & handler : _onMotorCalibratedHandlers) {
-            handler.second();
-        }
+        isCalibrated = true;
     }
     // only reset when it was set before 
     if ( !data.isCalibrated && _lastCalibratedStatus) {
         _lastCalibratedStatus = data.isCalibrated; 
     }
-    
-    for (auto & handler: _onPositionUpdateHandlers) {
-        handler.second(data.posMm);  
+
+    const MotorStatus status = data.getStatus();
+    const int posMm = data.posMm;
+    auto strand = std::atomic_load(&_callbackStrand);
+    if (strand) {
+        strand->post([this, status, posMm, isStatusChanged, isCalibrated]() {notifyHandlers(status, posMm, isStatusChanged, isCalibrated);});
+    } else {
+        notifyHandlers(status, posMm, isStatusChanged, isCalibrated);
     }
 }
 
+void MotorMotionManager::notifyHandlers(MotorStatus status, int posMm, bool isStatusChanged, bool isCalibrated) {
+    std::lock_guard<std::recursive_mutex> lock(_handlersMutex);
+    if (isStatusChanged) {
+        _onMotorStatusUpdateHandlers(status);
+    }
+    if (isCalibrated) {
+        _onMotorCalibratedHandlers();
+    }
+    _onPositionUpdateHandlers(posMm);
+}
+
 int MotorMotionManager::addOnPositionUpdatehandler(std::function<void(int)> onPositionUpdatehandler) {
-    int id=-1;
-    int counter =1;
-    do {
-        counter++;
-        id = counter;
-        for (auto const& x : _onPositionUpdateHandlers)
-        {
-            if ( id == x.first) {
-                id = -1; 
-                break;
-            }        
-        }
-    } while (id < 0); // do until new unique id is found
-    _onPositionUpdateHandlers.insert(std::pair<int,std::function<void(int)>>(id,onPositionUpdatehandler));
-    return id;
+    std::lock_guard<std::recursive_mutex> lock(_handlersMutex);
+    return _onPositionUpdateHandlers.add(std::move(onPositionUpdatehandler));
 }
 
- int MotorMotionManager::addOnMotorStatusUpdatehandler(std::function<void(MotorStatus)> onMotorStatusUpdatehandler) {
-    int id=-1;
-    int counter =1;
-    do {
-        counter++;
-        id = counter;
-        for (auto const& x : _onMotorStatusUpdateHandlers)
-        {
-            if ( id == x.first) {
-                id = -1; 
-                break;
-            }        
-        }
-    } while (id < 0); // do until new unique id is found
-    _onMotorStatusUpdateHandlers.insert(std::pair<int,std::function<void(MotorStatus)>>(id,onMotorStatusUpdatehandler));
-    return id;
- }
+int MotorMotionManager::addOnMotorStatusUpdatehandler(std::function<void(MotorStatus)> onMotorStatusUpdatehandler) {
+    std::lock_guard<std::recursive_mutex> lock(_handlersMutex);
+    return _onMotorStatusUpdateHandlers.add(std::move(onMotorStatusUpdatehandler));
+}
 
- int MotorMotionManager::addOnMotorCalibratedhandler(std::function<void(void)> onMotorCalibratedhandler)  {
-    int id=-1;
-    int counter =1;
-    do {
-        counter++;
-        id = counter;
-        for (auto const& x : _onMotorCalibratedHandlers)
-        {
-            if ( id == x.first) {
-                id = -1; 
-                break;
-            }        
-        }
-    } while (id < 0); // do until new unique id is found
-    _onMotorCalibratedHandlers.insert(std::pair<int,std::function<void(void)>>(id,onMotorCalibratedhandler));
-    return id;
- }
\ No newline at end of file
+int MotorMotionManager::addOnMotorCalibratedhandler(std::function<void(void)> onMotorCalibratedhandler)  {
+    std::lock_guard<std::recursive_mutex> lock(_handlersMutex);
+    return _onMotorCalibratedHandlers.add(std::move(onMotorCalibratedhandler));
+}
+
+void MotorMotionManager::removeOnPositionUpdatehandler(int handlerId) {
+    std::lock_guard<std::recursive_mutex> lock(_handlersMutex);
+    _onPositionUpdateHandlers.remove(handlerId);
+}
+
+void MotorMotionManager::removeOnMotorStatusUpdatehandler(int handlerId) {
+    std::lock_guard<std::recursive_mutex> lock(_handlersMutex);
+    _onMotorStatusUpdateHandlers.remove(handlerId);
+}
+
+void MotorMotionManager::removeOnMotorCalibratedhandler(int handlerId) {
+    std::lock_guard<std::recursive_mutex> lock(_handlersMutex);
+    _onMotorCalibratedHandlers.remove(handlerId);
+}
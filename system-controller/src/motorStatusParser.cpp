@@ -0,0 +1,137 @@
+#include "motorStatusParser.h"
+
+#include <cstring>
+
+namespace {
+
+    bool isWhitespace(const char c) {
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+    }
+
+    // integer field, a decimal part is ignored (like std::stoi did)
+    bool parseInt(const char * begin, const char * end, int & value) {
+        bool negative = false;
+        if (begin != end && (*begin == '-' || *begin == '+')) {
+            negative = (*begin == '-');
+            ++begin;
+        }
+        if (begin == end || *begin < '0' || *begin > '9') {
+            return false;
+        }
+        long long result = 0;
+        for (; begin != end && *begin >= '0' && *begin <= '9'; ++begin) {
+            result = result * 10 + (*begin - '0');
+            if (result > std::numeric_limits<int>::max()) {
+                return false;
+            }
+        }
+        if (begin != end) {
+            if (*begin != '.') {
+                return false;
+            }
+            for (++begin; begin != end; ++begin) {
+                if (*begin < '0' || *begin > '9') {
+                    return false;
+                }
+            }
+        }
+        value = (int)(negative ? -result : result);
+        return true;
+    }
+
+    // expect exactly "true" or "false" -> fixed api, not case sensitive
+    bool parseBool(const char * begin, const char * end, bool & value) {
+        const std::size_t length = end - begin;
+        if (length == 4 && std::memcmp(begin, "true", 4) == 0) {
+            value = true;
+            return true;
+        }
+        if (length == 5 && std::memcmp(begin, "false", 5) == 0) {
+            value = false;
+            return true;
+        }
+        return false;
+    }
+
+    // button fields are reported as a number or as a bool depending on the firmware
+    bool parseButton(const char * begin, const char * end, int & value) {
+        bool pressed = false;
+        if (parseBool(begin, end, pressed)) {
+            value = pressed ? 1 : 0;
+            return true;
+        }
+        return parseInt(begin, end, value);
+    }
+
+    // posMm, posPerc, VelMM, LockState, IsOpen, IsClosed, Temp, Current, button 0-2, bool-button 0-1, calibrated, emergency run
+    bool parseField(const int index, const char * begin, const char * end, MotorStatusData & status) {
+        switch (index) {
+            case 0: return parseInt(begin, end, status.posMm);
+            // informational fields are best effort, they never reject the status
+            case 1: parseInt(begin, end, status.posPerc); return true;
+            case 2: return parseInt(begin, end, status.speedMm);
+            case 3: return parseBool(begin, end, status.isLocked);
+            case 4: return parseBool(begin, end, status.isOpen);
+            case 5: return parseBool(begin, end, status.isClosed);
+            case 6: parseInt(begin, end, status.temperature); return true;
+            case 7: parseInt(begin, end, status.current); return true;
+            case 8:
+            case 9:
+            case 10: parseButton(begin, end, status.buttons[index - 8]); return true;
+            case 11:
+            case 12: parseBool(begin, end, status.boolButtons[index - 11]); return true;
+            case 13: return parseBool(begin, end, status.isCalibrated);
+            case 14: return parseBool(begin, end, status.isEmergencyRun);
+            default: return true; // fields added later in the api are ignored
+        }
+    }
+}
+
+bool MotorStatusParser::parse(const char * payload, std::size_t length, MotorStatusData & status) {
+    static const char key[] = "\"results\"";
+    const std::size_t keyLength = sizeof(key) - 1;
+    const char * end = payload + length;
+
+    // find the key
+    const char * p = payload;
+    for (;; ++p) {
+        if (p + keyLength > end) {
+            return false;
+        }
+        if (std::memcmp(p, key, keyLength) == 0) {
+            break;
+        }
+    }
+    p += keyLength;
+    while (p != end && isWhitespace(*p)) { ++p;}
+    if (p == end || *p != ':') { return false;}
+    ++p;
+    while (p != end && isWhitespace(*p)) { ++p;}
+    if (p == end || *p != '"') { return false;}
+    ++p;
+
+    // split the string value on ',' and parse each field, also the last one before the closing quote
+    MotorStatusData parsed = status;
+    int index = 0;
+    const char * fieldBegin = p;
+    for (; p != end; ++p) {
+        if (*p == '\\') {
+            return false; // escapes are not part of the api
+        }
+        if (*p == ',' || *p == '"') {
+            if (!parseField(index, fieldBegin, p, parsed)) {
+                return false;
+            }
+            index++;
+            fieldBegin = p + 1;
+            if (*p == '"') {
+                break;
+            }
+        }
+    }
+    if (p == end || index < 6) {
+        return false; // no closing quote or not even the basic fields
+    }
+    status = parsed;
+    return true;
+}
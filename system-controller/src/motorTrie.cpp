@@ -0,0 +1,60 @@
+#include "motorTrie.h"
+
+MotorTrie::MotorTrie() : _nodes(1) {
+}
+
+MotorTrie::MotorTrie(const std::map<std::string, std::shared_ptr<IMqttMotor>> & motors) {
+    // the keys of the map are sorted, all keys with the same prefix are next to each other
+    Keys keys;
+    for (auto & m : motors) {
+        keys.push_back(std::make_pair(m.first, m.second.get()));
+    }
+    _size = keys.size();
+    build(keys, 0, keys.size(), 0);
+}
+
+// builds the node for the keys [begin,end) that share the first 'depth' characters
+// the edges of one node are stored next to each other
+std::uint32_t MotorTrie::build(const Keys & keys, std::size_t begin, std::size_t end, std::size_t depth) {
+    const std::uint32_t nodeIndex = _nodes.size();
+    _nodes.push_back(Node());
+    if (begin < end && keys[begin].first.size() == depth) {
+        _nodes[nodeIndex].motor = keys[begin].second;
+        begin++;
+    }
+    // reserve the edges of this node first, the children add their edges after them
+    std::vector<std::size_t> groupBegins;
+    for (std::size_t i = begin; i < end; ++i) {
+        if (i == begin || keys[i].first[depth] != keys[i - 1].first[depth]) {
+            groupBegins.push_back(i);
+        }
+    }
+    _nodes[nodeIndex].firstEdge = _edges.size();
+    _nodes[nodeIndex].edgeCount = groupBegins.size();
+    for (auto groupBegin : groupBegins) {
+        _edges.push_back(Edge{keys[groupBegin].first[depth], 0});
+    }
+    for (std::size_t g = 0; g < groupBegins.size(); ++g) {
+        const std::size_t groupEnd = (g + 1 < groupBegins.size()) ? groupBegins[g + 1] : end;
+        const std::uint32_t child = build(keys, groupBegins[g], groupEnd, depth + 1);
+        _edges[_nodes[nodeIndex].firstEdge + g].child = child;
+    }
+    return nodeIndex;
+}
+
+IMqttMotor * MotorTrie::find(const StringSpan & id) const {
+    std::uint32_t node = 0;
+    for (const char c : id) {
+        const Node & current = _nodes[node];
+        const Edge * edge = _edges.data() + current.firstEdge;
+        const Edge * lastEdge = edge + current.edgeCount;
+        while (edge != lastEdge && edge->c != c) {
+            ++edge;
+        }
+        if (edge == lastEdge) {
+            return nullptr;
+        }
+        node = edge->child;
+    }
+    return _nodes[node].motor;
+}
@@ -9,12 +9,15 @@ MotorizedWindow::MotorizedWindow(  int length, std::shared_ptr<IMotorMotionManag
     {
        
          // set position update handler 
-        this->_motionManager->addOnPositionUpdatehandler([&](int pos) {onPositionUpdate(pos);});
+        _positionHandlerId = this->_motionManager->addOnPositionUpdatehandler([&](int pos) {onPositionUpdate(pos);});
     }
 
+MotorizedWindow::~MotorizedWindow() {
+    _motionManager->removeOnPositionUpdatehandler(_positionHandlerId);
+}
+
 void MotorizedWindow::stopWindow() {
-    for ( auto  & slaveInfo : _slaves ) {
-        auto slave = std::get<0>(slaveInfo);
+    for ( auto & slave : _slaveWindows ) {
         slave->stopWindow();
     }    
     push(PushType::Stop);
@@ -53,19 +56,16 @@ void MotorizedWindow::clearCalibration() {
 
 std::vector<std::shared_ptr<MotorizedWindow>> MotorizedWindow::getSlaveMotors() const {
     std::vector<std::shared_ptr<MotorizedWindow>> motors;
-      for (auto & s : getSlaves()){        
-        if (auto item = std::dynamic_pointer_cast<MotorizedWindow>(s)) {
-            motors.push_back(item);
-        } 
-        getMotorsRecursive(motors,s);
-    }
+    getMotorsRecursive(motors, *this);
     return motors;
 }
-void MotorizedWindow::getMotorsRecursive(std::vector<std::shared_ptr<MotorizedWindow>> & motors, std::shared_ptr<IMovingWindow> curr) const{
-    for (auto & s : curr->getSlaves()){        
-        if (auto item = std::dynamic_pointer_cast<MotorizedWindow>(s)) {
-            motors.push_back(item);
-        } 
-        getMotorsRecursive(motors,s);
+void MotorizedWindow::getMotorsRecursive(std::vector<std::shared_ptr<MotorizedWindow>> & motors, const IMovingWindow & curr) {
+    const auto & slaves = curr.getSlaves();
+    const auto & slaveTypes = curr.getSlaveTypes();
+    for (std::size_t i = 0; i < slaves.size(); ++i) {
+        if (slaveTypes[i] == SlaveType::Motor) {
+            motors.push_back(std::static_pointer_cast<MotorizedWindow>(slaves[i]));
+        }
+        getMotorsRecursive(motors, *slaves[i]);
     }
 }
@@ -1,24 +1,60 @@
 #include "motorsHandler.h"
 #include "log.h"
 
-MotorsHandler::MotorsHandler() : TopicHandler({"rbus/#"}) {
-
+MotorsHandler::MotorsHandler(std::size_t numberOfShards) : TopicHandler({"rbus/#"}, numberOfShards) {
+    _motorTries.push_back(std::unique_ptr<const MotorTrie>(new MotorTrie()));
+    _motorTrie.store(_motorTries.back().get());
+}
+MotorsHandler::~MotorsHandler() {
+    if (_running) {
+        TopicHandler::stop();
+    }
 }
 // add a motor to the list to be hanlded with from MQTT
 void MotorsHandler::addMotor(const std::shared_ptr<IMqttMotor>& mqttMotor){
     LOG_TRACE("Added new motor to motorshandler " + mqttMotor->getId());
-    std::lock_guard<std::mutex> guard(_motorsMap_mutex);
-    _motors.insert(std::pair<std::string,std::shared_ptr<IMqttMotor>>(mqttMotor->getId(),mqttMotor));
-    mqttMotor->setDelegateMotorOutput([&](const MqttData & data) {handleOutput(data);});
+    {
+        std::lock_guard<std::mutex> guard(_motorsMap_mutex);
+        _motors.insert(std::pair<std::string,std::shared_ptr<IMqttMotor>>(mqttMotor->getId(),mqttMotor));
+        mqttMotor->setDelegateMotorOutput([&](const MqttData & data) {handleOutput(data);});
+        publishMotorTrie();
+    }
+    if (_running) {
+        mqttMotor->onMotorConnected();
+    }
+}
+
+void MotorsHandler::removeMotor(const std::string & motorId) {
+    std::shared_ptr<IMqttMotor> motor;
+    {
+        std::lock_guard<std::mutex> guard(_motorsMap_mutex);
+        auto m = _motors.find(motorId);
+        if (m == _motors.end()) {
+            LOG_WARNING("Motorshandler has no motor " + motorId + " to remove");
+            return;
+        }
+        motor = m->second;
+        _removedMotors.push_back(motor);
+        _motors.erase(m);
+        publishMotorTrie();
+    }
+    LOG_TRACE("Removed motor from motorshandler " + motorId);
+    motor->onMotorDisconnected();
+}
+
+// call with the motors map locked
+void MotorsHandler::publishMotorTrie() {
+    _motorTries.push_back(std::unique_ptr<const MotorTrie>(new MotorTrie(_motors)));
+    _motorTrie.store(_motorTries.back().get(), std::memory_order_release);
 }
 
 void MotorsHandler::handleNewInput ( const MqttData & inputData) {
     
     //LOG_DEBUG("New Input for motor: " + inputData.getTopic() + "[" + inputData.getPayload() + "]");
-    std::lock_guard<std::mutex> guard(_motorsMap_mutex);
-    auto motorData = MotorData(inputData);
-    if(_motors.find(motorData.getId()) != _motors.end()) {
-        _motors[motorData.getId()]->onMotorInput(inputData);
+    const MotorData motorData(inputData);
+    IMqttMotor * motor = _motorTrie.load(std::memory_order_acquire)->find(motorData.getIdSpan());
+    if(motor != nullptr) {
+        motor->onMotorInput(motorData);
     }        
 }
 
@@ -15,19 +15,18 @@ MovingWindow::MovingWindow(int length, std::shared_ptr<IMotorMotionManager> moto
 
 void MovingWindow::addSlave(std::shared_ptr<IMovingWindow> slave, SlaveType slaveType) {
     // todo add some checking on double insertion or other mistakes
-    _slaves.push_back(std::make_tuple(slave,slaveType));
-}
-std::vector<std::shared_ptr<IMovingWindow>> MovingWindow::getSlaves() const {
-    std::vector<std::shared_ptr<IMovingWindow>> slaveWindows;
-    for ( auto  & slaveInfo : _slaves ) {
-        slaveWindows.push_back(std::get<0>(slaveInfo));
+    std::static_pointer_cast<MovingWindow>(slave)->_master = this;
+    _slaveWindows.push_back(std::move(slave));
+    _slaveTypes.push_back(slaveType);
+    // the wing of the master window compiles its panel chain again
+    for (MovingWindow * w = this; w != nullptr; w = w->_master) {
+        w->_structureVersion++;
     }
-    return slaveWindows;
 }
 void MovingWindow::getSlaveTypesTree(std::vector<SlaveType> & slaveTypesTree) {
-    for ( auto  & slaveInfo : _slaves ) {
-        slaveTypesTree.push_back(std::get<1>(slaveInfo));
-        std::get<0>(slaveInfo)->getSlaveTypesTree(slaveTypesTree);
+    for (std::size_t i = 0; i < _slaveWindows.size(); ++i) {
+        slaveTypesTree.push_back(_slaveTypes[i]);
+        _slaveWindows[i]->getSlaveTypesTree(slaveTypesTree);
     }
 }
 void MovingWindow::onPositionUpdate(int newPosition) {
@@ -43,8 +42,7 @@ void MovingWindow::onPositionUpdate(int newPosition) {
     }
 }
 void MovingWindow::stopWindow() {
-     for ( auto  & slaveInfo : _slaves ) {
-        auto slave = std::get<0>(slaveInfo);
+     for ( auto & slave : _slaveWindows ) {
         slave->stopWindow();
     }    
     _pushType = PushType::Stop;
@@ -59,17 +57,31 @@ MovementFreedom MovingWindow::GetLeastAllowedMovement (MovementFreedom  m1 , Mov
     return MovementFreedom::Slow;
 }
 
-void MovingWindow::handleSlaveOnPushOpen(MovementFreedom & allowedMovement, const std::shared_ptr<IMovingWindow>& slave, SlaveType slaveType) {
+const MovingWindow::PushThresholds & MovingWindow::getThresholds() {
+    const SystemSettingsSnapshot * settings = SystemSettings::getSnapshot();
+    if (settings != _thresholds.settings || _length != _thresholds.length) {
+        _thresholds.settings = settings;
+        _thresholds.length = _length;
+        _thresholds.openChicanZone = settings->chicanZone - _length;
+        _thresholds.openChicanOverlap = settings->chicanOverlap - _length;
+        _thresholds.chicanZone = settings->chicanZone;
+        _thresholds.chicanOverlap = settings->chicanOverlap;
+        _thresholds.slowdownDist = settings->slowdownDist;
+    }
+    return _thresholds;
+}
+
+void MovingWindow::handleSlaveOnPushOpen(MovementFreedom & allowedMovement, const PushThresholds & thresholds, const std::shared_ptr<IMovingWindow>& slave, SlaveType slaveType) {
     allowedMovement = GetLeastAllowedMovement(allowedMovement ,slave->getMovementFreedom());
 
     if (slaveType == SlaveType::Passive || slaveType == SlaveType::Motor )  {
         int passedOwnLength = _position - _length;
         if ( slaveType == SlaveType::Motor) { 
-           //LOG_DEBUG(std::to_string(passedOwnLength) + " " + std::to_string(slave->getPosition()) + "  " + std::to_string(_position));
-            if ( (passedOwnLength  + SystemSettings::getInstance().getChicanZone()) > slave->getPosition() ) {
+            const int slavePosition = slave->getPosition();
+            if ( (_position + thresholds.openChicanZone) > slavePosition ) {
                 std::static_pointer_cast<MotorizedWindow>(slave)->push(PushType::PushToOpen);
                 
-                if ( (passedOwnLength  + SystemSettings::getInstance().getChicanOverlap()) > slave->getPosition() ) {                   
+                if ( (_position + thresholds.openChicanOverlap) > slavePosition ) {                   
                     
                     // when on the end of the stroke the master slave can fully open 
                     if ( slave->getMotionManager()->getMotorStatusData().getStatus() != MotorStatus::Open) {
@@ -78,14 +90,14 @@ void MovingWindow::handleSlaveOnPushOpen(MovementFreedom & allowedMovement, cons
                 }
             }   
             // check that slave is not pushed to far (if so hold the slave motor!)
-            if ( _position - slave->getPosition() < SystemSettings::getInstance().getChicanZone() ) {                
+            if ( _position - slavePosition < thresholds.chicanZone ) {                
                 std::static_pointer_cast<MotorizedWindow>(slave)->push(PushType::Stop);
             }    
         } else if ( slaveType == SlaveType::Passive) {
             std::static_pointer_cast<MotorizedWindow>(slave)->push(PushType::PushToOpen);
             auto lastStandStillPosition = std::static_pointer_cast<PassiveWindow>(slave)->getLastStandStillPosition();
-            if (std::abs (passedOwnLength - lastStandStillPosition) < SystemSettings::getInstance().getSlowdownDist()) {
-                LOG_TRACE("Slow opening due passed own Length " + std::to_string(passedOwnLength) + " At last standstill "  +  std::to_string(lastStandStillPosition));
+            if (std::abs (passedOwnLength - lastStandStillPosition) < thresholds.slowdownDist) {
+                LOG_SUBSYSTEM_TRACE(Log::Wing, "Slow opening due passed own Length {} At last standstill {}", passedOwnLength, lastStandStillPosition);
                 allowedMovement = GetLeastAllowedMovement(allowedMovement ,MovementFreedom::Slow);
             } else {
                 allowedMovement = GetLeastAllowedMovement(allowedMovement ,MovementFreedom::Fast);
@@ -106,31 +118,32 @@ void MovingWindow::handleSlaveOnPushOpen(MovementFreedom & allowedMovement, cons
     }
 }
 
-void MovingWindow::handleSlaveOnPullClose(MovementFreedom& allowedMovement, std::shared_ptr<IMovingWindow> slave, SlaveType slaveType)
+void MovingWindow::handleSlaveOnPullClose(MovementFreedom& allowedMovement, const PushThresholds & thresholds, const std::shared_ptr<IMovingWindow>& slave, SlaveType slaveType)
 {
     allowedMovement = GetLeastAllowedMovement(allowedMovement, slave->getMovementFreedom());
     if (slaveType == SlaveType::Motor) {
-        if ((_position - SystemSettings::getInstance().getChicanZone()) < slave->getPosition()) {
+        const int slavePosition = slave->getPosition();
+        if ((_position - thresholds.chicanZone) < slavePosition) {
             std::static_pointer_cast<MotorizedWindow>(slave)->push(PushType::PushToClose);
-            if ((_position - SystemSettings::getInstance().getChicanOverlap()) < slave->getPosition()) {
+            if ((_position - thresholds.chicanOverlap) < slavePosition) {
                 if (slave->getMotionManager()->getMotorStatusData().getStatus() != MotorStatus::Closed) { // when on the end of the stroke the master slave can close fully
-                    if (slave->getPosition() > 10) {
-                        LOG_DEBUG(_motionManager->getId() + " failed complete close @ " + std::to_string((int)slave->getMotionManager()->getMotorStatusData().getStatus()) + std::to_string(getPosition()))
+                    if (slavePosition > 10) {
+                        LOG_SUBSYSTEM_DEBUG(Log::Wing, "{} failed complete close @ {}{}", _motionManager->getId(), (int)slave->getMotionManager()->getMotorStatusData().getStatus(), getPosition())
                         allowedMovement = MovementFreedom::None;
                     }
                 }
             }
         }
         //check that slave is not closed to far (if so hold the slave motor!)
-        if ((slave->getPosition() + slave->getLength() - _position) < SystemSettings::getInstance().getChicanZone()) {
+        if ((slavePosition + slave->getLength() - _position) < thresholds.chicanZone) {
             std::static_pointer_cast<MotorizedWindow>(slave)->push(PushType::Stop);
         }
     } else if (slaveType == SlaveType::Passive) {
         std::static_pointer_cast<MotorizedWindow>(slave)->push(PushType::PushToClose);
         auto lastStandStillPosition = std::static_pointer_cast<PassiveWindow>(slave)->getLastStandStillPosition();
-        if (std::abs(_position - lastStandStillPosition) < SystemSettings::getInstance().getSlowdownDist()) {
+        if (std::abs(_position - lastStandStillPosition) < thresholds.slowdownDist) {
             allowedMovement = GetLeastAllowedMovement(allowedMovement, MovementFreedom::Slow);
-            LOG_TRACE("Slow closing due position " + std::to_string(_position) + " At last standstill " + std::to_string(lastStandStillPosition));
+            LOG_SUBSYSTEM_TRACE(Log::Wing, "Slow closing due position {} At last standstill {}", _position, lastStandStillPosition);
         } else {
             allowedMovement = GetLeastAllowedMovement(allowedMovement, MovementFreedom::Fast);
         }
@@ -152,20 +165,23 @@ void MovingWindow::handleSlaveOnPullClose(MovementFreedom& allowedMovement, std:
 void MovingWindow::pushSlavesToAllowMovement() {
    
     MovementFreedom allowedMovement=MovementFreedom::Fast;
+    // one snapshot of the settings for all slaves
+    const PushThresholds & thresholds = getThresholds();
        
-    for ( auto  & slaveInfo : _slaves ) {
-        auto slave = std::get<0>(slaveInfo);
+    for (std::size_t i = 0; i < _slaveWindows.size(); ++i) {
+        const auto & slave = _slaveWindows[i];
+        const SlaveType slaveType = _slaveTypes[i];
         // always update the slaves with there current position
-        if (  std::get<1>(slaveInfo) == SlaveType::Passive ) {
+        if ( slaveType == SlaveType::Passive ) {
             std::static_pointer_cast<PassiveWindow>(slave)->updateWithCurrentPosition();
         }
 
         switch (_pushType) {
             case PushType::PushToOpen:                  
-                handleSlaveOnPushOpen(allowedMovement,slave, std::get<1>(slaveInfo));
+                handleSlaveOnPushOpen(allowedMovement, thresholds, slave, slaveType);
                 break;
             case PushType::PushToClose:
-                handleSlaveOnPullClose(allowedMovement, slave, std::get<1>(slaveInfo));
+                handleSlaveOnPullClose(allowedMovement, thresholds, slave, slaveType);
                 break;
             case PushType::ForceOpenForCalibration:
                 std::static_pointer_cast<MotorizedWindow>(slave)->push(PushType::ForceOpenForCalibration);
@@ -205,7 +221,7 @@ void MovingWindow::updateAllPanelLenghts(int newPanelLength) {
         LOG_DEBUG("Update panelLength -> " +  std::to_string(newPanelLength));
         _length = newPanelLength;
     }
-    for ( auto & s : getSlaves()) {
+    for ( auto & s : _slaveWindows) {
         s->updateAllPanelLenghts(newPanelLength);
     }
 }
\ No newline at end of file
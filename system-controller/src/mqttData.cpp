@@ -3,8 +3,11 @@
 #include <utility>
 
 MqttData::MqttData(const std::string & topic , const std::string & payload)  
-    : _topic(topic)
-    , _payload(payload) {
+    : MqttData(topic.data(), topic.size(), payload.data(), payload.size()) {
+}
+MqttData::MqttData(const char * topic, std::size_t topicLength, const char * payload, std::size_t payloadLength)
+    : _topic(SharedText::intern(topic, topicLength))
+    , _payload(SharedText::copyOf(payload, payloadLength)) {
 }
 MqttData::MqttData(const std::string & topic) : MqttData ( topic, "")  {
 }
@@ -20,7 +23,7 @@ MqttData::MqttData(const std::string & topic , int parameterValue, const std::st
 
 rapidjson::Document MqttData::getParsedJsonDoc() const {
     rapidjson::Document doc;
-    doc.Parse(_payload.data());
+    doc.Parse(getPayload().data());
     if (doc.HasParseError()) {
         throw std::runtime_error("invalid JSON found :" + getPayload());
     }
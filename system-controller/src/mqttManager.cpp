@@ -1,36 +1,43 @@
 #include "mqttManager.h"
 
 #include <utility>
+#include "mosquittoTransport.h"
 #include "log.h"
 
+#define LOG_MQTT_DEBUG(...) LOG_SUBSYSTEM_DEBUG(Log::Mqtt, __VA_ARGS__)
+#define LOG_MQTT_INFO(...)  LOG_SUBSYSTEM_INFO(Log::Mqtt, __VA_ARGS__)
+#define LOG_MQTT_TRACE(...) LOG_SUBSYSTEM_TRACE(Log::Mqtt, __VA_ARGS__)
+
 MqttManager::MqttManager(std::string ip, const int port, const std::string &mqttId, std::vector<std::shared_ptr <TopicHandler>> topicHandlers)
-    : mosquittopp(mqttId.data())
+    : MqttManager(std::make_shared<MosquittoTransport>(std::move(ip), port, mqttId), std::move(topicHandlers))
+{
+}
+
+MqttManager::MqttManager(std::shared_ptr<ITransport> transport, std::vector<std::shared_ptr <TopicHandler>> topicHandlers)
+    : _transport(std::move(transport))
+    , _topicHandlers(std::move(topicHandlers))
+    , _outputNotifier(std::make_shared<BufferNotifier>())
     , m_sendingRunning(false)
     , m_readingRunning(false)
-    , m_ip(std::move(ip))
-    , m_port(port)
-    , _topicHandlers(std::move(topicHandlers))
+    , m_useThreadedLoop(false)
+    , m_threadedLoopStarted(false)
 {    
-    /* Connect to server*/
-    LOG_INFO("Setup connection at " + m_ip );
-        
-    const int connRet = this->connect(m_ip.data(), m_port);
-    if (connRet != MOSQ_ERR_SUCCESS) {
-       LOG_ERROR("failed to connect to MQTT server: " +  std::string(mosqpp::strerror(connRet)));
+    for (auto & t : _topicHandlers) {
+        t->getOutputBuffer()->SetNotifier(_outputNotifier);
     }
+    compileSubscriptions();
+    _transport->setMessageHandler([this](const MqttData & data) {onMessage(data);});
+    _transport->setConnectionHandler([this](bool connected) {onConnectionChanged(connected);});
+    /* Connect to server*/
+    _transport->connect();
 }
 
 MqttManager::~MqttManager() {
-    LOG_DEBUG("Destruct mqttManager" );
+    LOG_MQTT_DEBUG("Destruct mqttManager" );
     stop();
-}
-
-void LogStatus(const std::string& successMsg, const std::string& failMsg, int rc) {
-    if (rc != MOSQ_ERR_SUCCESS) {                
-        LOG_WARNING (failMsg + ": " +std::string(mosqpp::strerror(rc)));
-    }
-    if ( !successMsg.empty())
-        LOG_INFO(successMsg);
+    // the transport can outlive the manager
+    _transport->setMessageHandler(ITransport::MessageHandler());
+    _transport->setConnectionHandler(ITransport::ConnectionHandler());
 }
 
 void MqttManager::addTopicHandler(std::shared_ptr<TopicHandler> topicHandler){    
@@ -39,24 +46,55 @@ void MqttManager::addTopicHandler(std::shared_ptr<TopicHandler> topicHandler){
         LOG_CRITICAL_THROW("MqttManager can not add a topichandler while running!");
     }
 
+    topicHandler->getOutputBuffer()->SetNotifier(_outputNotifier);
     _topicHandlers.push_back(topicHandler);
+    compileSubscriptions();
+}
+
+void MqttManager::compileSubscriptions() {
+    _subscriptions.clear();
+    for (std::size_t i = 0; i < _topicHandlers.size(); ++i) {
+        for (auto & s : _topicHandlers[i]->getSubscribeStrs()) {
+            _subscriptions.add(s, i);
+        }
+    }
+}
+
+void MqttManager::setUseThreadedLoop(const bool useThreadedLoop) {
+    if (m_sendingRunning || m_readingRunning) {
+        LOG_CRITICAL_THROW("MqttManager can not change the loop mode while running!");
+    }
+    m_useThreadedLoop = useThreadedLoop;
+}
+
+void MqttManager::setFlushWindow(const std::chrono::milliseconds flushWindow) {
+    if (m_sendingRunning || m_readingRunning) {
+        LOG_CRITICAL_THROW("MqttManager can not change the flush window while running!");
+    }
+    _flushWindow = flushWindow;
 }
 
 void MqttManager::start() {
-    LOG_DEBUG("mqttManager starting" );
+    LOG_MQTT_DEBUG("mqttManager starting" );
     setSendingRunning(true);
     m_sendingWorker = std::thread(&MqttManager::mqttSending, this);
 
     setReadingRunning(true);
-    m_readingWorker = std::thread(&MqttManager::mqttReading, this);
-
-   
+    if (m_useThreadedLoop) {
+        for ( auto & t : _topicHandlers) {
+            t->start();
+        }
+        m_threadedLoopStarted = _transport->startThreadedLoop();
+    } else {
+        m_readingWorker = std::thread(&MqttManager::mqttReading, this);
+    }
 }
 
 void MqttManager::stop() {
-    LOG_DEBUG("mqttManager stopping" );
+    LOG_MQTT_DEBUG("mqttManager stopping" );
     setReadingRunning(false);
     setSendingRunning(false);
+    _outputNotifier->notify();
      for (auto &h : _topicHandlers) {
         h->stop();
     }
@@ -67,11 +105,15 @@ void MqttManager::stop() {
 
     if (m_readingWorker.joinable()) {
         m_readingWorker.join();
+    }
+    if (m_threadedLoopStarted) {
+        _transport->stopThreadedLoop();
+        m_threadedLoopStarted = false;
     }
      for ( auto & t : _topicHandlers) {
          t->stop();
     }
-    LOG_DEBUG("mqttManager stopped" );
+    LOG_MQTT_DEBUG("mqttManager stopped" );
 }
 
 void MqttManager::setReadingRunning(const bool running) {
@@ -85,32 +127,27 @@ void MqttManager::setSendingRunning(const bool running) {
 }
 
 // On a new message fill the input buffer of the correct topicHandler
-void MqttManager::on_message (const struct mosquitto_message *msg){
-    std::string msgTopic = (char *) msg->topic;    
-    const MqttData data = MosquittoToMqttDataConverter::CreateMqttData(msg);
- 
-    for ( auto & t : _topicHandlers) {
-        if(t->isTopicValidForHandling(msgTopic)) {
-            t->getInputBuffer()->QueueNewMessage(data);
-        }
+// the MqttData is shared between the topicHandlers, only the reference to the text is copied
+void MqttManager::onMessage(const MqttData & data){
+    _matchedHandlers.clear();
+    _subscriptions.match(data.getTopic(), _matchedHandlers);
+    for (auto index : _matchedHandlers) {
+        _topicHandlers[index]->queueInput(data);
     }    
 }
-void MqttManager::on_connect(int rc){
-    
-    LogStatus("MQTT on connect","MQTT on connect failed", rc);
-    setConnected(true);
-
+void MqttManager::onConnectionChanged(const bool connected){
+    setConnected(connected);
+    if (!connected) {
+        LOG_MQTT_INFO("MQTT on disconnect");
+        return;
+    }
+    LOG_MQTT_INFO("MQTT on connect");
     for ( auto & t : _topicHandlers) {
         for (auto & s : t->getSubscribeStrs()) {
-            const int subRet = this->subscribe(0, s.data());
-            LogStatus("","MQTT subscribe failed " + s, rc);
+            _transport->subscribe(s);
         }
     }    
 }
-void MqttManager::on_disconnect(int rc){
-    setConnected(false);
-    LogStatus("MQTT on disconnect","MQTT on disconnect failed", rc);
-}
 
 void MqttManager::setConnected(const bool connected)
 {    
@@ -139,67 +176,64 @@ bool MqttManager::waitForConnection(std::chrono::milliseconds timeout)
         if (isConnected()) {return true;}
         Clock::time_point t1 = Clock::now();
         if ((t1 - t0) > timeout) {return false;}
-        loop();
+        _transport->loop();
     }
 }
 
 void MqttManager::waitForDisconnection()
 {
-    LOG_DEBUG("MqttManager: waitForDisconnection");
+    LOG_MQTT_DEBUG("MqttManager: waitForDisconnection");
     m_connectedMutex.lock();
     m_connectedMutex.unlock();
-    LOG_DEBUG("MqttManager: wait on disconnect finished");
+    LOG_MQTT_DEBUG("MqttManager: wait on disconnect finished");
 }
 // keep the reading of Mqtt message alive so that the on_message will receive new messages
 void MqttManager::mqttReading()
 {
-    LOG_DEBUG("Mqtt started reading worker");
+    LOG_MQTT_DEBUG("Mqtt started reading worker");
     for ( auto & t : _topicHandlers) {
          t->start();
     }
     while (m_readingRunning) {
-        loop();
+        if (!_transport->loop()) {
+            // no connection, don't spin on the failing loop
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
     }
 }
+bool MqttManager::publishMessage(const MqttData & data)
+{
+    return _transport->publish(data);
+}
 // Sending Mqtt messages out 
-// -> the outputbuffer of each topic is checked and all messages are pushed out
+// -> wait until one of the outputbuffers signals the shared notifier, then all outputbuffers are emptied
+//    into the outbox and the outbox is flushed
 void MqttManager::mqttSending()
 {
-    LOG_DEBUG("Mqtt started sending worker");
+    LOG_MQTT_DEBUG("Mqtt started sending worker");
+    const auto publish = [this](const MqttData & data) {
+        // the transport logs a failed publish
+        publishMessage(data);
+        // only log non status messages, the topic is only searched when tracing
+        if (Log::shouldLog(Log::Mqtt, spdlog::level::trace) && std::string::npos == data.getTopic().find("get.status")) {
+            LOG_MQTT_TRACE("Published : {}", (std::string)(data));
+        }
+    };
     while (m_sendingRunning) {
+        // the timeout is only there to check the running flag, a notify given before 
+        // waiting is not lost so there is no need to handle a timeout different
+        const bool notified = _outputNotifier->waitFor(std::chrono::milliseconds(200));
+        if (notified && _flushWindow.count() > 0) {
+            std::this_thread::sleep_for(_flushWindow);
+        }
+        MqttData data;
         for ( auto & t : _topicHandlers) {
-            {
-                std::mutex mutex;
-                std::unique_lock<std::mutex> lk(mutex);
-                // wait on other thread of receiving a notify from the condition variable, timeout at 200 ms
-                const std::cv_status status
-                    = t->getOutputBuffer()->conditionVariable().wait_for(lk, std::chrono::milliseconds(200));
-                // don't handle timeout of the conditionVariable different! If the notify is missed once it should be picked up 
-                // next run. If we would skip next block of code every time a timeout occurred the system should wait until a
-                // next message is pushed on the buffer to get notified again. If a notify was missed we would never pop this message
-                // if now new message is put on the queue (triggering a new notify)
-            }
-            MqttData data;
-            std::size_t lastDataHash=0; // make sure that there is send at least one message by setting hash on zero
+            // *** No lock needed here, resource is locked on the buffer it self
             while (t->getOutputBuffer()->UnqueueMessage(data)) {
-                // *** No lock needed here, resource is locked on the buffer it self
-                std::size_t dataHash = data.getHash();
-                if ( lastDataHash != dataHash) {    // prevent sending in burst the same message multiple times
-                    lastDataHash = dataHash;
-                    const std::string& topic = data.getTopic();
-                    const std::string& payload = data.getPayload();
-
-                    const auto publishRet = publish(0, topic.data(), payload.size(), payload.data(), 0, false);
-                    // validate response and log when failed
-                    LogStatus("","MQTT publish failed", publishRet);
-                    if (std::string::npos == topic.find("get.status")) { // only log non status messages
-                        LOG_TRACE("Published : " + (std::string)(data));
-                    } 
-                } else {
-                    //LOG_TRACE("Show not send command:" + (std::string)(data));
-                }
+                _outbox.add(data);
             } 
         }
+        _outbox.flush(publish);
     }
-    LOG_DEBUG("MqttManager: Finished sending");    
+    LOG_MQTT_DEBUG("MqttManager: Finished sending ({} publishes elided)", _outbox.getElidedCount());    
 }
@@ -1,14 +1,22 @@
 
 #include "mqttMotor.h"
 #include "log.h"
+#include "pollScheduler.h"
 
-#define LOG_MOTOR_CRITICAL(...) LOG_CRITICAL("motor " + this->getId() + ":" + __VA_ARGS__);
+#define LOG_MOTOR_CRITICAL(...) LOG_SUBSYSTEM_CRITICAL(Log::Motor, "motor " + this->getId() + ":" + __VA_ARGS__)
 #define LOG_MOTOR_CRITICAL_THROW(...) LOG_CRITICAL_THROW("motor " + this->getId() + ":" + __VA_ARGS__);
-#define LOG_MOTOR_ERROR(...) LOG_ERROR("motor " + this->getId() + ":" + __VA_ARGS__);
-#define LOG_MOTOR_WARNING(...) LOG_WARNING("motor " + this->getId() + ":" + __VA_ARGS__);
-#define LOG_MOTOR_DEBUG(...) LOG_DEBUG("motor " + this->getId() + ":" + __VA_ARGS__);
-#define LOG_MOTOR_INFO(...)  LOG_INFO("motor " + this->getId() + ":" + __VA_ARGS__);
-#define LOG_MOTOR_TRACE(...) LOG_TRACE("motor " + this->getId() + ":" + __VA_ARGS__);
+#define LOG_MOTOR_ERROR(...) LOG_SUBSYSTEM_ERROR(Log::Motor, "motor " + this->getId() + ":" + __VA_ARGS__)
+#define LOG_MOTOR_WARNING(...) LOG_SUBSYSTEM_WARNING(Log::Motor, "motor " + this->getId() + ":" + __VA_ARGS__)
+#define LOG_MOTOR_DEBUG(...) LOG_SUBSYSTEM_DEBUG(Log::Motor, "motor " + this->getId() + ":" + __VA_ARGS__)
+#define LOG_MOTOR_INFO(...)  LOG_SUBSYSTEM_INFO(Log::Motor, "motor " + this->getId() + ":" + __VA_ARGS__)
+#define LOG_MOTOR_TRACE(...) LOG_SUBSYSTEM_TRACE(Log::Motor, "motor " + this->getId() + ":" + __VA_ARGS__)
+
+const std::chrono::milliseconds MqttMotor::ConfigurationInterval(200);
+const std::chrono::milliseconds MqttMotor::MinPollInterval(100);
+const std::chrono::milliseconds MqttMotor::ResponseTimeout(250);
+const std::chrono::milliseconds MqttMotor::IdlePollInterval(500);
+const std::chrono::milliseconds MqttMotor::ClosedPollInterval(1000);
+const std::chrono::milliseconds MqttMotor::FastPollHold(2000);
 
 MqttMotor::MqttMotor(const std::string& pn,const std::string& serial)
 : _baseTopic("rbus/"+pn + "/" + serial +"/")
@@ -21,61 +29,97 @@ MqttMotor::~MqttMotor() {
     LOG_MOTOR_TRACE("Deconstruct MqttMotor");
 }
 void MqttMotor::onMotorConnected() {
-    //start worker for configuration and on polling motor data
+    //start configuration and polling of the motor data
     {
         std::lock_guard<std::mutex> lock(_mutex);
         _isMotorConfigured=false; 
-        _pollingActive = true;
+        _isPolling = false;
+        // the state is unknown after connecting, poll fast until it settles
+        _fastPollUntil = std::chrono::steady_clock::now() + FastPollHold;
     }
     LOG_MOTOR_INFO("connected");
     
     _commandsManager->startEvaluating();
-    _workerThread = std::thread(&MqttMotor::polStatus, this);
+    LOG_MOTOR_DEBUG("start retrieve max/min speed");
+    requestConfiguration();
+    if (_pollHandle < 0) {
+        _pollHandle = PollScheduler::getInstance().add([this]() {return pollStep();}, ConfigurationInterval);
+    }
     if (!_motorDelegateOutputIsSet) {
          LOG_CRITICAL("no delegate was set for the motor output!");
     }
 }
-void MqttMotor::polStatus() {
-    LOG_MOTOR_DEBUG("start retrieve max/min speed");
+// one step of the polling, called by the poll scheduler: returns the time until the next step
+std::chrono::milliseconds MqttMotor::pollStep() {
+    bool isConfigured;
+    bool isPollDue;
+    bool isFirstPoll;
+    std::chrono::milliseconds nextStep = MinPollInterval;
+    const auto now = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        isConfigured = _isMotorConfigured;
+        isFirstPoll = !_isPolling;
+        isPollDue = true;
+        if (isConfigured && _isPolling) {
+            // without a response wait the response timeout, otherwise the interval of the current state
+            const auto interval = _statusReceived ? getPollInterval(now) : ResponseTimeout;
+            const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(_lastPoll + interval - now);
+            if (remaining.count() > 0) {
+                isPollDue = false;
+                // re-evaluate at least every min interval so a new command speeds up the polling
+                nextStep = std::min(remaining, MinPollInterval);
+            }
+        }
+        if (isConfigured && isPollDue) {
+            _isPolling = true;
+            _statusReceived = false;
+            _lastPoll = now;
+        }
+    }
     // configuring
-    do {
-        _commandsManager->pushCommandoToBeSend(MqttData(_baseTopic + "rbus.get.maxspeed/trigger","","_x_" ),CommandType::Get);
-        _commandsManager->pushCommandoToBeSend(MqttData(_baseTopic + "rbus.get.minspeed/trigger","","_x_" ),CommandType::Get);        
-        
-        std::this_thread::sleep_for(std::chrono::milliseconds(200));
-    } while(!_isMotorConfigured);
+    if (!isConfigured) {
+        requestConfiguration();
+        return ConfigurationInterval;
+    }
+    if (!isPollDue) {
+        return nextStep;
+    }
     // polling status data
-    LOG_MOTOR_DEBUG(" start polling");
-    auto start = std::chrono::system_clock::now();
-    while(_pollingActive) {           
-        start = std::chrono::system_clock::now();
-
-        // when the motor is calibrated and the stroke is not known sendout the get-stroke command
-        if ( isCalibrated() && _stroke <= 0 ) {            
-            _commandsManager->pushCommandoToBeSend(MqttData(_baseTopic + "rbus.get.stroke/trigger","","_x_" ),CommandType::Get);
-        } 
-        // poll for the status
-        _commandsManager->pushCommandoToBeSend(MqttData(_baseTopic + "rbus.get.status/trigger","","_x_" ),CommandType::Get);
-            
-        // wait maximum for 250ms 
-        std::mutex mutex;
-        std::unique_lock<std::mutex> lk(mutex);
-        _cv.wait_for(lk, std::chrono::milliseconds(250)) ;         
-        auto diff =  std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - start).count();
-        if ( diff < 100) {
-            std::this_thread::sleep_for(std::chrono::milliseconds(100-diff)); //sleep at least 100ms
-        }
-    }  
+    if (isFirstPoll) {
+        LOG_MOTOR_DEBUG(" start polling");
+    }
+    // when the motor is calibrated and the stroke is not known sendout the get-stroke command
+    if ( isCalibrated() && _stroke <= 0 ) {            
+        _commandsManager->pushCommandoToBeSend(MqttData(_baseTopic + "rbus.get.stroke/trigger","","_x_" ),CommandType::Get);
+    } 
+    // poll for the status
+    _commandsManager->pushCommandoToBeSend(MqttData(_baseTopic + "rbus.get.status/trigger","","_x_" ),CommandType::Get);
+    return MinPollInterval;
+}
+void MqttMotor::requestConfiguration() {
+    _commandsManager->pushCommandoToBeSend(MqttData(_baseTopic + "rbus.get.maxspeed/trigger","","_x_" ),CommandType::Get);
+    _commandsManager->pushCommandoToBeSend(MqttData(_baseTopic + "rbus.get.minspeed/trigger","","_x_" ),CommandType::Get);        
+}
+// call with the mutex locked
+std::chrono::milliseconds MqttMotor::getPollInterval(std::chrono::steady_clock::time_point now) {
+    if (now < _fastPollUntil || !_isMotorStopped) {
+        return MinPollInterval;
+    }
+    return _currentMotorStatusData.isClosed ? ClosedPollInterval : IdlePollInterval;
+}
+void MqttMotor::requestFastPolling() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _fastPollUntil = std::max(_fastPollUntil, std::chrono::steady_clock::now() + FastPollHold);
 }
 void MqttMotor::onMotorDisconnected() {
     LOG_MOTOR_INFO("disconnect");
-    _isMotorConfigured = true; //stop the loop of motorconfiguration
-    _pollingActive = false;
     cancelAsyncTasks();
-    _commandsManager->stopEvaluating();
-    if (_workerThread.joinable()) {
-        _workerThread.join();
+    if (_pollHandle >= 0) {
+        PollScheduler::getInstance().remove(_pollHandle);
+        _pollHandle = -1;
     }
+    _commandsManager->stopEvaluating();
 }
 void MqttMotor::setDelegateMotorOutput(std::function<void(MqttData)> delegateMotorOutput) {
     _delegateMotorOutput = delegateMotorOutput;
@@ -105,6 +149,7 @@ void MqttMotor::limitSpeedIfNeeded () {
 
 void MqttMotor::stop() {
     if ( _isMotorStopped) return;
+    requestFastPolling();
     LOG_MOTOR_TRACE("stop triggered");
     MqttData data(_baseTopic + "rbus.stop/trigger","","_x_");
     _commandsManager->pushCommandoToBeSend(data,CommandType::SetMovement);
@@ -116,6 +161,7 @@ void MqttMotor::close() {
          std::lock_guard<std::mutex> lock(_mutex);
          _isMotorStopped = false;
     }
+    requestFastPolling();
     LOG_MOTOR_TRACE("close triggerd");
     MqttData data(_baseTopic + "rbus.close/trigger","","_x_");
     _commandsManager->pushCommandoToBeSend(data,CommandType::SetMovement);
@@ -127,6 +173,7 @@ void MqttMotor::open() {
          std::lock_guard<std::mutex> lock(_mutex);
          _isMotorStopped = false;
     }
+    requestFastPolling();
     LOG_MOTOR_TRACE("open triggerd");
     MqttData data(_baseTopic + "rbus.open/trigger","","_x_");
     _commandsManager->pushCommandoToBeSend(data,CommandType::SetMovement);
@@ -137,6 +184,7 @@ void MqttMotor::setPosition(int position) {
          std::lock_guard<std::mutex> lock(_mutex);
          _isMotorStopped = false;
     }
+    requestFastPolling();
     LOG_MOTOR_TRACE("set position triggerd");
     MqttData data(_baseTopic + "rbus.set.position.mm/trigger",position,"_x_");
     _commandsManager->pushCommandoToBeSend(data,CommandType::SetParam);
@@ -194,57 +242,59 @@ void MqttMotor::cancelAsyncTasks() {
 
 void MqttMotor::onMotorInput(const MotorData & data){
     
-    // if update motor position (only relevant when motor is configured):     
-    _cv.notify_all(); 
-
-    
     if (data.isAck()) {
         _commandsManager->handleAck(data.getMqttData());
     }
     if (! data.hasInfo()) return;
         
-    if (_isMotorConfigured && data.getCommand() == "rbus.get.status") {        
-        
-        bool shouldNotUpdatePositionDueManualIntervention = false;        
-        {
-            std::lock_guard<std::mutex> lock(_mutex) ;
-            data.parseStatusData(_currentMotorStatusData );
+    switch (data.getMotorCommand()) {
+        case MotorCommand::GetStatus: {
+            if (!_isMotorConfigured) { break;}
+            bool shouldNotUpdatePositionDueManualIntervention = false;        
+            {
+                std::lock_guard<std::mutex> lock(_mutex) ;
+                data.parseStatusData(_currentMotorStatusData );
+                _statusReceived = true;
 
-            // if motor was stopped but moved without giving a command -> manual intervention, ignore update positions            
-            shouldNotUpdatePositionDueManualIntervention = (_isMotorStopped && !_currentMotorStatusData.isMotorStopped());
-            _isMotorStopped = _currentMotorStatusData.isMotorStopped();                      
-        }
-        // the update can be skipped to not actuate the motors on a manual intervention
-        // always update motion data when emergency run is detected!
-        if(_currentMotorStatusData.isEmergencyRun || !shouldNotUpdatePositionDueManualIntervention) {
-            MotorMotionManager::updateMotionData(_currentMotorStatusData);
+                // if motor was stopped but moved without giving a command -> manual intervention, ignore update positions            
+                shouldNotUpdatePositionDueManualIntervention = (_isMotorStopped && !_currentMotorStatusData.isMotorStopped());
+                _isMotorStopped = _currentMotorStatusData.isMotorStopped();                      
+            }
+            // the update can be skipped to not actuate the motors on a manual intervention
+            // always update motion data when emergency run is detected!
+            if(_currentMotorStatusData.isEmergencyRun || !shouldNotUpdatePositionDueManualIntervention) {
+                MotorMotionManager::updateMotionData(_currentMotorStatusData);
+            }
+            break;
         }
-        
-    } else if (data.getCommand() == "rbus.get.minspeed") {
-        data.parseOneValue(_lowSpeed);
-         {
+        case MotorCommand::GetMinSpeed: {
+            data.parseOneValue(_lowSpeed);
             std::lock_guard<std::mutex> lock(_mutex);   
             _isMotorConfigured = (_lowSpeed!=0) && (_highSpeed!=0);
+            break;
         }
-    } else if (data.getCommand() == "rbus.get.maxspeed") {
-        data.parseOneValue(_highSpeed);
-         {
+        case MotorCommand::GetMaxSpeed: {
+            data.parseOneValue(_highSpeed);
             std::lock_guard<std::mutex> lock(_mutex);   
             _isMotorConfigured = (_lowSpeed!=0) && (_highSpeed!=0);
+            break;
         }
-    } else if (data.getCommand() == "rbus.get.stroke") {
-        LOG_DEBUG("Received stroke result");
-        data.parseOneValue(_stroke);
-        if ( !isCalibrated()) {
-            LOG_DEBUG("Ignored stroke result due flag IsCalibrated=False");
-            _stroke = -1;
-        }
-    } else if (data.getCommand() == "rbus.get.emergencyrun") {
-        LOG_ERROR("Command '" + data.getCommand() + "' not HANDLED");
-    } else {
-       // LOG_TRACE("Command '" + data.getCommand() + "' not used");
-        // do nothing at the moment
-    }   
+        case MotorCommand::GetStroke:
+            LOG_DEBUG("Received stroke result");
+            data.parseOneValue(_stroke);
+            if ( !isCalibrated()) {
+                LOG_DEBUG("Ignored stroke result due flag IsCalibrated=False");
+                _stroke = -1;
+            }
+            break;
+        case MotorCommand::GetEmergencyRun:
+            LOG_ERROR("Command '" + data.getCommand() + "' not HANDLED");
+            break;
+        default:
+            // LOG_TRACE("Command '" + data.getCommand() + "' not used");
+            // do nothing at the moment
+            break;
+    }
    
 }
 
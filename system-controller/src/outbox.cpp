@@ -0,0 +1,58 @@
+#include "outbox.h"
+
+const std::vector<std::string> & Outbox::getDefaultCoalescedTopics() {
+    static const std::vector<std::string> topics = {
+        "rbus/+/+/rbus.set.speed/trigger",
+        "rbus/+/+/rbus.stop/trigger",
+        "systemcontroller/+/wing/+/position"  // the positionperc of a wing
+    };
+    return topics;
+}
+
+Outbox::Outbox() {
+    for (auto & topic : getDefaultCoalescedTopics()) {
+        addCoalescedTopic(topic);
+    }
+}
+
+void Outbox::addCoalescedTopic(const std::string & subscription) {
+    _coalesced.add(subscription, 0);
+}
+
+void Outbox::add(const MqttData & data) {
+    // the topics are interned, the same topic is the same string
+    if (!_pending.empty() && &_pending.back().getTopic() == &data.getTopic() && _pending.back().getPayload() == data.getPayload()) {
+        _elided.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    _pending.push_back(data);
+}
+
+void Outbox::flush(const std::function<void(const MqttData &)> & publish) {
+    _coalescedIndices.clear();
+    _isElided.assign(_pending.size(), false);
+    for (std::size_t i = 0; i < _pending.size(); ++i) {
+        if (_coalesced.matches(_pending[i].getTopic())) {
+            _coalescedIndices.emplace_back(&_pending[i].getTopic(), i);
+        }
+    }
+    // grouped per topic in order of the messages, all but the last of a group are elided
+    std::sort(_coalescedIndices.begin(), _coalescedIndices.end(), [](const std::pair<const std::string *, std::size_t> & a, const std::pair<const std::string *, std::size_t> & b) {
+        return std::less<const std::string *>()(a.first, b.first) || (a.first == b.first && a.second < b.second);
+    });
+    std::uint64_t elided = 0;
+    for (std::size_t i = 0; i + 1 < _coalescedIndices.size(); ++i) {
+        if (_coalescedIndices[i].first == _coalescedIndices[i + 1].first) {
+            _isElided[_coalescedIndices[i].second] = true;
+            elided++;
+        }
+    }
+    _elided.fetch_add(elided, std::memory_order_relaxed);
+
+    for (std::size_t i = 0; i < _pending.size(); ++i) {
+        if (!_isElided[i]) {
+            publish(_pending[i]);
+        }
+    }
+    _pending.clear();
+}
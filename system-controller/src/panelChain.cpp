@@ -0,0 +1,30 @@
+#include "panelChain.h"
+
+PanelChain::PanelChain(const std::shared_ptr<MasterMotorizedWindow> & master)
+    : _structureVersion(master->getStructureVersion()) {
+    _windows.push_back(master.get());
+    _types.push_back(SlaveType::Motor);
+    _masterIndices.push_back(-1);
+    addSlaves(*master, 0);
+    _motors.push_back(master);
+
+    // the tail is found along the first slaves, they come right after their master
+    for (std::size_t i = 1; i < _windows.size() && _masterIndices[i] == (int)_tailIndex; ++i) {
+        _tailIndex = i;
+    }
+}
+
+void PanelChain::addSlaves(const IMovingWindow & window, int windowIndex) {
+    const auto & slaves = window.getSlaves();
+    const auto & slaveTypes = window.getSlaveTypes();
+    for (std::size_t i = 0; i < slaves.size(); ++i) {
+        const int slaveIndex = (int)_windows.size();
+        _windows.push_back(slaves[i].get());
+        _types.push_back(slaveTypes[i]);
+        _masterIndices.push_back(windowIndex);
+        if (slaveTypes[i] == SlaveType::Motor) {
+            _motors.push_back(std::static_pointer_cast<MotorizedWindow>(slaves[i]));
+        }
+        addSlaves(*slaves[i], slaveIndex);
+    }
+}
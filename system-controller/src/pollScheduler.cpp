@@ -0,0 +1,84 @@
+#include "pollScheduler.h"
+
+const std::chrono::milliseconds PollScheduler::StaggerStep(5);
+const int PollScheduler::StaggerPhases;
+
+PollScheduler::PollScheduler(TimerWheel & timerWheel)
+: _timerWheel(timerWheel) {
+}
+
+PollScheduler::~PollScheduler() {
+    std::vector<int> handles;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (auto & client : _clients) {
+            handles.push_back(client.first);
+        }
+    }
+    for (int handle : handles) {
+        remove(handle);
+    }
+}
+
+PollScheduler& PollScheduler::getInstance() {
+    // the wheel is created first so it outlives the scheduler
+    static PollScheduler instance(TimerWheel::getInstance());
+    return instance;
+}
+
+int PollScheduler::add(PollStep pollStep, std::chrono::milliseconds firstStepDelay) {
+    auto client = std::make_shared<Client>();
+    client->pollStep = std::move(pollStep);
+    int handle;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        handle = _nextHandle++;
+        _clients[handle] = client;
+    }
+    // spread the phases: consecutive clients land in different ticks
+    const int phase = (handle * 7) % StaggerPhases;
+    std::lock_guard<std::mutex> lock(client->mutex);
+    scheduleStep(client, firstStepDelay + StaggerStep * phase);
+    return handle;
+}
+
+void PollScheduler::remove(int handle) {
+    std::shared_ptr<Client> client;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _clients.find(handle);
+        if (it == _clients.end()) {
+            return;
+        }
+        client = it->second;
+        _clients.erase(it);
+    }
+    // a running step holds the client mutex
+    std::lock_guard<std::mutex> lock(client->mutex);
+    client->isActive = false;
+    _timerWheel.cancel(client->timerId);
+}
+
+std::size_t PollScheduler::getNumberOfClients() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _clients.size();
+}
+
+// call with the client mutex locked
+void PollScheduler::scheduleStep(const std::shared_ptr<Client> & client, std::chrono::milliseconds delay) {
+    std::weak_ptr<Client> weakClient = client;
+    client->timerId = _timerWheel.schedule(delay, [this, weakClient]() {
+        if (auto client = weakClient.lock()) {
+            step(client);
+        }
+    });
+}
+
+void PollScheduler::step(const std::shared_ptr<Client> & client) {
+    std::lock_guard<std::mutex> lock(client->mutex);
+    if (!client->isActive) {
+        return;
+    }
+    const auto delay = client->pollStep();
+    scheduleStep(client, delay);
+}
@@ -0,0 +1,186 @@
+#include "sharedText.h"
+
+#include <cstring>
+#include <utility>
+
+struct SharedText::Node 
+{
+    std::atomic<int> refs {0};
+    bool interned = false;
+    std::string text;
+    Node * nextFree = nullptr;
+};
+
+namespace {
+
+// free list of released nodes, the strings keep their capacity
+class TextPool
+{
+    public:
+        SharedText::Node * acquire()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (_free != nullptr) {
+                    SharedText::Node * node = _free;
+                    _free = node->nextFree;
+                    _freeCount--;
+                    node->nextFree = nullptr;
+                    return node;
+                }
+            }
+            return new SharedText::Node();
+        }
+        void release(SharedText::Node * node)
+        {
+            if (node->text.capacity() <= SharedText::MaxPooledCapacity) {
+                node->text.clear();
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (_freeCount < SharedText::MaxPooledTexts) {
+                    node->nextFree = _free;
+                    _free = node;
+                    _freeCount++;
+                    return;
+                }
+            }
+            delete node;
+        }
+    private:
+        std::mutex _mutex;
+        SharedText::Node * _free = nullptr;
+        std::size_t _freeCount = 0;
+};
+
+// open addressing table, a lookup does not create a temporary string
+class InternTable
+{
+    public:
+        InternTable() : _slots(SharedText::MaxInternedTexts * 2, nullptr) {}
+
+        SharedText::Node * find(const char * data, std::size_t length)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            std::size_t index = hash(data, length) & (_slots.size() - 1);
+            while (_slots[index] != nullptr) {
+                const std::string & text = _slots[index]->text;
+                if (text.size() == length && std::memcmp(text.data(), data, length) == 0) {
+                    return _slots[index];
+                }
+                index = (index + 1) & (_slots.size() - 1);
+            }
+            if (_count >= SharedText::MaxInternedTexts) {
+                return nullptr;
+            }
+            SharedText::Node * node = new SharedText::Node();
+            node->interned = true;
+            node->text.assign(data, length);
+            _slots[index] = node;
+            _count++;
+            return node;
+        }
+    private:
+        static std::size_t hash(const char * data, std::size_t length)
+        {
+            std::size_t h = 2166136261u; // FNV-1a
+            for (std::size_t i = 0; i < length; ++i) {
+                h = (h ^ (unsigned char)data[i]) * 16777619u;
+            }
+            return h;
+        }
+        std::mutex _mutex;
+        std::vector<SharedText::Node *> _slots;
+        std::size_t _count = 0;
+};
+
+// never destructed, texts can still be released during static destruction
+TextPool & textPool()
+{
+    static TextPool * pool = new TextPool();
+    return *pool;
+}
+InternTable & internTable()
+{
+    static InternTable * table = new InternTable();
+    return *table;
+}
+
+const std::string & emptyText()
+{
+    static const std::string * empty = new std::string();
+    return *empty;
+}
+
+}
+
+SharedText SharedText::copyOf(const char * data, std::size_t length)
+{
+    Node * node = textPool().acquire();
+    node->text.assign(data, length);
+    node->refs.store(1, std::memory_order_relaxed);
+    return SharedText(node);
+}
+
+SharedText SharedText::intern(const char * data, std::size_t length)
+{
+    Node * node = internTable().find(data, length);
+    if (node == nullptr) {
+        return copyOf(data, length);
+    }
+    return SharedText(node);
+}
+
+SharedText::SharedText(const SharedText & other) : _node(other._node)
+{
+    if (_node != nullptr && !_node->interned) {
+        _node->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+SharedText::SharedText(SharedText && other) : _node(other._node)
+{
+    other._node = nullptr;
+}
+
+SharedText & SharedText::operator=(const SharedText & other)
+{
+    if (this != &other) {
+        SharedText copy(other);
+        std::swap(_node, copy._node);
+    }
+    return *this;
+}
+
+SharedText & SharedText::operator=(SharedText && other)
+{
+    if (this != &other) {
+        release();
+        _node = other._node;
+        other._node = nullptr;
+    }
+    return *this;
+}
+
+SharedText::~SharedText()
+{
+    release();
+}
+
+void SharedText::release()
+{
+    if (_node != nullptr && !_node->interned) {
+        if (_node->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            textPool().release(_node);
+        }
+    }
+    _node = nullptr;
+}
+
+const std::string & SharedText::str() const
+{
+    return _node != nullptr ? _node->text : emptyText();
+}
+
+bool SharedText::isInterned() const
+{
+    return _node != nullptr && _node->interned;
+}
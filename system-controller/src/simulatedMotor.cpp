@@ -0,0 +1,161 @@
+#include "simulatedMotor.h"
+#include "mqttMotor.h"
+
+const int SimulatedMotor::DefaultMinSpeed;
+const int SimulatedMotor::DefaultMaxSpeed;
+
+SimulatedMotor::SimulatedMotor(const std::string & id, int stroke, const VirtualClock & clock, int minSpeed, int maxSpeed)
+: _id(id)
+, _stroke(std::max(stroke, 1))
+, _clock(clock)
+, _lowSpeed(std::max(minSpeed, 1))
+, _highSpeed(std::max(maxSpeed, minSpeed))
+, _currentSpeed(_highSpeed) {
+    _reportedStatusData = getActualStatusData();
+}
+
+void SimulatedMotor::setHighSpeed() {
+    if (_currentSpeed == _highSpeed) {return;}
+    _currentSpeed = _highSpeed;
+    countParamCommand(_sentSpeed, _currentSpeed);
+}
+
+void SimulatedMotor::setLowSpeed() {
+    if (_currentSpeed == _lowSpeed) {return;}
+    _currentSpeed = _lowSpeed;
+    countParamCommand(_sentSpeed, _currentSpeed);
+}
+
+void SimulatedMotor::stop() {
+    if (_isMotorStopped) {return;}
+    requestFastPolling();
+    countMovementCommand(MotorCommand::Stop);
+    _isMoving = false;
+}
+
+void SimulatedMotor::close() {
+    if (_reportedStatusData.getStatus() == MotorStatus::Closed) {return;}
+    _isMotorStopped = false;
+    requestFastPolling();
+    countMovementCommand(MotorCommand::Close);
+    moveTo(0);
+    limitSpeedIfNeeded();
+}
+
+void SimulatedMotor::open() {
+    if (_reportedStatusData.getStatus() == MotorStatus::Open) {return;}
+    _isMotorStopped = false;
+    requestFastPolling();
+    countMovementCommand(MotorCommand::Open);
+    moveTo(_stroke);
+    limitSpeedIfNeeded();
+}
+
+void SimulatedMotor::setPosition(int position) {
+    _isMotorStopped = false;
+    requestFastPolling();
+    countParamCommand(_sentPosition, position);
+    moveTo(position);
+    limitSpeedIfNeeded();
+}
+
+void SimulatedMotor::requestFastPolling() {
+    _fastPollUntil = std::max(_fastPollUntil, _clock.now() + MqttMotor::FastPollHold);
+}
+
+std::future<bool> SimulatedMotor::clearCalibration() {
+    _isCalibrated = false;
+    _reachedOpenEnd = false;
+    _reachedClosedEnd = false;
+    std::promise<bool> cleared;
+    cleared.set_value(true);
+    return cleared.get_future();
+}
+
+void SimulatedMotor::jumpToPosition(int position) {
+    _position = std::min(std::max(position, 0), _stroke);
+    _isMoving = false;
+}
+
+bool SimulatedMotor::step(std::chrono::milliseconds duration) {
+    if (_isMoving) {
+        const double distance = _currentSpeed * (duration.count() / 1000.0);
+        if (std::abs(_target - _position) <= distance) {
+            _position = _target;
+            _isMoving = false;
+        } else {
+            _position += _target > _position ? distance : -distance;
+        }
+        if (_position >= _stroke) {
+            _reachedOpenEnd = true;
+        }
+        if (_position <= 0) {
+            _reachedClosedEnd = true;
+        }
+        if (!_isCalibrated && _reachedOpenEnd && _reachedClosedEnd) {
+            _isCalibrated = true;
+        }
+    }
+    if (_clock.now() < _nextStatusReport) {
+        return false;
+    }
+    reportStatus();
+    return true;
+}
+
+void SimulatedMotor::reportStatus() {
+    _numberOfStatusReports++;
+    _reportedStatusData = getActualStatusData();
+    _isMotorStopped = _reportedStatusData.isMotorStopped();
+    // same cadence as the polling of an MqttMotor
+    std::chrono::milliseconds interval = MqttMotor::MinPollInterval;
+    if (_clock.now() >= _fastPollUntil && _isMotorStopped) {
+        interval = _reportedStatusData.isClosed ? MqttMotor::ClosedPollInterval : MqttMotor::IdlePollInterval;
+    }
+    _nextStatusReport = _clock.now() + interval;
+    updateMotionData(_reportedStatusData);
+}
+
+// like an MqttMotor the low speed is sent again with every movement
+void SimulatedMotor::limitSpeedIfNeeded() {
+    if (_currentSpeed == _lowSpeed) {
+        countParamCommand(_sentSpeed, _lowSpeed);
+    }
+}
+
+void SimulatedMotor::moveTo(int target) {
+    _target = std::min(std::max(target, 0), _stroke);
+    _isMoving = (int)std::lround(_position) != _target;
+}
+
+void SimulatedMotor::countMovementCommand(MotorCommand command) {
+    const auto now = _clock.now();
+    if (command == _lastMovementCommand && now - _lastMovementTime < std::chrono::milliseconds(500)) {
+        return;
+    }
+    _lastMovementCommand = command;
+    _lastMovementTime = now;
+    _numberOfCommands++;
+}
+
+void SimulatedMotor::countParamCommand(SentParam & sentParam, int value) {
+    const auto now = _clock.now();
+    const bool isSentAfterMovement = _lastMovementTime > sentParam.time;
+    if (value == sentParam.value && !isSentAfterMovement && now - sentParam.time <= std::chrono::milliseconds(1000)) {
+        return;
+    }
+    sentParam.value = value;
+    sentParam.time = now;
+    _numberOfCommands++;
+}
+
+MotorStatusData SimulatedMotor::getActualStatusData() const {
+    MotorStatusData data;
+    data.posMm = getActualPosition();
+    data.posPerc = 100 * data.posMm / _stroke;
+    data.speedMm = _isMoving ? _currentSpeed : 0;
+    data.isOpen = !_isMoving && data.posMm >= _stroke;
+    data.isClosed = !_isMoving && data.posMm <= 0;
+    data.isCalibrated = _isCalibrated;
+    return data;
+}
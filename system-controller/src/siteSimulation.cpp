@@ -0,0 +1,93 @@
+#include "siteSimulation.h"
+#include "configBuilder.h"
+
+const std::chrono::milliseconds SiteSimulation::PhysicsStep(10);
+const std::chrono::milliseconds SiteSimulation::EvaluationInterval(200);
+
+SiteSimulation::SiteSimulation(const std::string & jsonConfig) {
+    std::string configId;
+    ConfigBuilder::parseFromJson(jsonConfig, _wings, configId, [this](const ConfigObject & motorObject) {
+        auto motor = std::make_shared<SimulatedMotor>(motorObject.pn + "/" + motorObject.serial, motorObject.length, _clock);
+        _motors.push_back(motor);
+        return motor;
+    });
+    for (auto & wing : _wings) {
+        wing->setDelegateWingPublishOutput([this](const MqttData &) {_wingMessages++;});
+    }
+    // the first status gives the strokes to the windows, afterwards the setup counts as calibrated
+    for (auto & motor : _motors) {
+        motor->reportStatus();
+    }
+    for (auto & wing : _wings) {
+        wing->SetFullSetupCalibDone();
+    }
+}
+
+void SiteSimulation::run(std::chrono::milliseconds duration) {
+    const auto end = _clock.now() + duration;
+    while (_clock.now() < end) {
+        step();
+    }
+}
+
+bool SiteSimulation::runUntil(std::function<bool(void)> condition, std::chrono::milliseconds timeout) {
+    const auto end = _clock.now() + timeout;
+    while (!condition()) {
+        if (_clock.now() >= end) {
+            return false;
+        }
+        step();
+    }
+    return true;
+}
+
+void SiteSimulation::step() {
+    _clock.advance(PhysicsStep);
+    for (auto & motor : _motors) {
+        const auto start = std::chrono::steady_clock::now();
+        if (motor->step(PhysicsStep) && _updateObserver) {
+            _updateObserver(std::chrono::steady_clock::now() - start);
+        }
+    }
+    if (_clock.now() < _nextEvaluation) {
+        return;
+    }
+    _nextEvaluation = _clock.now() + EvaluationInterval;
+    for (auto & wing : _wings) {
+        const auto start = std::chrono::steady_clock::now();
+        wing->updateWingMovement();
+        _wingEvaluations++;
+        if (_updateObserver) {
+            _updateObserver(std::chrono::steady_clock::now() - start);
+        }
+    }
+}
+
+bool SiteSimulation::areAllWingsIn(MotorStatus status) const {
+    return std::all_of(_wings.begin(), _wings.end(), [status](const std::shared_ptr<IWing> & wing) {
+        return wing->getMasterWindow()->getMotionManager()->getMotorStatusData().getStatus() == status;
+    });
+}
+
+bool SiteSimulation::areAllWingsOpen() const {
+    return areAllWingsIn(MotorStatus::Open);
+}
+
+bool SiteSimulation::areAllWingsClosed() const {
+    return areAllWingsIn(MotorStatus::Closed);
+}
+
+bool SiteSimulation::areAllMotorsStopped() const {
+    return std::none_of(_motors.begin(), _motors.end(), [](const std::shared_ptr<SimulatedMotor> & motor) {return motor->isMoving();});
+}
+
+SiteSimulation::Counters SiteSimulation::getCounters() const {
+    Counters counters;
+    for (auto & motor : _motors) {
+        counters.statusReports += motor->getNumberOfStatusReports();
+        counters.motorCommands += motor->getNumberOfCommands();
+    }
+    counters.wingEvaluations = _wingEvaluations;
+    counters.wingMessages = _wingMessages;
+    return counters;
+}
@@ -0,0 +1,147 @@
+#include "strand.h"
+
+#include <utility>
+#include "log.h"
+
+namespace {
+    thread_local const Strand * currentStrand = nullptr;
+
+    void runTask(const std::function<void()> & task) {
+        try {
+            task();
+        } catch (std::exception * e) {
+            LOG_ERROR("Task failed: " + std::string(e->what()));
+            delete e;
+        } catch (std::exception & e) {
+            LOG_ERROR("Task failed: " + std::string(e.what()));
+        } catch (...) {
+            LOG_ERROR("Task failed with an unknown exception");
+        }
+    }
+}
+
+ThreadPool::ThreadPool(std::size_t numberOfThreads) {
+    for (std::size_t i = 0; i < std::max<std::size_t>(1, numberOfThreads); ++i) {
+        _threads.emplace_back(&ThreadPool::run, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _isRunning = false;
+    }
+    _cv.notify_all();
+    for (auto & t : _threads) {
+        if (t.get_id() == std::this_thread::get_id()) {
+            t.detach(); // the last owner was a task of the pool itself
+        } else {
+            t.join();
+        }
+    }
+}
+
+std::size_t ThreadPool::getDefaultNumberOfThreads() {
+    return std::min<std::size_t>(4, std::max<std::size_t>(2, std::thread::hardware_concurrency()));
+}
+
+void ThreadPool::post(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _tasks.push_back(std::move(task));
+    }
+    _cv.notify_one();
+}
+
+// the tasks that are still queued on destruction are done before the threads stop
+void ThreadPool::run() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _cv.wait(lock, [this]() {return !_isRunning || !_tasks.empty();});
+            if (_tasks.empty()) {
+                return;
+            }
+            task = std::move(_tasks.front());
+            _tasks.pop_front();
+        }
+        runTask(task);
+    }
+}
+
+const std::size_t Strand::MaxTasksPerTurn;
+
+Strand::Strand(const std::shared_ptr<ThreadPool> & pool) : _pool(pool) {
+}
+
+void Strand::post(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _tasks.push_back(std::move(task));
+        if (_isScheduled) {
+            return; // the running turn picks it up
+        }
+        _isScheduled = true;
+    }
+    schedule();
+}
+
+void Strand::schedule() {
+    auto pool = _pool.lock();
+    if (!pool) {
+        LOG_WARNING("Strand has no thread pool anymore, its tasks are dropped");
+        std::lock_guard<std::mutex> lock(_mutex);
+        _tasks.clear();
+        _isScheduled = false;
+        _idle.notify_all();
+        return;
+    }
+    auto self = shared_from_this();
+    pool->post([self]() {self->runTasks();});
+}
+
+void Strand::dispatch(std::function<void()> task) {
+    if (isRunningInThisThread()) {
+        runTask(task);
+    } else {
+        post(std::move(task));
+    }
+}
+
+bool Strand::isRunningInThisThread() const {
+    return currentStrand == this;
+}
+
+void Strand::waitUntilIdle() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _idle.wait(lock, [this]() {return !_isScheduled;});
+}
+
+void Strand::runTasks() {
+    const Strand * previousStrand = currentStrand;
+    currentStrand = this;
+    bool isDone = false;
+    for (std::size_t i = 0; i < MaxTasksPerTurn && !isDone; ++i) {
+        std::function<void()> task;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_tasks.empty()) {
+                _isScheduled = false;
+                isDone = true;
+                continue;
+            }
+            task = std::move(_tasks.front());
+            _tasks.pop_front();
+        }
+        runTask(task);
+    }
+    currentStrand = previousStrand;
+
+    if (isDone) {
+        _idle.notify_all();
+    } else {
+        // still scheduled, give the other strands a turn first
+        schedule();
+    }
+}
@@ -0,0 +1,121 @@
+#include "subscriptionMatcher.h"
+
+SubscriptionMatcher::SubscriptionMatcher() : _nodes(1) {
+}
+
+void SubscriptionMatcher::clear() {
+    _nodes.clear();
+    _nodes.resize(1);
+}
+
+void SubscriptionMatcher::add(const std::string & subscription, std::size_t subscriber) {
+    std::uint32_t node = 0;
+    std::size_t levelBegin = 0;
+    for (;;) {
+        std::size_t levelEnd = subscription.find('/', levelBegin);
+        if (levelEnd == std::string::npos) {
+            levelEnd = subscription.size();
+        }
+        const std::string level = subscription.substr(levelBegin, levelEnd - levelBegin);
+        if (level == "#") {
+            addUnique({subscriber}, _nodes[node].hashSubscribers);
+            return;
+        }
+        std::int32_t next = -1;
+        if (level == "+") {
+            next = _nodes[node].plusChild;
+        } else {
+            for (auto & child : _nodes[node].children) {
+                if (child.first == level) {
+                    next = child.second;
+                }
+            }
+        }
+        if (next < 0) {
+            next = _nodes.size();
+            _nodes.push_back(Node());
+            if (level == "+") {
+                _nodes[node].plusChild = next;
+            } else {
+                _nodes[node].children.push_back(std::make_pair(level, (std::uint32_t)next));
+            }
+        }
+        node = next;
+        if (levelEnd == subscription.size()) {
+            addUnique({subscriber}, _nodes[node].subscribers);
+            return;
+        }
+        levelBegin = levelEnd + 1;
+    }
+}
+
+void SubscriptionMatcher::match(const StringSpan & topic, std::vector<std::size_t> & subscribers) const {
+    matchLevel(0, topic, 0, subscribers);
+}
+
+bool SubscriptionMatcher::matches(const StringSpan & topic) const {
+    return matchesLevel(0, topic, 0);
+}
+
+// levelBegin points to the first character of the next level, 
+// when it is past the end of the topic all levels are consumed
+void SubscriptionMatcher::matchLevel(std::uint32_t nodeIndex, const StringSpan & topic, std::size_t levelBegin, std::vector<std::size_t> & subscribers) const {
+    const Node & node = _nodes[nodeIndex];
+    const bool isFirstLevel = (levelBegin == 0);
+    const bool isSystemTopic = isFirstLevel && !topic.empty() && topic[0] == '$';
+    if (!isSystemTopic) {
+        addUnique(node.hashSubscribers, subscribers);
+    }
+    if (levelBegin > topic.size()) {
+        addUnique(node.subscribers, subscribers);
+        return;
+    }
+    std::size_t levelEnd = levelBegin;
+    while (levelEnd < topic.size() && topic[levelEnd] != '/') {
+        ++levelEnd;
+    }
+    const StringSpan level(topic.data() + levelBegin, levelEnd - levelBegin);
+    for (auto & child : node.children) {
+        if (level.equals(child.first.data(), child.first.size())) {
+            matchLevel(child.second, topic, levelEnd + 1, subscribers);
+            break;
+        }
+    }
+    if (node.plusChild >= 0 && !isSystemTopic) {
+        matchLevel(node.plusChild, topic, levelEnd + 1, subscribers);
+    }
+}
+
+// same walk as matchLevel, but stops at the first match
+bool SubscriptionMatcher::matchesLevel(std::uint32_t nodeIndex, const StringSpan & topic, std::size_t levelBegin) const {
+    const Node & node = _nodes[nodeIndex];
+    const bool isSystemTopic = (levelBegin == 0) && !topic.empty() && topic[0] == '$';
+    if (!isSystemTopic && !node.hashSubscribers.empty()) {
+        return true;
+    }
+    if (levelBegin > topic.size()) {
+        return !node.subscribers.empty();
+    }
+    std::size_t levelEnd = levelBegin;
+    while (levelEnd < topic.size() && topic[levelEnd] != '/') {
+        ++levelEnd;
+    }
+    const StringSpan level(topic.data() + levelBegin, levelEnd - levelBegin);
+    for (auto & child : node.children) {
+        if (level.equals(child.first.data(), child.first.size())) {
+            if (matchesLevel(child.second, topic, levelEnd + 1)) {
+                return true;
+            }
+            break;
+        }
+    }
+    return node.plusChild >= 0 && !isSystemTopic && matchesLevel(node.plusChild, topic, levelEnd + 1);
+}
+
+void SubscriptionMatcher::addUnique(const std::vector<std::size_t> & from, std::vector<std::size_t> & to) {
+    for (auto s : from) {
+        if (std::find(to.begin(), to.end(), s) == to.end()) {
+            to.push_back(s);
+        }
+    }
+}
@@ -0,0 +1,35 @@
+#include "systemSettings.h"
+
+const SystemSettingsSnapshot SystemSettings::Defaults = {100, 600, 200, 100, 100, 300};
+// constant initialized, readers never depend on the order of static initialisation
+std::atomic<const SystemSettingsSnapshot *> SystemSettings::_snapshot(&SystemSettings::Defaults);
+
+namespace {
+    void clamp(const std::string & name, int & value, int current, int min, int max) {
+        const int requested = value;
+        value = std::min(std::max(requested, min), max);
+        if (value != requested) {
+            LOG_WARNING(name + " requested out of boundries [" + std::to_string(min) + "-" + std::to_string(max) + "]: " + std::to_string(requested) + " set to " + std::to_string(value));
+        }
+        if (value != current) {
+            LOG_INFO(name + " set: " + std::to_string(value));
+        }
+    }
+}
+
+void SystemSettings::setSettings(SystemSettingsSnapshot settings) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    publish(settings);
+}
+
+void SystemSettings::publish(SystemSettingsSnapshot settings) {
+    const SystemSettingsSnapshot & current = *getSnapshot();
+    clamp("chican overlap", settings.chicanOverlap, current.chicanOverlap, 100, 600);
+    clamp("chicanZone", settings.chicanZone, current.chicanZone, 300, 1200);
+    clamp("Slowdowndist", settings.slowdownDist, current.slowdownDist, 150, 800);
+    clamp("CornerZone", settings.cornerZone, current.cornerZone, 90, 500);
+    clamp("OppositeZone", settings.oppositeZone, current.oppositeZone, 90, 500);
+    clamp("TriggerPushWingDistance", settings.triggerPushWingDistance, current.triggerPushWingDistance, 250, 800);
+    _snapshots.push_back(std::unique_ptr<const SystemSettingsSnapshot>(new SystemSettingsSnapshot(settings)));
+    _snapshot.store(_snapshots.back().get(), std::memory_order_release);
+}
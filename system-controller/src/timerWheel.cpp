@@ -0,0 +1,110 @@
+#include "timerWheel.h"
+
+TimerWheel::TimerWheel(std::chrono::milliseconds tick, std::size_t numberOfSlots)
+: _tick(std::max(tick, std::chrono::milliseconds(1)))
+, _slots(std::max(numberOfSlots, (std::size_t)1))
+, _start(std::chrono::steady_clock::now()) {
+    _workerThread = std::thread(&TimerWheel::run, this);
+}
+
+TimerWheel::~TimerWheel() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _isRunning = false;
+    }
+    _cv.notify_all();
+    if (_workerThread.joinable()) {
+        _workerThread.join();
+    }
+}
+
+TimerWheel& TimerWheel::getInstance() {
+    static TimerWheel instance;
+    return instance;
+}
+
+TimerWheel::TimerId TimerWheel::schedule(std::chrono::milliseconds delay, std::function<void()> callback) {
+    const auto now = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(_mutex);
+    const uint64_t elapsedTicks = (now - _start) / _tick;
+    if (_pendingIds.empty()) {
+        // the worker skipped ticks while idle, continue from now
+        _currentTick = std::max(_currentTick, elapsedTicks);
+    }
+    // round up: a timer never fires before its delay passed
+    const auto dueTime = std::chrono::duration_cast<std::chrono::nanoseconds>(now - _start + std::max(delay, std::chrono::milliseconds(0)));
+    const auto tickTime = std::chrono::duration_cast<std::chrono::nanoseconds>(_tick);
+    const uint64_t dueTick = std::max(_currentTick + 1, (uint64_t)((dueTime + tickTime - std::chrono::nanoseconds(1)) / tickTime));
+
+    const TimerId id = _nextId++;
+    _slots[dueTick % _slots.size()].push_back(Timer{id, dueTick, std::move(callback)});
+    const bool wasIdle = _pendingIds.empty();
+    _pendingIds.insert(id);
+    if (wasIdle) {
+        _cv.notify_all();
+    }
+    return id;
+}
+
+bool TimerWheel::cancel(TimerId id) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    // the entry itself is removed when its slot comes by
+    return _pendingIds.erase(id) > 0;
+}
+
+std::size_t TimerWheel::getNumberOfPendingTimers() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _pendingIds.size();
+}
+
+void TimerWheel::collectExpired(uint64_t tick, std::vector<Timer> & expired) {
+    auto & slot = _slots[tick % _slots.size()];
+    for (std::size_t i = 0; i < slot.size();) {
+        const bool isCancelled = _pendingIds.count(slot[i].id) == 0;
+        if (isCancelled || slot[i].dueTick <= tick) {
+            if (!isCancelled) {
+                _pendingIds.erase(slot[i].id);
+                expired.push_back(std::move(slot[i]));
+            }
+            // order within a slot is not relevant: swap with the last one
+            if (i != slot.size() - 1) {
+                slot[i] = std::move(slot.back());
+            }
+            slot.pop_back();
+        } else {
+            ++i; // due in one of the next rounds
+        }
+    }
+}
+
+void TimerWheel::run() {
+    std::vector<Timer> expired;
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (_isRunning) {
+        if (_pendingIds.empty()) {
+            _cv.wait(lock, [this]() {return !_isRunning || !_pendingIds.empty();});
+            continue;
+        }
+        const auto nextTickTime = _start + _tick * (_currentTick + 1);
+        if (std::chrono::steady_clock::now() < nextTickTime) {
+            _cv.wait_until(lock, nextTickTime);
+            continue;
+        }
+        _currentTick++;
+        collectExpired(_currentTick, expired);
+        if (expired.empty()) {
+            continue;
+        }
+        // fire all timers of this tick as one batch without holding the lock
+        lock.unlock();
+        for (auto & timer : expired) {
+            try {
+                timer.callback();
+            } catch (const std::exception & e) {
+                LOG_ERROR(std::string("timer callback failed: ") + e.what());
+            }
+        }
+        expired.clear();
+        lock.lock();
+    }
+}
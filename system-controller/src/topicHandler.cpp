@@ -5,15 +5,23 @@
 #include "log.h"
 #include "topicHandler.h"
 
+const std::size_t TopicHandler::InputBufferCapacity;
+const std::size_t TopicHandler::OutputBufferCapacity;
 
-TopicHandler::TopicHandler(std::vector<std::string>  subscribeStrs)
+TopicHandler::TopicHandler(std::vector<std::string>  subscribeStrs, std::size_t numberOfShards)
     : _running(false)
     , _subscribeStrs(std::move(subscribeStrs))
-    , _pInTypeBuffer(std::make_shared<Buffer<MqttData>> ())
-    , _pOutTypeBuffer(std::make_shared<Buffer<MqttData>> ())
-{}
+    , _pOutTypeBuffer(std::make_shared<MqttBuffer> (OutputBufferCapacity, OverflowPolicy::Block))
+{
+    for (std::size_t i = 0; i < std::max<std::size_t>(1, numberOfShards); ++i) {
+        _pInTypeBuffers.push_back(std::make_shared<MqttBuffer> (InputBufferCapacity, OverflowPolicy::DropOldest));
+    }
+    for (auto & sub : _subscribeStrs) {
+        _subscriptionMatcher.add(sub, 0);
+    }
+}
 
-TopicHandler::TopicHandler():_running(false){}
+TopicHandler::TopicHandler() : TopicHandler(std::vector<std::string>()) {}
 
 TopicHandler::~TopicHandler() {
     if (_running) {
@@ -30,7 +38,9 @@ void TopicHandler::start() {
     }
     LOG_DEBUG("Topichandler started");
     _running = true;
-    _workerThread = std::thread(&TopicHandler::run, this);
+    for (std::size_t shard = 0; shard < _pInTypeBuffers.size(); ++shard) {
+        _workerThreads.push_back(std::thread(&TopicHandler::run, this, shard));
+    }
 }
 
 void TopicHandler::stop() {
@@ -40,9 +50,10 @@ void TopicHandler::stop() {
     }
     LOG_DEBUG("Topichandler stopped");
     _running = false;
-    if (_workerThread.joinable()) {
-        _workerThread.join();
+    for (auto & workerThread : _workerThreads) {
+        workerThread.join();
     }
+    _workerThreads.clear();
 }
 
 // to be overwritten in derived classes.
@@ -52,28 +63,49 @@ void TopicHandler::handleNewInput ( const MqttData & inputData) {
     _pOutTypeBuffer->QueueNewMessage(inputData);
 }
 
+std::size_t TopicHandler::getShardKey(const MqttData & data) const {
+    return hashTopicLevels(data.getTopic(), std::numeric_limits<std::size_t>::max());
+}
+
+// FNV-1a
+std::size_t TopicHandler::hashTopicLevels(const std::string & topic, std::size_t numberOfLevels) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (char c : topic) {
+        if (c == '/' && --numberOfLevels == 0) {
+            break;
+        }
+        hash = (hash ^ (unsigned char)c) * 1099511628211ULL;
+    }
+    return (std::size_t)hash;
+}
+
+void TopicHandler::queueInput(const MqttData & data) {
+    const std::size_t shard = (_pInTypeBuffers.size() == 1) ? 0 : getShardKey(data) % _pInTypeBuffers.size();
+    _pInTypeBuffers[shard]->QueueNewMessage(data);
+}
+
 // The inputbuffer is filled somewhere and with the run function 
 // the buffer is unqueued and the handled
-void TopicHandler::run() {
-    LOG_DEBUG("Topichandler starts running ...");
+void TopicHandler::run(std::size_t shard) {
+    LOG_DEBUG("Topichandler starts running shard " + std::to_string(shard) + " ...");
+    std::vector<MqttData> inputData;
+    auto & inputBuffer = _pInTypeBuffers[shard];
     while (_running) {
-        MqttData inputData;
-        const int ret = _pInTypeBuffer->UnqueueMessage(inputData);
-
-        if (ret == 0) { //false notify, no data available
-            std::mutex mutex;
-            std::unique_lock<std::mutex> lk(mutex);
-            _pInTypeBuffer->conditionVariable().wait_for(lk, std::chrono::milliseconds(250));
+        inputData.clear();
+        if (inputBuffer->UnqueueAll(inputData) == 0) { //false notify, no data available
+            inputBuffer->WaitForMessage(std::chrono::milliseconds(250));
             continue;
         }
-        handleNewInput(inputData);     
+        for (auto & data : inputData) {
+            handleNewInput(data);     
+        }
     }
 }
 
-const std::shared_ptr<Buffer<MqttData>> TopicHandler::getInputBuffer() {
-    return _pInTypeBuffer;
+const std::shared_ptr<MqttBuffer> TopicHandler::getInputBuffer() {
+    return _pInTypeBuffers[0];
 }
-const std::shared_ptr<Buffer<MqttData>> TopicHandler::getOutputBuffer() {
+const std::shared_ptr<MqttBuffer> TopicHandler::getOutputBuffer() {
     return _pOutTypeBuffer;
 }
 
@@ -82,49 +114,5 @@ std::vector<std::string> TopicHandler::getSubscribeStrs() {
 }
 
 bool TopicHandler::isTopicValidForHandling(const std::string & topic) {
-    for (auto & sub: _subscribeStrs) {
-        // check topic subscription on current=> if match return true
-        
-        // subscription length should always be shorter
-        if ( topic.size() < sub.size())
-            continue; // no match
-        
-        bool isSearchingForNextMatch =false;
-        std::string::size_type j = 0; // counter for sub Str
-        std::string::size_type i = 0; // counter for topic Str
-        for(; i < topic.size(); ++i) {
-            if ( j >= sub.size()) {
-                    break;
-            } else {
-                 if (isSearchingForNextMatch) {
-                    if( topic[i] == '/' ) {
-                        isSearchingForNextMatch = false;
-                    } else {
-                        continue; //don't update the j-counter
-                    }
-                }
-                else if ( topic[i] != sub[j]) {
-                    if ( sub[j]=='#') {
-                        if (j==0 || topic[j-1]=='/') {
-                            return true;
-                        } else { 
-                            break;
-                        }
-                    } else if (sub[j]=='+') {
-                        isSearchingForNextMatch=true;  
-                        j++;// point to '/'
-                        continue;                 
-                    } else {                   
-                        break;
-                    }
-                }
-                j++;
-            }
-        }
-        if ( i >= topic.size() && !isSearchingForNextMatch)
-            return true;
-
-    }
-    return false;
-
-}
\ No newline at end of file
+    return _subscriptionMatcher.matches(topic);
+}
@@ -3,13 +3,13 @@
 #include <utility>
 #include "log.h"
 
-#define LOG_WING_CRITICAL(...) LOG_CRITICAL("wing " + this->getWingId() + ":" + __VA_ARGS__);
+#define LOG_WING_CRITICAL(...) LOG_SUBSYSTEM_CRITICAL(Log::Wing, "wing " + this->getWingId() + ":" + __VA_ARGS__)
 #define LOG_WING_CRITICAL_THROW(...) LOG_CRITICAL_THROW("wing " + this->getWingId() + ":" + __VA_ARGS__);
-#define LOG_WING_ERROR(...) LOG_ERROR("wing " + this->getWingId() + ":" + __VA_ARGS__);
-#define LOG_WING_WARNING(...) LOG_WARNING("wing " + this->getWingId() + ":" + __VA_ARGS__);
-#define LOG_WING_DEBUG(...) LOG_DEBUG("wing " + this->getWingId() + ":" + __VA_ARGS__);
-#define LOG_WING_INFO(...)  LOG_INFO("wing " + this->getWingId() + ":" + __VA_ARGS__);
-#define LOG_WING_TRACE(...) LOG_TRACE("wing " + this->getWingId() + ":" + __VA_ARGS__);
+#define LOG_WING_ERROR(...) LOG_SUBSYSTEM_ERROR(Log::Wing, "wing " + this->getWingId() + ":" + __VA_ARGS__)
+#define LOG_WING_WARNING(...) LOG_SUBSYSTEM_WARNING(Log::Wing, "wing " + this->getWingId() + ":" + __VA_ARGS__)
+#define LOG_WING_DEBUG(...) LOG_SUBSYSTEM_DEBUG(Log::Wing, "wing " + this->getWingId() + ":" + __VA_ARGS__)
+#define LOG_WING_INFO(...)  LOG_SUBSYSTEM_INFO(Log::Wing, "wing " + this->getWingId() + ":" + __VA_ARGS__)
+#define LOG_WING_TRACE(...) LOG_SUBSYSTEM_TRACE(Log::Wing, "wing " + this->getWingId() + ":" + __VA_ARGS__)
 
 int Wing::instanceCounter = 0;
 
@@ -33,7 +33,7 @@ Wing::Wing(std::shared_ptr<MasterMotorizedWindow> masterWindow,
 
 
     LOG_WING_TRACE("Register position handler of masterwindow on wing");
-    _masterWindow->getMotionManager()->addOnPositionUpdatehandler([&](int pos) {
+    _positionHandlerId = _masterWindow->getMotionManager()->addOnPositionUpdatehandler([&](int pos) {
         _currentWingStatus->updatePosition(pos);
         updateWingMovement();
         // only update position when moving
@@ -43,7 +43,7 @@ Wing::Wing(std::shared_ptr<MasterMotorizedWindow> masterWindow,
         }
     });
 
-    _masterWindow->getMotionManager()->addOnMotorStatusUpdatehandler([&](MotorStatus newStatus) {
+    _statusHandlerId = _masterWindow->getMotionManager()->addOnMotorStatusUpdatehandler([&](MotorStatus newStatus) {
         switch (newStatus) {
         case MotorStatus::Closed:
             _wingStatusPublisher->publishFullyClosed(_wingName);
@@ -64,6 +64,10 @@ Wing::Wing(std::shared_ptr<MasterMotorizedWindow> masterWindow,
         };
     });
 }
+Wing::~Wing() {
+    _masterWindow->getMotionManager()->removeOnPositionUpdatehandler(_positionHandlerId);
+    _masterWindow->getMotionManager()->removeOnMotorStatusUpdatehandler(_statusHandlerId);
+}
 void Wing::addSibling(std::shared_ptr<IWing> sibling, WingSiblingType siblingType) {
     // first check if Wing is not already in the list
     bool passedAlreadyInsertedSibling = false;
@@ -137,7 +141,7 @@ std::shared_ptr<MasterMotorizedWindow> Wing::getMasterWindow() const {
 
 bool Wing::hasCalibratedMotors(){
     bool allMotorsAreCalibrated = true;
-    for ( auto & m : getMotors())  {
+    for ( auto & m : getPanelChain().getMotors())  {
         allMotorsAreCalibrated = m->getMotionManager()->isCalibrated();
         if ( !allMotorsAreCalibrated ){ break;}
     }
@@ -223,6 +227,12 @@ void Wing::updateWingMovement () {
     if( !_siblings->empty()) {
         // only check siblings when not pushed (otherwise sibling can deadlock system)
         checkSiblingRelations();      
+        // a sibling is close: its position depends on ours, keep the status of our motors fresh
+        if (getCornerPushZone()->isActive() || getOppositePushZone()->isActive()) {
+            for (auto & motor : getMotors()) {
+                motor->getMotionManager()->requestFastPolling();
+            }
+        }
         
         bool targetInzone = getCornerPushZone()->isInZone(getTarget()) && getOppositePushZone()->isInZone(getTarget());
    
@@ -433,12 +443,13 @@ void Wing::unBlockedByCornerRelation(){
 
     
 
-// The motors are gathered on request! Don't call this to freqently! This is done like this because the wing has no idea when some 
-// slaves are added or deleted -> improve by notify 
-const std::vector<std::shared_ptr<MotorizedWindow>> Wing::getMotors() const {
-    auto motors = _masterWindow->getSlaveMotors();
-    motors.push_back(_masterWindow);
-    return motors;
+// compiled again when slaves were added to the master window after the previous call
+const PanelChain & Wing::getPanelChain() const {
+    std::lock_guard<std::mutex> lock(_panelChainMutex);
+    if (_panelChain.size() == 0 || _panelChain.getStructureVersion() != _masterWindow->getStructureVersion()) {
+        _panelChain = PanelChain(_masterWindow);
+    }
+    return _panelChain;
 }
 
 
@@ -3,59 +3,65 @@
 
 using namespace rapidjson;
 
+namespace {
+    struct WingCommandName {
+        const char * name;
+        std::size_t length;
+        WingComandType command;
+    };
+    #define WING_COMMAND(name, command) {name, sizeof(name) - 1, command}
+    // all accepted spellings of the commands
+    constexpr WingCommandName wingCommandNames[] = {
+        WING_COMMAND("open", WingComandType::Open),
+        WING_COMMAND("Open", WingComandType::Open),
+        WING_COMMAND("openOrStop", WingComandType::OpenOrStop),
+        WING_COMMAND("OpenOrStop", WingComandType::OpenOrStop),
+        WING_COMMAND("openorstop", WingComandType::OpenOrStop),
+        WING_COMMAND("calibrate", WingComandType::Calibrate),
+        WING_COMMAND("Calibrate", WingComandType::Calibrate),
+        WING_COMMAND("cancel", WingComandType::Cancel),
+        WING_COMMAND("Cancel", WingComandType::Cancel),
+        WING_COMMAND("stop", WingComandType::Stop),
+        WING_COMMAND("Stop", WingComandType::Stop),
+        WING_COMMAND("close", WingComandType::Close),
+        WING_COMMAND("Close", WingComandType::Close),
+        WING_COMMAND("closeOrStop", WingComandType::CloseOrStop),
+        WING_COMMAND("CloseOrStop", WingComandType::CloseOrStop),
+        WING_COMMAND("closeorstop", WingComandType::CloseOrStop),
+        WING_COMMAND("pulse", WingComandType::Pulse),
+        WING_COMMAND("Pulse", WingComandType::Pulse),
+        WING_COMMAND("pulseOrStop", WingComandType::PulseOrStop),
+        WING_COMMAND("PulseOrStop", WingComandType::PulseOrStop),
+        WING_COMMAND("pulseorstop", WingComandType::PulseOrStop),
+        WING_COMMAND("lock", WingComandType::Lock),
+        WING_COMMAND("Lock", WingComandType::Lock),
+        WING_COMMAND("setposition", WingComandType::SetPosition),
+        WING_COMMAND("setPosition", WingComandType::SetPosition),
+        WING_COMMAND("SetPosition", WingComandType::SetPosition),
+    };
+    #undef WING_COMMAND
+
+    WingComandType toWingCommand(const StringSpan & cmd) {
+        for (const auto & c : wingCommandNames) {
+            if (cmd.equals(c.name, c.length)) {
+                return c.command;
+            }
+        }
+        return WingComandType::Ignore;
+    }
+}
+
 WingData::WingData(const MqttData &mqttData) {
     // command parser
     _mqttData = mqttData;
-    auto getCommand = [this](const std::string& cmd) -> WingComandType {    
-        if(cmd=="open" || cmd=="Open"  ) {
-            return WingComandType::Open;
-        }
-        if(cmd=="openOrStop" || cmd=="OpenOrStop" || cmd=="openorstop"  ) {
-            return WingComandType::OpenOrStop;
-        }
-        if(cmd=="calibrate" || cmd=="Calibrate"  ) {
-            return WingComandType::Calibrate;
-        }
-        if(cmd=="cancel" || cmd=="Cancel"  ) {
-            return WingComandType::Cancel;
-        }
-        if(cmd=="stop" || cmd=="Stop"  ) {
-            return WingComandType::Stop;
-        }
-        if(cmd=="close" || cmd=="Close"  ) {
-            return WingComandType::Close;
-        }
-        if(cmd=="closeOrStop" || cmd=="CloseOrStop" || cmd=="closeorstop"  ) {
-            return WingComandType::CloseOrStop;
-        }
-        if(cmd=="pulse" || cmd=="Pulse"  ) {
-            return WingComandType::Pulse;
-        }
-        if(cmd=="pulseOrStop" || cmd=="PulseOrStop" || cmd=="pulseorstop"  ) {
-            return WingComandType::PulseOrStop;
-        }
-        if(cmd=="lock" || cmd=="Lock"  ) {
-            return WingComandType::Lock;
-        }
-        if(cmd=="setposition" || cmd=="setPosition"  || cmd.compare("SetPosition")==0  ) {
-            return WingComandType::SetPosition;
-        }        
-        return WingComandType::Ignore;
-    };
     // read the topic's info to get the id and the command
-    std::regex wing_regex("\\/wing\\/([^\\/]+)\\/([^\\/]+$)",std::regex_constants::ECMAScript | std::regex_constants::icase);
-    std::string topicStr = mqttData.getTopic();
-    std::smatch matches;
-    if(std::regex_search( topicStr, matches, wing_regex)) {
-        if ( matches.size() != 3) {
-            LOG_CRITICAL_THROW("Failed to parse MqttData to wingData!");    
-        }        
-        _id =  matches[1].str();
-        _wingCommand = getCommand(matches[2].str());
-    } else {
+    // Example : systemcontroller/<configId>/wing/<wingId>/open
+    StringSpan levels[3]; // wing, id, command
+    if (!TopicTokenizer::lastLevels(_mqttData.getTopic(), levels, 3) || !levels[0].equalsIgnoreCase(StringSpan("wing", 4))) {
         LOG_CRITICAL_THROW("Failed to parse MqttData to wingData!");
     }
-    
+    _id = levels[1].str();
+    _wingCommand = toWingCommand(levels[2]);
 }
 
 void WingData::parsePayload(const std::string& payload) {
@@ -16,22 +16,23 @@ void WingRelationManager::ManageMaleCorner  (
     std::shared_ptr<IPositionTrack> femaleWing
     ) const 
 {    
+    const SystemSettingsSnapshot & settings = *SystemSettings::getSnapshot();
     bool needToHoldTheFemale = false;
     // if this wing is FULLY closed the Male restriction of the exclusion zone is released
     if( femaleWing->getPosition() <=0 &&  femaleWing->getTarget() <=0 ) {
         pushZoneMaleWing->inActivate();
         needToHoldTheFemale = true;  
     // don't allow movement of female wing whitin corner zone when male is around 
-    } else if ( femaleWing->getPosition() <= SystemSettings::getInstance().getCornerZone()) { 
-        if ( maleWing->getPosition() <= SystemSettings::getInstance().getCornerZone()) {
-            pushZoneMaleWing->setMinOpening(SystemSettings::getInstance().getCornerZone() );   
+    } else if ( femaleWing->getPosition() <= settings.cornerZone) { 
+        if ( maleWing->getPosition() <= settings.cornerZone) {
+            pushZoneMaleWing->setMinOpening(settings.cornerZone );   
             needToHoldTheFemale = true;      
         }
     // male is free to move, this female is not in the corner 
     } else {   
-        if ( femaleWing->getPosition() <= SystemSettings::getInstance().getTriggerPushWingDistance() && femaleWing->getTarget()  <= SystemSettings::getInstance().getCornerZone()) {            
+        if ( femaleWing->getPosition() <= settings.triggerPushWingDistance && femaleWing->getTarget()  <= settings.cornerZone) {            
             // start pushing out of the way upfront to avoid stopping needed
-            pushZoneMaleWing->setMinOpening(SystemSettings::getInstance().getCornerZone() );                
+            pushZoneMaleWing->setMinOpening(settings.cornerZone );                
         }
         else {
             pushZoneMaleWing->inActivate();
@@ -51,24 +52,25 @@ void WingRelationManager::ManageFemaleCorner(
     std::shared_ptr<IPositionTrack> maleWing,
     std::shared_ptr<IPositionTrack> femaleWing) const
 {
+    const SystemSettingsSnapshot & settings = *SystemSettings::getSnapshot();
     bool needToHoldTheMale = false;
-    // this wing is the male and should push female close only if female is within SystemSettings::getInstance().getCornerZone()    
-    if ( maleWing->getPosition() <= SystemSettings::getInstance().getCornerZone())  { 
-        if(femaleWing->getPosition() <= SystemSettings::getInstance().getCornerZone() && femaleWing->getPosition() > 0) {
+    // this wing is the male and should push female close only if female is within the corner zone
+    if ( maleWing->getPosition() <= settings.cornerZone)  { 
+        if(femaleWing->getPosition() <= settings.cornerZone && femaleWing->getPosition() > 0) {
             needToHoldTheMale=true; // when female is not fully closed hold the male when entering cornerzone
         }
         pushZoneFemaleWing->inActivate();
-        if(femaleWing->getTarget() <= SystemSettings::getInstance().getCornerZone()) {
+        if(femaleWing->getTarget() <= settings.cornerZone) {
             pushZoneFemaleWing->setMaxOpening(0);
         }else {
-            pushZoneFemaleWing->setMinOpening(SystemSettings::getInstance().getCornerZone());
+            pushZoneFemaleWing->setMinOpening(settings.cornerZone);
         }
-    } else if ( maleWing->getPosition() < SystemSettings::getInstance().getTriggerPushWingDistance() && maleWing->getTarget() <= SystemSettings::getInstance().getCornerZone()) {        
+    } else if ( maleWing->getPosition() < settings.triggerPushWingDistance && maleWing->getTarget() <= settings.cornerZone) {        
         pushZoneFemaleWing->inActivate();
-         if(femaleWing->getTarget() <= SystemSettings::getInstance().getCornerZone()) {
+         if(femaleWing->getTarget() <= settings.cornerZone) {
             pushZoneFemaleWing->setMaxOpening(0);
         }else {
-            pushZoneFemaleWing->setMinOpening(SystemSettings::getInstance().getCornerZone());
+            pushZoneFemaleWing->setMinOpening(settings.cornerZone);
         }
     } else {
         pushZoneFemaleWing->inActivate();
@@ -94,23 +96,24 @@ void WingRelationManager::ManageOpposite  (
     bool isWingOnTarget
     ) const 
 {    
+    const SystemSettingsSnapshot & settings = *SystemSettings::getSnapshot();
     bool needToHold = false;
     
-    if (  tailDistanceToFullyCloseOfOtherWing - thisWing->getPosition() < SystemSettings::getInstance().getTriggerPushWingDistance() && thisWing->getPosition() < thisWing->getTarget()) {
+    if (  tailDistanceToFullyCloseOfOtherWing - thisWing->getPosition() < settings.triggerPushWingDistance && thisWing->getPosition() < thisWing->getTarget()) {
         // prevent collision
-        if ( tailDistanceToFullyCloseOfOtherWing - thisWing->getPosition() < SystemSettings::getInstance().getOppositeZone() ) {
+        if ( tailDistanceToFullyCloseOfOtherWing - thisWing->getPosition() < settings.oppositeZone ) {
             needToHold=true;
         }
 
         // when target is near other wing push it out of the way (start pushing when arriving at the other wing)        
-        if ( tailDistanceToFullyCloseOfOtherWing - thisWing->getTarget() < SystemSettings::getInstance().getOppositeZone()) {
-            int maxOpening = tailDistanceToFullyCloseOfOtherWing - (thisWing->getTarget() + SystemSettings::getInstance().getOppositeZone());
+        if ( tailDistanceToFullyCloseOfOtherWing - thisWing->getTarget() < settings.oppositeZone) {
+            int maxOpening = tailDistanceToFullyCloseOfOtherWing - (thisWing->getTarget() + settings.oppositeZone);
             pushZoneOtherWing->setMaxOpening(maxOpening);
         }
     }
     // when wing is pushed by opposite it looses its original target,  so when this wing is on target it can release the pushzone because
     // it will not go back. When the wing target is outside the collision zone there is no need to push
-    if (isWingOnTarget || (tailDistanceToFullyCloseOfOtherWing - thisWing->getTarget() > SystemSettings::getInstance().getOppositeZone() ) ){
+    if (isWingOnTarget || (tailDistanceToFullyCloseOfOtherWing - thisWing->getTarget() > settings.oppositeZone ) ){
         pushZoneOtherWing->inActivate();
     }
     // because there is no fixed value for fully closed that the tailDistanceToFullyCloseOfOtherWing can express there is a boolean used
@@ -6,20 +6,103 @@
 
 
 
-WingsHandler::WingsHandler(const std::string & configId , std::shared_ptr<IWingInputTranslator> inputTranslator) 
-: TopicHandler({"systemcontroller/"+configId+ "/wing/#"}) , _configId(configId) , _inputTranslator(inputTranslator) {
+const std::chrono::milliseconds WingsHandler::SweepInterval(1000);
 
+WingsHandler::WingsHandler(const std::string & configId , std::shared_ptr<IWingInputTranslator> inputTranslator, std::shared_ptr<ThreadPool> threadPool) 
+: TopicHandler({"systemcontroller/"+configId+ "/wing/#"}) , _configId(configId) , _dirtyWings(std::make_shared<DirtyWings>())
+, _threadPool(threadPool ? std::move(threadPool) : std::make_shared<ThreadPool>()), _inputTranslator(inputTranslator) {
+
+}
+WingsHandler::~WingsHandler() {
+    if (_workerThreadWingMovement.joinable()) {
+        stop();
+    }
 }
 // add a wing to the list to be hanlded with from MQTT
 std::string WingsHandler::addWing(const std::shared_ptr<IWing>& wing){
     std::lock_guard<std::mutex> guard(_wingsMap_mutex);
+    addWingLocked(wing);
+    return wing->getWingId();
+}
+
+void WingsHandler::addWingLocked(const std::shared_ptr<IWing>& wing) {
     if(_wings.find(wing->getWingId()) != _wings.end()) {
         LOG_ERROR("Wingshandler contains already wing " + wing->getWingId());
     }
     _wings.insert(std::pair<std::string,std::shared_ptr<IWing>>(wing->getWingId(),wing));
     LOG_TRACE("Added new wing to wingshandler: " + wing->getWingId());
     wing->setDelegateWingPublishOutput([&](const MqttData & data) {handleOutput(data);});
-    return wing->getWingId();
+
+    std::weak_ptr<DirtyWings> weakDirtyWings = _dirtyWings;
+    std::weak_ptr<IWing> weakWing = wing;
+    const std::string wingId = wing->getWingId();
+    MotorHandlers handlers;
+    handlers.motionManager = wing->getMasterWindow()->getMotionManager();
+    handlers.statusHandlerId = handlers.motionManager->addOnMotorStatusUpdatehandler([weakDirtyWings, wingId](MotorStatus) {
+        if (auto dirtyWings = weakDirtyWings.lock()) {
+            dirtyWings->mark(wingId);
+        }
+    });
+    // the own position is handled by the wing itself, the siblings can get in or out of a push zone
+    handlers.positionHandlerId = handlers.motionManager->addOnPositionUpdatehandler([weakDirtyWings, weakWing](int) {
+        auto dirtyWings = weakDirtyWings.lock();
+        auto wing = weakWing.lock();
+        if (!dirtyWings || !wing) {
+            return;
+        }
+        for (auto & sibling : *wing->getSiblings()) {
+            dirtyWings->mark(std::get<0>(sibling)->getWingId());
+        }
+    });
+    _motorHandlers.push_back(handlers);
+}
+
+void WingsHandler::replaceWings(const std::vector<std::shared_ptr<IWing>> & wings) {
+    std::map<std::string,std::shared_ptr<IWing>> oldWings;
+    std::map<std::string,std::shared_ptr<Strand>> oldStrands;
+    std::vector<MotorHandlers> oldMotorHandlers;
+    {
+        std::lock_guard<std::mutex> guard(_wingsMap_mutex);
+        std::swap(oldWings, _wings);
+        std::swap(oldStrands, _strands);
+        std::swap(oldMotorHandlers, _motorHandlers);
+        for (auto & w : oldWings) {
+            for (auto & motor : w.second->getMotors()) {
+                motor->getMotionManager()->setCallbackStrand(nullptr);
+            }
+        }
+        for (auto & wing : wings) {
+            addWingLocked(wing);
+        }
+        if (TopicHandler::isRunning()) {
+            assignStrandsLocked();
+        }
+    }
+    for (auto & handlers : oldMotorHandlers) {
+        handlers.motionManager->removeOnMotorStatusUpdatehandler(handlers.statusHandlerId);
+        handlers.motionManager->removeOnPositionUpdatehandler(handlers.positionHandlerId);
+    }
+    for (auto & s : oldStrands) {
+        s.second->waitUntilIdle();
+    }
+    LOG_INFO("Replaced " + std::to_string(oldWings.size()) + " wings by " + std::to_string(wings.size()) + " wings of configuration " + _configId);
+    for (auto & wing : wings) {
+        requestEvaluation(wing->getWingId());
+    }
+}
+
+void WingsHandler::requestEvaluation(const std::string & wingId) {
+    _dirtyWings->mark(wingId);
+}
+
+void WingsHandler::DirtyWings::mark(const std::string & wingId) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!wingIds.insert(wingId).second) {
+            return; // already waiting for the worker
+        }
+    }
+    cv.notify_one();
 }
 
 void WingsHandler::handleOutput(const MqttData & data) {
@@ -39,62 +122,147 @@ void WingsHandler::handleNewInput ( const MqttData & inputData) {
     //lookup if we have a wing registerd with that GUID
     std::string receivedWingId = wingData.getId();    
     if(_wings.find(receivedWingId) != _wings.end()) {
-        bool commandFound = true;
         auto wingSharedPtr = _wings[receivedWingId];
-        _inputTranslator->translateInputToAction(wingSharedPtr->getMasterWindow()->getMotionManager()->getMotorStatusData(),
-                                                wingSharedPtr->getPosition(),
-                                                wingSharedPtr->waslastMovementOpening(),                                                
-                                                wingData.getWingCommand(),
-                                                [& wingSharedPtr]() {wingSharedPtr->open();},
-                                                [& wingSharedPtr]() {wingSharedPtr->stop();},
-                                                [& wingSharedPtr]() {wingSharedPtr->close();},
-                                                [& wingSharedPtr]() {wingSharedPtr->startCalibrate();},
-                                                [& wingSharedPtr]() {wingSharedPtr->clearCalibration();},
-                                                [& wingSharedPtr]() {
-                                                    LOG_WARNING("LOCK is not implemented yet"); 
-                                                },
-                                                [& wingData, & commandFound, & wingSharedPtr]() {
-                                                    // position
-                                                    double posPerc = -1;
-                                                    int posMm = -1;
-                                                    wingData.getPosition(posPerc, posMm);
-                                                    if ( posPerc > 0) {
-                                                        wingSharedPtr->setPositionPerc(posPerc);    
-                                                    }
-                                                    else if ( posMm > 0) {
-                                                        wingSharedPtr->setPositionMm(posMm);    
-                                                    } else {
-                                                        LOG_WARNING("Missing valid positin parameters to do a SetPosition");
-                                                        commandFound = false;
-                                                    }
-                                                },
-                                                [& commandFound]() {commandFound = false;} // action done when no command found
-        );
-
-      
-        if ( commandFound) {
-            _pOutTypeBuffer->QueueNewMessage(wingData.getAck());
-        }
+        runForWing(receivedWingId, [this, wingSharedPtr, wingData, receivedWingId]() mutable {
+            bool commandFound = true;
+            _inputTranslator->translateInputToAction(wingSharedPtr->getMasterWindow()->getMotionManager()->getMotorStatusData(),
+                                                    wingSharedPtr->getPosition(),
+                                                    wingSharedPtr->waslastMovementOpening(),                                                
+                                                    wingData.getWingCommand(),
+                                                    [& wingSharedPtr]() {wingSharedPtr->open();},
+                                                    [& wingSharedPtr]() {wingSharedPtr->stop();},
+                                                    [& wingSharedPtr]() {wingSharedPtr->close();},
+                                                    [& wingSharedPtr]() {wingSharedPtr->startCalibrate();},
+                                                    [& wingSharedPtr]() {wingSharedPtr->clearCalibration();},
+                                                    [& wingSharedPtr]() {
+                                                        LOG_WARNING("LOCK is not implemented yet"); 
+                                                    },
+                                                    [& wingData, & commandFound, & wingSharedPtr]() {
+                                                        // position
+                                                        double posPerc = -1;
+                                                        int posMm = -1;
+                                                        wingData.getPosition(posPerc, posMm);
+                                                        if ( posPerc > 0) {
+                                                            wingSharedPtr->setPositionPerc(posPerc);    
+                                                        }
+                                                        else if ( posMm > 0) {
+                                                            wingSharedPtr->setPositionMm(posMm);    
+                                                        } else {
+                                                            LOG_WARNING("Missing valid positin parameters to do a SetPosition");
+                                                            commandFound = false;
+                                                        }
+                                                    },
+                                                    [& commandFound]() {commandFound = false;} // action done when no command found
+            );
+
+            if ( commandFound) {
+                _pOutTypeBuffer->QueueNewMessage(wingData.getAck());
+                requestEvaluation(receivedWingId);
+            }
+        });
     }        
 }
-// regulary check all wings, one wing can cause another wing to be able to move!
-void WingsHandler::evaluateAllWings() {
+
+void WingsHandler::runForWing(const std::string & wingId, std::function<void()> work) {
+    auto strand = _strands.find(wingId);
+    if (strand != _strands.end()) {
+        strand->second->post(std::move(work));
+    } else {
+        work();
+    }
+}
+
+// wings that are siblings read each others state, they share one strand
+void WingsHandler::assignStrands() {
+    std::lock_guard<std::mutex> guard(_wingsMap_mutex);
+    assignStrandsLocked();
+}
+
+void WingsHandler::assignStrandsLocked() {
+    _strands.clear();
+    for (auto & w : _wings) {
+        if (_strands.count(w.first) > 0) {
+            continue;
+        }
+        auto strand = std::make_shared<Strand>(_threadPool);
+        std::vector<std::shared_ptr<IWing>> toVisit = {w.second};
+        while (!toVisit.empty()) {
+            auto wing = toVisit.back();
+            toVisit.pop_back();
+            if (!_strands.insert(std::make_pair(wing->getWingId(), strand)).second) {
+                continue; // already visited
+            }
+            for (auto & motor : wing->getMotors()) {
+                motor->getMotionManager()->setCallbackStrand(strand);
+            }
+            for (auto & sibling : *wing->getSiblings()) {
+                auto siblingWing = _wings.find(std::get<0>(sibling)->getWingId());
+                if (siblingWing != _wings.end()) {
+                    toVisit.push_back(siblingWing->second);
+                }
+            }
+        }
+    }
+}
+
+void WingsHandler::releaseStrands() {
+    std::map<std::string,std::shared_ptr<Strand>> strands;
+    {
+        std::lock_guard<std::mutex> guard(_wingsMap_mutex);
+        std::swap(strands, _strands);
+        for (auto & w : _wings) {
+            for (auto & motor : w.second->getMotors()) {
+                motor->getMotionManager()->setCallbackStrand(nullptr);
+            }
+        }
+    }
+    // work posted before the motors were released still has to finish
+    for (auto & s : strands) {
+        s.second->waitUntilIdle();
+    }
+}
+// one wing can cause another wing to be able to move, the marked wings are evaluated as soon as possible
+void WingsHandler::evaluateDirtyWings() {
     LOG_DEBUG("Wingshandler updateMovement evaluation started");
-    while(_isUpdateWingMovementRunning) {
+    std::vector<std::string> wingIds;
+    auto nextSweep = std::chrono::steady_clock::now() + SweepInterval;
+    while (true) {
+        wingIds.clear();
         {
-            std::lock_guard<std::mutex> guard(_wingsMap_mutex);
-            for ( auto &w : _wings) {
-                w.second->updateWingMovement();
+            std::unique_lock<std::mutex> lock(_dirtyWings->mutex);
+            _dirtyWings->cv.wait_until(lock, nextSweep, [this]() {return !_dirtyWings->isRunning || !_dirtyWings->wingIds.empty();});
+            if (!_dirtyWings->isRunning) {
+                break;
+            }
+            wingIds.assign(_dirtyWings->wingIds.begin(), _dirtyWings->wingIds.end());
+            _dirtyWings->wingIds.clear();
+        }
+        std::lock_guard<std::mutex> guard(_wingsMap_mutex);
+        if (std::chrono::steady_clock::now() >= nextSweep) {
+            nextSweep = std::chrono::steady_clock::now() + SweepInterval;
+            wingIds.clear();
+            for (auto & w : _wings) {
+                wingIds.push_back(w.first);
+            }
+        }
+        for (auto & wingId : wingIds) {
+            auto wing = _wings.find(wingId);
+            if (wing != _wings.end()) {
+                std::shared_ptr<IWing> wingSharedPtr = wing->second;
+                runForWing(wingId, [wingSharedPtr]() {wingSharedPtr->updateWingMovement();});
             }
         }
-        std::this_thread::sleep_for(std::chrono::milliseconds(200));
     }
 }
 
 void WingsHandler::start() { 
+    assignStrands();
     TopicHandler::start() ;
-    _isUpdateWingMovementRunning = true;
-    _workerThreadWingMovement = std::thread(&WingsHandler::evaluateAllWings, this);
+    {
+        std::lock_guard<std::mutex> lock(_dirtyWings->mutex);
+        _dirtyWings->isRunning = true;
+    }
+    _workerThreadWingMovement = std::thread(&WingsHandler::evaluateDirtyWings, this);
 
     LOG_DEBUG("WingsHandler started");
     // show all connected wings on start 
@@ -109,16 +277,21 @@ void WingsHandler::start() {
 }
 
 void WingsHandler::stop() { 
-     if ((!_isUpdateWingMovementRunning)  && (!TopicHandler::isRunning())) {
+     if ((!_workerThreadWingMovement.joinable())  && (!TopicHandler::isRunning())) {
             LOG_WARNING("Wingshandler stop called when already completely stopped");
     } else {
-        _isUpdateWingMovementRunning = false;
+        {
+            std::lock_guard<std::mutex> lock(_dirtyWings->mutex);
+            _dirtyWings->isRunning = false;
+        }
+        _dirtyWings->cv.notify_all();
         if (_workerThreadWingMovement.joinable()) {
             _workerThreadWingMovement.join();
         }
         LOG_DEBUG("Wingshandler updateMovement worker stopped");
     }
-
     TopicHandler::stop() ;
+    releaseStrands();
+
     LOG_DEBUG("WingsHandler stopped");
 }
\ No newline at end of file
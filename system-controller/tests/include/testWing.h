@@ -1,6 +1,7 @@
 #ifndef TESTWING_H
 #define TESTWING_H
 
+#include <atomic>
 #include "wing.h"
 #include "verifier.h"
 #include "windowPushZone.h"
@@ -23,18 +24,21 @@ class TestWing : public IWing, public Verifier {
         bool hasCalibratedMotors() override {return false;}
         void clearCalibration() override {}
         const virtual std::string getWingId() const override {return _wingName;}
+        void setWingId(const std::string & wingId) override {_wingName = wingId;}
         int getPosition() override;
         int getTarget() override;
         bool waslastMovementOpening() const override { return _wasLastMovementOpening;}
         void addSibling(std::shared_ptr<IWing> sibling, WingSiblingType siblingType) override;
         std::shared_ptr<MasterMotorizedWindow> getMasterWindow() const override ;
-        const std::vector<std::shared_ptr<MotorizedWindow>> getMotors() const override;
+        const std::vector<std::shared_ptr<MotorizedWindow>> & getMotors() const override;
         const std::shared_ptr<IWindowPushZone> getCornerPushZone() const override {return _currentCornerPushZone;}
         const std::shared_ptr<IWindowPushZone> getOppositePushZone() const override {return _currentOppositePushZone;}
         const virtual std::shared_ptr<std::vector<std::tuple<std::shared_ptr<IWing>,WingSiblingType>>> getSiblings() const override ;
         void setDelegateWingPublishOutput(std::function<void(MqttData)> delegatePublishOutput) {};
         void updateWingMovement() override;
         void SetFullSetupCalibDone() override{};
+        // updateWingMovement is called from the evaluation worker of the wingsHandler
+        int getNumberOfEvaluations() const {return _evaluations;}
     private : 
         int _fakePos=0;
         int _fakeStroke=0;
@@ -43,6 +47,8 @@ class TestWing : public IWing, public Verifier {
         std::shared_ptr<IWindowPushZone> _currentCornerPushZone;
         std::shared_ptr<IWindowPushZone> _currentOppositePushZone;
         bool _wasLastMovementOpening = true;
+        std::shared_ptr<std::vector<std::tuple<std::shared_ptr<IWing>,WingSiblingType>>> _siblings;
+        std::atomic<int> _evaluations {0};
 
 };
 
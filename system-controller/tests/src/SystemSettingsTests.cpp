@@ -47,4 +47,22 @@ TEST(systemSettings,testSetters ){
     SystemSettings::getInstance().setTriggerPushWingDistance(aboveMax); 
     ASSERT_NE(aboveMax,SystemSettings::getInstance().getTriggerPushWingDistance()) << "Maximum boudry should be hit";
 
-}
\ No newline at end of file
+}
+TEST(systemSettings,snapshots ){
+    Log::Init();
+    auto & sut = SystemSettings::getInstance();
+    const SystemSettingsSnapshot * before = SystemSettings::getSnapshot();
+    const SystemSettingsSnapshot original = *before;
+
+    SystemSettingsSnapshot changed = original;
+    changed.chicanZone = 700;
+    changed.slowdownDist = 5;
+    sut.setSettings(changed);
+    EXPECT_NE(SystemSettings::getSnapshot(), before) << "a change publishes a new snapshot";
+    EXPECT_EQ(before->chicanZone, original.chicanZone) << "a snapshot that is in use never changes";
+    EXPECT_EQ(sut.getChicanZone(), 700);
+    EXPECT_EQ(sut.getSlowdownDist(), 150) << "the values are clamped before they are published";
+
+    sut.setSettings(original);
+    EXPECT_EQ(sut.getChicanZone(), original.chicanZone);
+}
@@ -0,0 +1,192 @@
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <vector>
+#include <string>
+
+#include "log.h"
+#include "motorData.h"
+#include "motorMotionManager.h"
+#include "motorsHandler.h"
+#include "mqttManager.h"
+#include "mosquittoTransport.h"
+#include "topicHandler.h"
+
+// Counts the heap allocations done by the current thread, so the hot paths can be
+// verified to be allocation free after warm-up. Replaces the global operator new of the test binary.
+namespace {
+    thread_local std::size_t allocationCount = 0;
+
+    struct AllocationCounter {
+        AllocationCounter() : _start(allocationCount) {}
+        std::size_t count() const { return allocationCount - _start;}
+        std::size_t _start;
+    };
+
+    class CountingMotor : public IMqttMotor {
+        public:
+            explicit CountingMotor(const std::string & id) : _id(id) {}
+            void onMotorInput(const MotorData & data) override { inputCount++;}
+            void onMotorConnected() override {}
+            void onMotorDisconnected() override {}
+            void setDelegateMotorOutput(std::function<void(MqttData)> delegateMotorOutput) override {}
+            std::string getId() const override { return _id;}
+            int inputCount = 0;
+        private:
+            std::string _id;
+    };
+
+    // the status updates of a motor without a strand, the handlers are called directly
+    class DirectMotionManager : public MotorMotionManager {
+        public:
+            void setHighSpeed() override {}
+            void setLowSpeed() override {}
+            int getLowSpeed() const override {return 50;}
+            void stop() override {}
+            void close() override {}
+            void open() override {}
+            int getStroke() const override {return 2000;}
+            std::future<bool> clearCalibration() override {return std::future<bool>();}
+            MotorStatusData getMotorStatusData() const override {return MotorStatusData();}
+            bool isCalibrated() const override {return true;}
+            bool getIsConfigured() const override {return true;}
+            void update(const MotorStatusData & data) {updateMotionData(data);}
+    };
+
+    mosquitto_message createMessage(const std::string & topic, const std::string & payload) {
+        mosquitto_message msg;
+        msg.mid = 0;
+        msg.topic = const_cast<char *>(topic.c_str());
+        msg.payload = const_cast<char *>(payload.c_str());
+        msg.payloadlen = payload.size();
+        msg.qos = 0;
+        msg.retain = false;
+        return msg;
+    }
+}
+
+void * operator new(std::size_t size) {
+    allocationCount++;
+    void * p = std::malloc(size == 0 ? 1 : size);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+void operator delete(void * p) noexcept {
+    std::free(p);
+}
+
+TEST(Allocations,mqttDataCopy ){
+    Log::Init();
+    const std::string topic = "rbus/0628252/0000000000001/rbus.get.status/result";
+    const std::string payload = "{\"results\":\"12,1000,50,false,false,true,34,20,false,false,false,false,true,false\"}";
+    const MqttData warmUp(topic, payload);
+    {
+        MqttData releasedToPool(topic, payload);
+    }
+
+    AllocationCounter counter;
+    for (int i = 0; i < 100; ++i) {
+        MqttData data(topic, payload);
+        MqttData copy = data;
+        EXPECT_EQ(&copy.getPayload(), &data.getPayload()) << "a copy should share the payload";
+        EXPECT_EQ(&copy.getTopic(), &warmUp.getTopic()) << "the topic should be interned";
+    }
+    EXPECT_EQ(counter.count(), 0u);
+}
+
+TEST(Allocations,statusMessageToTopicHandlers ){
+    Log::Init();
+    auto motors = std::make_shared<TopicHandler>(std::vector<std::string>{"rbus/#"});
+    auto wings = std::make_shared<TopicHandler>(std::vector<std::string>{"systemcontroller/#"});
+    auto statusOnly = std::make_shared<TopicHandler>(std::vector<std::string>{"rbus/+/+/rbus.get.status/result"});
+    auto transport = std::make_shared<MosquittoTransport>("localhost", 1883, "allocationTests");
+    MqttManager mqtt(transport, {motors, wings, statusOnly});
+
+    const std::string topic = "rbus/0628252/0000000000001/rbus.get.status/result";
+    const std::string payload = "{\"results\":\"12,1000,50,false,false,true,34,20,false,false,false,false,true,false\"}";
+    const mosquitto_message msg = createMessage(topic, payload);
+
+    std::vector<MqttData> received;
+    auto receiveAll = [&]() {
+        received.clear();
+        motors->getInputBuffer()->UnqueueAll(received);
+        statusOnly->getInputBuffer()->UnqueueAll(received);
+        wings->getInputBuffer()->UnqueueAll(received);
+        return received.size();
+    };
+    // warm-up: pool, intern table and the capacity of the receive vector
+    for (int i = 0; i < 10; ++i) {
+        transport->on_message(&msg);
+    }
+    EXPECT_EQ(receiveAll(), 20u);
+    received.clear();
+
+    AllocationCounter counter;
+    std::size_t total = 0;
+    for (int i = 0; i < 1000; ++i) {
+        transport->on_message(&msg);
+        total += receiveAll();
+    }
+    EXPECT_EQ(counter.count(), 0u) << "receiving a status message should not allocate after warm-up";
+    EXPECT_EQ(total, 2000u);
+}
+
+TEST(Allocations,motorDataParsing ){
+    Log::Init();
+    const MqttData status("rbus/0628252/0000000000001/rbus.get.status/result", "{\"results\":\"12,1000,50,false,false,true,34,20,false,false,false,false,true,false\"}");
+
+    AllocationCounter counter;
+    for (int i = 0; i < 100; ++i) {
+        MotorData motorData(status);
+        EXPECT_TRUE(motorData.getMotorCommand() == MotorCommand::GetStatus);
+        EXPECT_TRUE(motorData.getIdSpan() == StringSpan("0628252/0000000000001", 21));
+        MotorStatusData statusData;
+        motorData.parseStatusData(statusData);
+        EXPECT_EQ(statusData.posMm, 12);
+    }
+    EXPECT_EQ(counter.count(), 0u) << "parsing the topic and the status should not allocate";
+}
+
+TEST(Allocations,motorsHandlerDispatch ){
+    Log::Init();
+    MotorsHandler sut;
+    std::vector<std::shared_ptr<CountingMotor>> motors;
+    for (int i = 0; i < 40; ++i) {
+        std::string serial = std::to_string(i);
+        motors.push_back(std::make_shared<CountingMotor>("0628252/" + std::string(13 - serial.size(), '0') + serial));
+        sut.addMotor(motors.back());
+    }
+    const MqttData status("rbus/0628252/0000000000007/rbus.get.status/result", "{\"results\":\"12,1000,50,false,false,true,34,20,false,false,false,false,true,false\"}");
+
+    AllocationCounter counter;
+    for (int i = 0; i < 100; ++i) {
+        sut.handleNewInput(status);
+    }
+    EXPECT_EQ(counter.count(), 0u) << "dispatching to a motor should not allocate";
+    EXPECT_EQ(motors[7]->inputCount, 100);
+}
+
+TEST(Allocations,motorStatusHandlers ){
+    Log::Init();
+    DirectMotionManager sut;
+    int positions = 0;
+    int statusChanges = 0;
+    sut.addOnPositionUpdatehandler([&positions](int) {positions++;});
+    sut.addOnPositionUpdatehandler([&positions](int) {positions++;});
+    sut.addOnMotorStatusUpdatehandler([&statusChanges](MotorStatus) {statusChanges++;});
+    MotorStatusData moving;
+    moving.speedMm = 30;
+    MotorStatusData closed;
+    closed.isClosed = true;
+
+    AllocationCounter counter;
+    for (int i = 0; i < 100; ++i) {
+        sut.update(i % 2 == 0 ? moving : closed);
+    }
+    EXPECT_EQ(counter.count(), 0u) << "calling the handlers of a status update should not allocate";
+    EXPECT_EQ(positions, 200);
+    EXPECT_EQ(statusChanges, 100);
+}
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+#include <string>
+#include <thread>
+
+#include "buffer.h"
+#include "ringBuffer.h"
+#include "log.h"
+
+typedef Buffer<int, RingBuffer<int>> IntRingBuffer;
+
+TEST(RingBuffer,basics ){
+    RingBuffer<int> sut(3);
+    EXPECT_EQ(sut.capacity(), 4u) << "capacity should be rounded up to a power of two";
+    EXPECT_TRUE(sut.empty());
+
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(sut.tryPush(std::move(i)));
+    }
+    int value = 99;
+    EXPECT_FALSE(sut.tryPush(std::move(value))) << "a full ring should refuse new values";
+    EXPECT_EQ(value, 99) << "a refused value should not be moved from";
+    EXPECT_EQ(sut.size(), 4u);
+
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(sut.tryPop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(sut.tryPop(value));
+}
+
+TEST(Buffer,dropOldest ){
+    Log::Init();
+    IntRingBuffer sut(4, OverflowPolicy::DropOldest);
+    for (int i = 0; i < 6; ++i) {
+        sut.QueueNewMessage(i);
+    }
+    EXPECT_EQ(sut.GetSize(), 4u);
+    EXPECT_EQ(sut.GetDroppedCount(), 2u);
+
+    std::vector<int> messages;
+    EXPECT_EQ(sut.UnqueueAll(messages), 4u);
+    EXPECT_EQ(messages, std::vector<int>({2,3,4,5})) << "the oldest messages should be dropped";
+}
+
+TEST(Buffer,blockUntilRoom ){
+    Log::Init();
+    IntRingBuffer sut(2, OverflowPolicy::Block);
+    sut.QueueNewMessage(0);
+    sut.QueueNewMessage(1);
+
+    std::thread producer([&sut]() { sut.QueueNewMessage(2);});
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(sut.GetSize(), 2u) << "the producer should wait on a full buffer";
+
+    int value;
+    EXPECT_EQ(sut.UnqueueMessage(value), 1);
+    EXPECT_EQ(value, 0);
+    producer.join();
+
+    std::vector<int> messages;
+    sut.UnqueueAll(messages);
+    EXPECT_EQ(messages, std::vector<int>({1,2}));
+    EXPECT_EQ(sut.GetDroppedCount(), 0u);
+}
+
+TEST(Buffer,moveOnly ){
+    Log::Init();
+    Buffer<std::unique_ptr<int>, RingBuffer<std::unique_ptr<int>>> sut(8);
+    sut.QueueNewMessage(std::unique_ptr<int>(new int(5)));
+
+    std::unique_ptr<int> value;
+    EXPECT_EQ(sut.UnqueueMessage(value), 1);
+    ASSERT_TRUE(value != nullptr);
+    EXPECT_EQ(*value, 5);
+}
+
+TEST(Buffer,multipleProducers ){
+    Log::Init();
+    const int producerCount = 4;
+    const int messagesPerProducer = 10000;
+    IntRingBuffer sut(64, OverflowPolicy::Block);
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < producerCount; ++p) {
+        producers.push_back(std::thread([&sut, p]() {
+            for (int i = 0; i < messagesPerProducer; ++i) {
+                sut.QueueNewMessage(p * messagesPerProducer + i);
+            }
+        }));
+    }
+
+    std::vector<int> lastPerProducer(producerCount, -1);
+    std::vector<int> messages;
+    int received = 0;
+    bool inOrder = true;
+    while (received < producerCount * messagesPerProducer) {
+        messages.clear();
+        if (sut.UnqueueAll(messages) == 0) {
+            sut.WaitForMessage(std::chrono::milliseconds(100));
+        }
+        for (auto m : messages) {
+            const int p = m / messagesPerProducer;
+            inOrder = inOrder && (m > lastPerProducer[p]);
+            lastPerProducer[p] = m;
+        }
+        received += messages.size();
+    }
+    for (auto & t : producers) {
+        t.join();
+    }
+    EXPECT_TRUE(inOrder) << "messages of one producer should stay in order";
+    EXPECT_EQ(sut.GetDroppedCount(), 0u);
+    EXPECT_EQ(sut.GetSize(), 0u);
+}
+
+TEST(Buffer,notifier ){
+    Log::Init();
+    auto notifier = std::make_shared<BufferNotifier>();
+    IntRingBuffer sut(8);
+    sut.SetNotifier(notifier);
+
+    EXPECT_FALSE(notifier->waitFor(std::chrono::milliseconds(10)));
+    sut.QueueNewMessage(1);
+    EXPECT_TRUE(notifier->waitFor(std::chrono::milliseconds(10))) << "a notify before waiting should not be lost";
+    EXPECT_FALSE(notifier->waitFor(std::chrono::milliseconds(10)));
+}
@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+#include <string>
+
+#include "callbackList.h"
+
+TEST(CallbackList,callInSlotOrder ){
+    CallbackList<void(int), 4> sut;
+    std::string calls;
+    const int first = sut.add([&calls](int v) {calls += "a" + std::to_string(v);});
+    sut.add([&calls](int v) {calls += "b" + std::to_string(v);});
+    sut(1);
+    EXPECT_EQ(calls, "a1b1");
+
+    sut.remove(first);
+    sut.add([&calls](int v) {calls += "c" + std::to_string(v);});
+    calls.clear();
+    sut(2);
+    EXPECT_EQ(calls, "c2b2") << "the lowest free slot is taken again, like the lowest free id before";
+    EXPECT_EQ(sut.size(), 2u);
+}
+
+TEST(CallbackList,staleIds ){
+    CallbackList<void(), 2> sut;
+    int calls = 0;
+    const int removed = sut.add([&calls]() {calls += 1;});
+    sut.remove(removed);
+    const int reused = sut.add([&calls]() {calls += 10;});
+    EXPECT_NE(reused, removed) << "same slot, other generation";
+
+    sut.remove(removed);
+    sut.remove(-1);
+    sut();
+    EXPECT_EQ(calls, 10) << "a stale id does not remove the handler that reuses its slot";
+
+    sut.add([]() {});
+    EXPECT_THROW(sut.add([]() {}), std::length_error);
+}
+
+TEST(CallbackList,removeWhileCalled ){
+    CallbackList<void(), 4> sut;
+    int secondId = -1;
+    int calls = 0;
+    sut.add([&]() {calls++; sut.remove(secondId);});
+    secondId = sut.add([&calls]() {calls += 100;});
+    sut();
+    EXPECT_EQ(calls, 1) << "a handler removed by an earlier one is not called anymore";
+    EXPECT_TRUE(sut.size() == 1 && !sut.empty());
+}
@@ -3,6 +3,7 @@
 #include <vector>
 #include <string>
 #include <cmath>
+#include <atomic>
 #include "log.h"
 
 #include "commandsManager.h"
@@ -85,3 +86,48 @@ TEST(commandsManager,handleAck ){
     EXPECT_TRUE(true);
 }
 
+
+TEST(commandsManager,resendTiming ){
+    Log::Init();
+    CommandsManager sut;
+    std::mutex mutex;
+    std::vector<std::chrono::system_clock::time_point> sendTimes;
+    sut.setSendHandler([&](MqttData d) {
+        std::lock_guard<std::mutex> lock(mutex);
+        sendTimes.push_back(std::chrono::system_clock::now());
+    });
+    sut.startEvaluating();
+    MqttData dataMove("rbus/0628252/0000000000001/rbus.close/trigger","id" );
+    sut.pushCommandoToBeSend(dataMove,CommandType::SetMovement);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1450));
+    sut.stopEvaluating();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    // resends are relative to the first publish: 400 + n*150 ms, slowed down with (n/4)*200 ms from the 5th resend
+    const std::vector<int> expectedMs = {0, 400, 550, 700, 850, 1000, 1350};
+    ASSERT_EQ(sendTimes.size(), expectedMs.size());
+    for (std::size_t i = 1; i < sendTimes.size(); ++i) {
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(sendTimes[i] - sendTimes[0]).count();
+        EXPECT_GE(ms, expectedMs[i]) << "resend " << i;
+        EXPECT_LE(ms, expectedMs[i] + 40) << "resend " << i << " should be on time";
+    }
+}
+
+TEST(commandsManager,resendSingleParam ){
+    Log::Init();
+    CommandsManager sut;
+    std::atomic<int> sendCounter(0);
+    sut.setSendHandler([& sendCounter](MqttData d) {
+        sendCounter++;
+    });
+    sut.startEvaluating();
+    MqttData data("rbus/0628252/0000000000001/rbus.set.speed/trigger",35,"id" );
+    sut.pushCommandoToBeSend(data,CommandType::SetParam);
+    std::this_thread::sleep_for(std::chrono::milliseconds(600));
+    EXPECT_EQ(sendCounter,3) <<"A single set command that is not acked should be resend as well";
+
+    sut.handleAck(data);
+    std::this_thread::sleep_for(std::chrono::milliseconds(400));
+    EXPECT_EQ(sendCounter,3) <<"The ack should cancel the resend";
+    sut.stopEvaluating();
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include "log.h"
+#include "utils.h"
+
+#include "configurationHost.h"
+#include "systemSettings.h"
+
+namespace {
+    std::string readConfig(const std::string & fileName) {
+        std::ifstream f(utils::getApplicationDirectory() + "/testData/" + fileName);
+        std::ostringstream ss;
+        ss << f.rdbuf();
+        return ss.str();
+    }
+    std::string replaceAll(std::string text, const std::string & from, const std::string & to) {
+        for (std::size_t pos = text.find(from); pos != std::string::npos; pos = text.find(from, pos + to.size())) {
+            text.replace(pos, from.size(), to);
+        }
+        return text;
+    }
+    std::set<std::string> getMotorIds(const std::vector<std::shared_ptr<IWing>> & wings) {
+        std::set<std::string> ids;
+        for (auto & wing : wings) {
+            for (auto & motor : wing->getMotors()) {
+                ids.insert(motor->getMotionManager()->getId());
+            }
+        }
+        return ids;
+    }
+}
+
+TEST(ConfigurationHost,multipleConfigurations ){
+    Log::Init();
+    ConfigurationHost sut;
+    const std::string config = readConfig("XvX_test.json");
+    const std::string configA = replaceAll(config, "configTest", "configA");
+    const std::string configB = replaceAll(replaceAll(config, "configTest", "configB"), "0628253", "0628254");
+
+    EXPECT_EQ(sut.addConfiguration(configA), "configA");
+    EXPECT_EQ(sut.addConfiguration(configB), "configB");
+    EXPECT_EQ(sut.getConfigurationIds(), std::vector<std::string>({"configA", "configB"}));
+    EXPECT_EQ(sut.getWings("configA").size(), 2u);
+    EXPECT_EQ(sut.getWings("configB").size(), 2u);
+
+    auto topicHandlers = sut.getTopicHandlers();
+    ASSERT_EQ(topicHandlers.size(), 5u) << "one shared motorsHandler, a wingsHandler per configuration, the reload and the diagnostics handler";
+    EXPECT_EQ(topicHandlers[0], sut.getMotorsHandler());
+    EXPECT_TRUE(sut.getWingsHandler("configA")->isTopicValidForHandling("systemcontroller/configA/wing/wing1/open"));
+    EXPECT_FALSE(sut.getWingsHandler("configA")->isTopicValidForHandling("systemcontroller/configB/wing/wing1/open"));
+
+    EXPECT_ANY_THROW(sut.addConfiguration(configA)) << "a configId can only be hosted once";
+    const std::string configC = replaceAll(config, "configTest", "configC");
+    EXPECT_ANY_THROW(sut.addConfiguration(configC)) << "the motors are already used by configA";
+    EXPECT_EQ(sut.getConfigurationIds().size(), 2u) << "a rejected configuration should not be added";
+    EXPECT_ANY_THROW(sut.getWings("configC"));
+}
+
+TEST(ConfigurationHost,listConfigFiles ){
+    auto files = ConfigurationHost::listConfigFiles(utils::getApplicationDirectory() + "/testData");
+    ASSERT_EQ(files.size(), 5u);
+    EXPECT_TRUE(std::is_sorted(files.begin(), files.end()));
+    EXPECT_EQ(files[0], utils::getApplicationDirectory() + "/testData/QOX-XXQ_test.json");
+    EXPECT_TRUE(ConfigurationHost::listConfigFiles(utils::getApplicationDirectory() + "/noConfigs").empty());
+}
+
+TEST(ConfigurationHost,reload ){
+    Log::Init();
+    // the settings are process wide, restored for the other tests
+    auto & settings = SystemSettings::getInstance();
+    const std::vector<int> originalSettings = {settings.getChicanOverlap(), settings.getChicanZone(), settings.getSlowdownDist(),
+        settings.getCornerZone(), settings.getOppositeZone(), settings.getTriggerPushWingDistance()};
+    ConfigurationHost sut;
+    const std::string config = readConfig("settings_test.json");
+    sut.addConfiguration(config);
+    const auto wings = sut.getWings("configTest");
+
+    EXPECT_FALSE(sut.reloadConfiguration(replaceAll(config, "\"slowdowndist\": 203", "\"slowdowndist\": 250")));
+    EXPECT_EQ(settings.getSlowdownDist(), 250);
+    EXPECT_EQ(sut.getWings("configTest"), wings) << "same elements and motors, the wings are kept";
+
+    EXPECT_TRUE(sut.reloadConfiguration(replaceAll(config, "0000000000003", "0000000000004")));
+    const auto reloaded = sut.getWings("configTest");
+    ASSERT_EQ(reloaded.size(), wings.size());
+    for (std::size_t i = 0; i < wings.size(); ++i) {
+        EXPECT_NE(reloaded[i], wings[i]);
+        EXPECT_EQ(reloaded[i]->getMasterWindow()->getMotionManager(), wings[i]->getMasterWindow()->getMotionManager()) << "the motor is taken over";
+        EXPECT_EQ(reloaded[i]->getWingId(), wings[i]->getWingId()) << "a wing on the same master motor keeps its id";
+    }
+    EXPECT_EQ(getMotorIds(reloaded), std::set<std::string>({"0628253/0000000000001", "0628253/0000000000002", "0628253/0000000000004"}));
+
+    EXPECT_ANY_THROW(sut.reloadConfiguration(replaceAll(config, "configTest", "unknownConfig")));
+    EXPECT_ANY_THROW(sut.reloadConfiguration(replaceAll(config, "\"type\": \"-\"", "\"type\": \"?\"")));
+    EXPECT_EQ(sut.getWings("configTest"), reloaded) << "a failed reload keeps the running configuration";
+
+    // over MQTT, the payload has to be the configuration of the topic
+    auto reloadHandler = sut.getTopicHandlers().back();
+    reloadHandler->start();
+    reloadHandler->queueInput(MqttData("systemcontroller/otherConfig/config/reload", config));
+    reloadHandler->queueInput(MqttData("systemcontroller/configTest/config/reload", config));
+    std::vector<MqttData> results;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (results.size() < 2 && std::chrono::steady_clock::now() < deadline) {
+        reloadHandler->getOutputBuffer()->WaitForMessage(std::chrono::milliseconds(10));
+        reloadHandler->getOutputBuffer()->UnqueueAll(results);
+    }
+    reloadHandler->stop();
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_EQ(results[0].getTopic(), "systemcontroller/otherConfig/config/reload/result");
+    EXPECT_EQ(results[0].getPayload(), "{\"result\":\"failed\"}");
+    EXPECT_EQ(results[1].getPayload(), "{\"result\":\"rebuilt\"}");
+    EXPECT_EQ(getMotorIds(sut.getWings("configTest")).count("0628253/0000000000003"), 1u);
+    settings.setChicanOverlap(originalSettings[0]);
+    settings.setChicanZone(originalSettings[1]);
+    settings.setSlowdownDist(originalSettings[2]);
+    settings.setCornerZone(originalSettings[3]);
+    settings.setOppositeZone(originalSettings[4]);
+    settings.setTriggerPushWingDistance(originalSettings[5]);
+}
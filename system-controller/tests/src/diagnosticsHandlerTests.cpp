@@ -0,0 +1,43 @@
+#include <gtest/gtest.h>
+#include <string>
+
+#include "diagnosticsHandler.h"
+#include "log.h"
+
+namespace {
+    // the result of the handler for one message
+    std::string handle(DiagnosticsHandler & sut, const std::string & payload) {
+        sut.queueInput(MqttData("systemcontroller/configTest/diag/loglevel", payload));
+        MqttData result;
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        while (!sut.getOutputBuffer()->UnqueueMessage(result) && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        EXPECT_EQ(result.getTopic(), "systemcontroller/configTest/diag/loglevel/result");
+        return result.getPayload();
+    }
+}
+
+TEST(DiagnosticsHandler, changeLogLevels) {
+    Log::Init();
+    DiagnosticsHandler sut;
+    sut.start();
+    const std::string result = handle(sut, "{\"level\":\"info\",\"subsystems\":{\"motor\":\"debug\",\"commands\":\"warning\"},\"rateLimit\":{\"messages\":3,\"periodMs\":500}}");
+    EXPECT_NE(result.find("\"result\":\"ok\""), std::string::npos) << result;
+    EXPECT_EQ(Log::GetLogger()->level(), spdlog::level::info);
+    EXPECT_EQ(Log::getLevel(Log::Motor), spdlog::level::debug);
+    EXPECT_EQ(Log::getLevel(Log::Commands), spdlog::level::warn);
+    EXPECT_EQ(Log::getLevel(Log::Wing), spdlog::level::trace);
+    EXPECT_EQ(Log::getRateLimiter().getMessagesPerPeriod(), 3u);
+    EXPECT_EQ(Log::getRateLimiter().getPeriod(), std::chrono::milliseconds(500));
+    EXPECT_NE(handle(sut, "").find("\"motor\":\"debug\""), std::string::npos) << "an empty payload only reports";
+
+    // nothing of an invalid message is applied
+    EXPECT_NE(handle(sut, "{\"level\":\"error\",\"subsystems\":{\"door\":\"debug\"}}").find("\"result\":\"failed\""), std::string::npos);
+    EXPECT_NE(handle(sut, "{\"level\":\"loud\"}").find("\"result\":\"failed\""), std::string::npos);
+    EXPECT_EQ(Log::GetLogger()->level(), spdlog::level::info);
+    sut.stop();
+
+    DiagnosticsHandler::applyLogSettings("{\"level\":\"trace\",\"subsystems\":{\"motor\":\"trace\",\"commands\":\"trace\"},\"rateLimit\":{\"messages\":10,\"periodMs\":10000}}");
+    EXPECT_EQ(Log::GetLogger()->level(), spdlog::level::trace);
+}
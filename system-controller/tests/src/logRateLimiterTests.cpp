@@ -0,0 +1,32 @@
+#include <gtest/gtest.h>
+#include <string>
+
+#include "logRateLimiter.h"
+
+TEST(LogRateLimiter, limitPerKey) {
+    LogRateLimiter sut(2, std::chrono::milliseconds(1000));
+    const auto start = LogRateLimiter::Clock::now();
+    std::size_t suppressed = 0;
+    EXPECT_TRUE(sut.tryAcquire("resend motor1", suppressed, start));
+    EXPECT_TRUE(sut.tryAcquire("resend motor1", suppressed, start));
+    EXPECT_FALSE(sut.tryAcquire("resend motor1", suppressed, start));
+    EXPECT_FALSE(sut.tryAcquire("resend motor1", suppressed, start + std::chrono::milliseconds(999)));
+    EXPECT_TRUE(sut.tryAcquire("resend motor2", suppressed, start)) << "every key has its own limit";
+    EXPECT_EQ(suppressed, 0u);
+
+    EXPECT_TRUE(sut.tryAcquire("resend motor1", suppressed, start + std::chrono::milliseconds(1000)));
+    EXPECT_EQ(suppressed, 2u) << "the first message of a new period tells how many were dropped";
+    EXPECT_TRUE(sut.tryAcquire("resend motor1", suppressed, start + std::chrono::milliseconds(1000)));
+    EXPECT_EQ(suppressed, 0u);
+}
+
+TEST(LogRateLimiter, noLimit) {
+    LogRateLimiter sut(0, std::chrono::milliseconds(1000));
+    std::size_t suppressed = 0;
+    for (int i = 0; i < 100; ++i) {
+        EXPECT_TRUE(sut.tryAcquire("key", suppressed));
+    }
+    sut.setLimit(1, std::chrono::milliseconds(1000));
+    EXPECT_TRUE(sut.tryAcquire("key", suppressed));
+    EXPECT_FALSE(sut.tryAcquire("key", suppressed));
+}
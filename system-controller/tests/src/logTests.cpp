@@ -0,0 +1,39 @@
+#include <gtest/gtest.h>
+#include <string>
+
+#include "log.h"
+
+namespace {
+    struct CountedMessage {
+        int evaluated = 0;
+        std::string operator()() {
+            evaluated++;
+            return "message";
+        }
+    };
+}
+
+TEST(Log, argumentsOnlyEvaluatedWhenLogged) {
+    Log::Init();
+    CountedMessage message;
+    Log::setLevel(Log::Motor, spdlog::level::info);
+    LOG_SUBSYSTEM_DEBUG(Log::Motor, message());
+    EXPECT_EQ(message.evaluated, 0);
+    LOG_SUBSYSTEM_INFO(Log::Motor, "{} of {}", message(), 1);
+    EXPECT_EQ(message.evaluated, 1);
+    // the other subsystems keep their own level
+    LOG_SUBSYSTEM_DEBUG(Log::Wing, message());
+    EXPECT_EQ(message.evaluated, 2);
+    EXPECT_EQ(Log::getLevel(Log::Motor), spdlog::level::info);
+    Log::setLevel(Log::Motor, spdlog::level::trace);
+}
+
+TEST(Log, levelOfTheLoggerApplies) {
+    Log::Init("log", spdlog::level::warn);
+    CountedMessage message;
+    LOG_INFO(message());
+    EXPECT_EQ(message.evaluated, 0);
+    LOG_WARNING(message());
+    EXPECT_EQ(message.evaluated, 1);
+    Log::GetLogger()->set_level(spdlog::level::trace);
+}
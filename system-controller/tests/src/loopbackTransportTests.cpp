@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <string>
+
+#include "log.h"
+#include "loopbackTransport.h"
+#include "mqttManager.h"
+#include "topicHandler.h"
+
+namespace {
+    // answers every request on the reply topic with the same payload
+    class ReplyHandler : public TopicHandler {
+        public:
+            ReplyHandler() : TopicHandler({"request/#"}) {}
+        protected:
+            void handleNewInput(const MqttData & inputData) override {
+                _pOutTypeBuffer->QueueNewMessage(MqttData("reply/" + inputData.getTopic().substr(8), inputData.getPayload()));
+            }
+    };
+
+    std::vector<std::string> receiveTopics(LoopbackTransport & transport) {
+        std::vector<std::string> topics;
+        transport.setMessageHandler([&topics](const MqttData & data) {topics.push_back(data.getTopic());});
+        transport.loop();
+        transport.setMessageHandler(ITransport::MessageHandler());
+        return topics;
+    }
+}
+
+TEST(LoopbackTransport,wildcards ){
+    Log::Init();
+    auto bus = std::make_shared<LoopbackBus>();
+    LoopbackTransport status(bus), wings(bus), all(bus);
+    ASSERT_TRUE(status.connect() && wings.connect() && all.connect());
+    status.subscribe("rbus/+/+/rbus.get.status/trigger");
+    wings.subscribe("systemcontroller/#");
+    all.subscribe("rbus/#");
+    all.subscribe("rbus/0628252/#"); // overlapping subscriptions give the message only once
+
+    all.publish(MqttData("rbus/0628252/0000000000001/rbus.get.status/trigger", ""));
+    all.publish(MqttData("rbus/0628252/0000000000001/rbus.open/trigger", ""));
+    all.publish(MqttData("systemcontroller/config/wing/1/open", ""));
+
+    EXPECT_EQ(receiveTopics(status), std::vector<std::string>({"rbus/0628252/0000000000001/rbus.get.status/trigger"}));
+    EXPECT_EQ(receiveTopics(wings), std::vector<std::string>({"systemcontroller/config/wing/1/open"}));
+    EXPECT_EQ(receiveTopics(all).size(), 2u) << "a publisher also gets its own message when subscribed";
+    EXPECT_EQ(bus->getNumberOfPublishedMessages(), 3u);
+    EXPECT_EQ(bus->getNumberOfDeliveredMessages(), 4u);
+
+    wings.disconnect();
+    EXPECT_FALSE(wings.publish(MqttData("systemcontroller/config/wing/1/open", "")));
+    all.publish(MqttData("systemcontroller/config/wing/1/close", ""));
+    EXPECT_EQ(bus->getNumberOfDeliveredMessages(), 4u) << "a disconnected transport is not subscribed anymore";
+}
+
+TEST(LoopbackTransport,inboxOverflow ){
+    auto bus = std::make_shared<LoopbackBus>();
+    LoopbackTransport slow(bus, 8), publisher(bus);
+    slow.connect();
+    publisher.connect();
+    slow.subscribe("data/#");
+    for (int i = 0; i < 20; ++i) {
+        publisher.publish(MqttData("data/" + std::to_string(i), ""));
+    }
+    auto topics = receiveTopics(slow);
+    ASSERT_EQ(topics.size(), 8u);
+    EXPECT_EQ(topics.back(), "data/19") << "like a broker the oldest messages are dropped";
+    EXPECT_EQ(slow.getDroppedCount(), 12u);
+}
+
+TEST(LoopbackTransport,mqttManager ){
+    Log::Init();
+    for (bool threadedLoop : {false, true}) {
+        auto bus = std::make_shared<LoopbackBus>();
+        auto handler = std::make_shared<ReplyHandler>();
+        MqttManager sut(std::make_shared<LoopbackTransport>(bus), {handler});
+        sut.setUseThreadedLoop(threadedLoop);
+        ASSERT_TRUE(sut.waitForConnection(std::chrono::milliseconds(10)));
+
+        LoopbackTransport peer(bus);
+        std::atomic<int> replies(0);
+        peer.setMessageHandler([&replies](const MqttData & data) {
+            if (data.getTopic() == "reply/" + data.getPayload()) {
+                replies++;
+            }
+        });
+        peer.connect();
+        peer.subscribe("reply/#");
+        peer.startThreadedLoop();
+
+        sut.start();
+        const int requestCount = 500;
+        for (int i = 0; i < requestCount; ++i) {
+            const std::string id = std::to_string(i);
+            peer.publish(MqttData("request/" + id, id));
+        }
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+        while (replies < requestCount && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        sut.stop();
+        peer.stopThreadedLoop();
+        EXPECT_EQ(replies, requestCount) << "threaded loop: " << threadedLoop;
+    }
+}
+
+TEST(LoopbackTransport,coalescedPublishes ){
+    Log::Init();
+    auto bus = std::make_shared<LoopbackBus>();
+    auto handler = std::make_shared<ReplyHandler>();
+    MqttManager sut(std::make_shared<LoopbackTransport>(bus), {handler});
+    ASSERT_TRUE(sut.waitForConnection(std::chrono::milliseconds(10)));
+    LoopbackTransport peer(bus);
+    std::vector<std::string> payloads;
+    std::mutex payloadsMutex;
+    peer.setMessageHandler([&](const MqttData & data) {
+        std::lock_guard<std::mutex> lock(payloadsMutex);
+        payloads.push_back(data.getPayload());
+    });
+    peer.connect();
+    peer.subscribe("rbus/#");
+    peer.startThreadedLoop();
+
+    // queued before the sending worker runs, so they are sent in one flush
+    const std::string topic = "rbus/0628252/0000000000001/rbus.set.speed/trigger";
+    for (const std::string speed : {"50", "150", "50", "150"}) {
+        handler->getOutputBuffer()->QueueNewMessage(MqttData(topic, speed));
+    }
+    sut.start();
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (sut.getNumberOfElidedPublishes() < 3 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    sut.stop();
+    peer.stopThreadedLoop();
+    EXPECT_EQ(sut.getNumberOfElidedPublishes(), 3u);
+    std::lock_guard<std::mutex> lock(payloadsMutex);
+    EXPECT_EQ(payloads, std::vector<std::string>({"150"})) << "only the latest speed reaches the motor";
+}
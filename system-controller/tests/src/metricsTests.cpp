@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "log.h"
+#include "metrics.h"
+#include "metricsPublisher.h"
+
+TEST(Metrics, counterOverThreads) {
+    Counter sut;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&sut]() {
+            for (int i = 0; i < 10000; ++i) {
+                sut.add();
+            }
+        });
+    }
+    for (auto & thread : threads) {
+        thread.join();
+    }
+    sut.add(5);
+    EXPECT_EQ(sut.get(), 40005u);
+}
+
+TEST(Metrics, histogramBuckets) {
+    for (uint64_t value : {0ull, 1ull, 7ull, 8ull, 9ull, 15ull, 16ull, 17ull, 1000ull, 123456789ull, ~0ull}) {
+        const std::size_t bucket = Histogram::getBucket(value);
+        ASSERT_LT(bucket, Histogram::NumberOfBuckets);
+        EXPECT_LE(value, Histogram::getBucketLimit(bucket)) << value;
+        if (bucket > 0) {
+            EXPECT_GT(value, Histogram::getBucketLimit(bucket - 1)) << value;
+        }
+    }
+    EXPECT_EQ(Histogram::getBucketLimit(Histogram::getBucket(1000)), 1023u) << "1000 is in [896, 1023]";
+}
+
+TEST(Metrics, histogramPercentiles) {
+    Histogram sut;
+    EXPECT_EQ(sut.getSummary().count, 0u);
+    for (uint64_t value = 1; value <= 1000; ++value) {
+        sut.record(value);
+    }
+    const Histogram::Summary summary = sut.getSummary();
+    EXPECT_EQ(summary.count, 1000u);
+    EXPECT_EQ(summary.max, 1000u);
+    // within the 12.5% of a bucket
+    EXPECT_GE(summary.p50, 500u);
+    EXPECT_LE(summary.p50, 500u * 9 / 8);
+    EXPECT_GE(summary.p99, 990u);
+    EXPECT_LE(summary.p99, 1000u);
+}
+
+TEST(Metrics, registrySnapshot) {
+    MetricsRegistry & sut = MetricsRegistry::getInstance();
+    EXPECT_EQ(&sut.getCounter("test.counter"), &sut.getCounter("test.counter"));
+    sut.getCounter("test.counter").add(3);
+    sut.getGauge("test.gauge").set(-2);
+    sut.getHistogram("test.histogram").record(5);
+    const std::string snapshot = sut.getSnapshot();
+    EXPECT_NE(snapshot.find("\"test.counter\":3"), std::string::npos) << snapshot;
+    EXPECT_NE(snapshot.find("\"test.gauge\":-2"), std::string::npos) << snapshot;
+    EXPECT_NE(snapshot.find("\"test.histogram\":{\"n\":1,\"p50\":5,\"p90\":5,\"p99\":5,\"max\":5}"), std::string::npos) << snapshot;
+    rapidjson::Document doc;
+    doc.Parse(snapshot.data());
+    EXPECT_FALSE(doc.HasParseError());
+}
+
+TEST(Metrics, publishOnRequestAndPeriodically) {
+    Log::Init();
+    TimerWheel timerWheel(std::chrono::milliseconds(1));
+    MetricsPublisher sut([]() {return std::vector<std::string>({"configA", "configB"});}, std::chrono::milliseconds(20), timerWheel);
+    sut.start();
+    sut.queueInput(MqttData("systemcontroller/configA/metrics/get", ""));
+
+    std::vector<std::string> topics;
+    MqttData data;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+    while (topics.size() < 3 && std::chrono::steady_clock::now() < deadline) {
+        if (sut.getOutputBuffer()->UnqueueMessage(data)) {
+            EXPECT_EQ(data.getPayload().find("{\"counters\":"), 0u);
+            topics.push_back(data.getTopic());
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    sut.stop();
+    EXPECT_EQ(topics, std::vector<std::string>({"systemcontroller/configA/metrics", "systemcontroller/configA/metrics", "systemcontroller/configB/metrics"}));
+}
@@ -77,4 +77,38 @@ TEST(MotorData,checkResponse ){
     EXPECT_TRUE(sut.getCommand().compare("rbus.stop") == 0);
     
     EXPECT_FALSE(sut.isAck()) << "No ack is present, should result false";
-}
\ No newline at end of file
+}
+TEST(MotorData,commandTable ){
+    Log::Init();
+    std::string motorAndId = "rbus/0628252/0000000000001/";
+    auto commandOf = [&](const std::string & command) {
+        return MotorData(MqttData(motorAndId + command + "/result","{\"results\":1}")).getMotorCommand();
+    };
+    EXPECT_TRUE(commandOf("rbus.get.status") == MotorCommand::GetStatus);
+    EXPECT_TRUE(commandOf("rbus.get.minspeed") == MotorCommand::GetMinSpeed);
+    EXPECT_TRUE(commandOf("rbus.get.maxspeed") == MotorCommand::GetMaxSpeed);
+    EXPECT_TRUE(commandOf("rbus.get.stroke") == MotorCommand::GetStroke);
+    EXPECT_TRUE(commandOf("rbus.set.position.mm") == MotorCommand::SetPositionMm);
+    EXPECT_TRUE(commandOf("rbus.get.statusx") == MotorCommand::Unknown);
+    EXPECT_TRUE(commandOf("rbus.get") == MotorCommand::Unknown);
+
+    for (auto command : {MotorCommand::GetStatus, MotorCommand::SetSpeed, MotorCommand::CalibClear}) {
+        EXPECT_TRUE(toMotorCommand(StringSpan(std::string(toString(command)))) == command);
+    }
+}
+
+TEST(MotorData,invalidTopics ){
+    Log::Init();
+    auto isParsed = [](const std::string & topic) {
+        return !MotorData(MqttData(topic,"{\"results\":1}")).getId().empty();
+    };
+    EXPECT_TRUE(isParsed("rbus/0628252/0000000000001/rbus.get.status/result"));
+    EXPECT_TRUE(isParsed("/0628252/0000000000001/rbus.get.status/result"));
+    EXPECT_FALSE(isParsed("0628252/0000000000001/rbus.get.status/result")) << "the pn should be preceded by a '/'";
+    EXPECT_FALSE(isParsed("rbus/062825/0000000000001/rbus.get.status/result")) << "the pn has 7 digits";
+    EXPECT_FALSE(isParsed("rbus/0628252/000000000001/rbus.get.status/result")) << "the serial has 13 digits";
+    EXPECT_FALSE(isParsed("rbus/06282a2/0000000000001/rbus.get.status/result"));
+    EXPECT_FALSE(isParsed("rbus/0628252/0000000000001/rbus.get.status/"));
+    EXPECT_FALSE(isParsed("rbus/0628252/0000000000001/rbus.get.status"));
+    EXPECT_FALSE(isParsed(""));
+}
@@ -9,7 +9,7 @@
 
 TEST(motorMotionManagerTests,OnCalibratedHandlerTest ) {
     Log::Init();
-    auto sut = TestMotorMotionManager(0);
+    TestMotorMotionManager sut(0);
     
     int onCalibCalledCount =0;
     sut.addOnMotorCalibratedhandler([&]() {
@@ -32,4 +32,22 @@ TEST(motorMotionManagerTests,OnCalibratedHandlerTest ) {
     sut.SetFakeMotorStatus(MotorStatus::Closed); // trigger a new status update 
     sut.SetFakeMotorStatusData(fakeMotorData); // trigger a new status update 
     EXPECT_EQ(onCalibCalledCount,1) << "Stoke and Calib are ok, on calib should be called once and NOT MORE THAN ONCE";
-}
\ No newline at end of file
+}
+TEST(motorMotionManagerTests,RemoveHandlersTest ) {
+    TestMotorMotionManager sut(0);
+    int positionCalledCount = 0;
+    int statusCalledCount = 0;
+    const int positionHandlerId = sut.addOnPositionUpdatehandler([&](int) {positionCalledCount++;});
+    sut.addOnPositionUpdatehandler([&](int) {positionCalledCount += 10;});
+    const int statusHandlerId = sut.addOnMotorStatusUpdatehandler([&](MotorStatus) {statusCalledCount++;});
+
+    sut.SetFakeMotorStatus(MotorStatus::Moving);
+    EXPECT_EQ(positionCalledCount, 11);
+    EXPECT_EQ(statusCalledCount, 1);
+
+    sut.removeOnPositionUpdatehandler(positionHandlerId);
+    sut.removeOnMotorStatusUpdatehandler(statusHandlerId);
+    sut.SetFakeMotorStatus(MotorStatus::Closed);
+    EXPECT_EQ(positionCalledCount, 21) << "only the handler that is not removed is called";
+    EXPECT_EQ(statusCalledCount, 1);
+}
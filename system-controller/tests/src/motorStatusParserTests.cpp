@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+#include <string>
+#include <random>
+#include <cstring>
+
+#include "motorStatusParser.h"
+#include "log.h"
+
+namespace {
+    std::string toPayload(const MotorStatusData & s) {
+        auto b = [](bool v) { return std::string(v ? "true" : "false");};
+        return "{\"results\":\"" + std::to_string(s.posMm) + "," + std::to_string(s.posPerc) + "," + std::to_string(s.speedMm) + ","
+            + b(s.isLocked) + "," + b(s.isOpen) + "," + b(s.isClosed) + "," + std::to_string(s.temperature) + "," + std::to_string(s.current) + ","
+            + std::to_string(s.buttons[0]) + "," + std::to_string(s.buttons[1]) + "," + std::to_string(s.buttons[2]) + ","
+            + b(s.boolButtons[0]) + "," + b(s.boolButtons[1]) + "," + b(s.isCalibrated) + "," + b(s.isEmergencyRun) + "\"}";
+    }
+}
+
+TEST(MotorStatusParser,allFields ){
+    MotorStatusData sut;
+    ASSERT_TRUE(MotorStatusParser::parse("{\"results\":\"12,5,50,false,true,false,34,-20,1,2,3,true,false,true,true\"}", sut));
+    EXPECT_EQ(sut.posMm, 12);
+    EXPECT_EQ(sut.posPerc, 5);
+    EXPECT_EQ(sut.speedMm, 50);
+    EXPECT_FALSE(sut.isLocked);
+    EXPECT_TRUE(sut.isOpen);
+    EXPECT_FALSE(sut.isClosed);
+    EXPECT_EQ(sut.temperature, 34);
+    EXPECT_EQ(sut.current, -20);
+    EXPECT_EQ(sut.buttons[0], 1);
+    EXPECT_EQ(sut.buttons[1], 2);
+    EXPECT_EQ(sut.buttons[2], 3);
+    EXPECT_TRUE(sut.boolButtons[0]);
+    EXPECT_FALSE(sut.boolButtons[1]);
+    EXPECT_TRUE(sut.isCalibrated);
+    EXPECT_TRUE(sut.isEmergencyRun) << "the last field should be parsed as well";
+}
+
+TEST(MotorStatusParser,format ){
+    MotorStatusData sut;
+    EXPECT_TRUE(MotorStatusParser::parse("{ \"id\":\"_x_\", \"results\" : \"7,0,0,false,false,true\" }", sut)) << "whitespace and other members are allowed";
+    EXPECT_EQ(sut.posMm, 7);
+    EXPECT_TRUE(sut.isClosed);
+    EXPECT_TRUE(MotorStatusParser::parse("{\"results\":\"12.7,0,3.0,false,false,false,1,2,3,4,5,false,false,false,false,extra\"}", sut)) << "decimals and extra fields are ignored";
+    EXPECT_EQ(sut.posMm, 12);
+    EXPECT_EQ(sut.speedMm, 3);
+    EXPECT_TRUE(MotorStatusParser::parse("{\"results\":\"12,1000,50,false,false,true,34,20,true,false,false,false,false,true,false\"}", sut)) << "buttons can be reported as bool";
+    EXPECT_EQ(sut.buttons[0], 1);
+    EXPECT_TRUE(sut.isCalibrated);
+    EXPECT_TRUE(MotorStatusParser::parse("{\"results\":\"12,?,50,false,false,true,,,x,,,,,true,false\"}", sut)) << "informational fields do not reject the status";
+    EXPECT_TRUE(sut.isClosed);
+}
+
+TEST(MotorStatusParser,invalid ){
+    MotorStatusData sut;
+    sut.posMm = 99;
+    const std::vector<std::string> payloads = {
+        "", "{}", "{\"results\":12}", "{\"results\":\"12,0,50,false,false\"}", "{\"results\":\"12,0,50,false,false,true", 
+        "{\"results\":\"x,0,50,false,false,true\"}", "{\"results\":\"12,0,50,False,false,true\"}", "{\"results\":\",0,50,false,false,true\"}",
+        "{\"results\":\"12,0,50,false,false,true\\\"\"}", "{\"result\":\"12,0,50,false,false,true\"}", "{\"results\":\"99999999999,0,50,false,false,true\"}"};
+    for (auto & payload : payloads) {
+        EXPECT_FALSE(MotorStatusParser::parse(payload, sut)) << payload << " should not be parsed";
+    }
+    EXPECT_EQ(sut.posMm, 99) << "the status should not change on an invalid payload";
+}
+
+TEST(MotorStatusParser,fuzz ){
+    std::mt19937 random(1234);
+    // random statuses should survive a format/parse roundtrip
+    for (int i = 0; i < 2000; ++i) {
+        MotorStatusData expected;
+        expected.posMm = random() % 5000;
+        expected.posPerc = random() % 101;
+        expected.speedMm = (int)(random() % 200) - 100;
+        expected.isLocked = random() % 2;
+        expected.isOpen = random() % 2;
+        expected.isClosed = random() % 2;
+        expected.temperature = (int)(random() % 100) - 20;
+        expected.current = random() % 3000;
+        expected.buttons[0] = random() % 3;
+        expected.buttons[2] = random() % 3;
+        expected.boolButtons[1] = random() % 2;
+        expected.isCalibrated = random() % 2;
+        expected.isEmergencyRun = random() % 2;
+        const std::string payload = toPayload(expected);
+        MotorStatusData sut;
+        ASSERT_TRUE(MotorStatusParser::parse(payload, sut)) << payload;
+        EXPECT_EQ(toPayload(sut), payload);
+    }
+    // mutated and truncated payloads should never crash or read out of bounds, the result is valid or untouched
+    const std::string valid = "{\"results\":\"12,1000,50,false,false,true,34,20,false,false,false,false,false,true,false\"}";
+    const std::string alphabet = "0123456789,.-\"\\:{} truefalsxyz";
+    for (int i = 0; i < 20000; ++i) {
+        std::string payload = valid;
+        const int mutations = 1 + random() % 4;
+        for (int m = 0; m < mutations; ++m) {
+            const std::size_t pos = random() % payload.size();
+            switch (random() % 3) {
+                case 0: payload[pos] = alphabet[random() % alphabet.size()]; break;
+                case 1: payload.erase(pos, 1 + random() % 3); break;
+                default: payload.insert(pos, 1, alphabet[random() % alphabet.size()]); break;
+            }
+            if (payload.empty()) { payload = "{";}
+        }
+        payload.resize(random() % (payload.size() + 1));
+        // parse from a heap copy of exactly the payload size so reading past the end is detectable by sanitizers
+        std::unique_ptr<char[]> exact(new char[payload.size() + 1]);
+        std::memcpy(exact.get(), payload.data(), payload.size());
+        MotorStatusData sut;
+        sut.posMm = -12345;
+        if (!MotorStatusParser::parse(exact.get(), payload.size(), sut)) {
+            EXPECT_EQ(sut.posMm, -12345) << payload;
+        }
+    }
+}
@@ -0,0 +1,36 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+#include <string>
+
+#include "motorTrie.h"
+#include "testMqttMotor.h"
+#include "log.h"
+
+TEST(MotorTrie,empty ){
+    MotorTrie sut;
+    EXPECT_EQ(sut.size(), 0u);
+    EXPECT_TRUE(sut.find(StringSpan("0628252/0000000000001", 21)) == nullptr);
+    EXPECT_TRUE(sut.find(StringSpan()) == nullptr);
+}
+
+TEST(MotorTrie,find ){
+    Log::Init();
+    std::map<std::string, std::shared_ptr<IMqttMotor>> motors;
+    const std::vector<std::string> ids = {"0628252/0000000000001", "0628252/0000000000002", "0628252/0000000000010", 
+                                         "0628253/0000000000001", "1", "12"};
+    for (auto & id : ids) {
+        motors[id] = std::make_shared<TestMqttMotor>(id);
+    }
+    MotorTrie sut(motors);
+    EXPECT_EQ(sut.size(), ids.size());
+
+    for (auto & id : ids) {
+        EXPECT_EQ(sut.find(StringSpan(id)), motors[id].get()) << "should find motor " << id;
+    }
+    EXPECT_TRUE(sut.find(StringSpan(std::string("0628252/000000000000"))) == nullptr) << "a prefix of an id is not a motor";
+    EXPECT_TRUE(sut.find(StringSpan(std::string("0628252/00000000000011"))) == nullptr);
+    EXPECT_TRUE(sut.find(StringSpan(std::string("0628254/0000000000001"))) == nullptr);
+    EXPECT_TRUE(sut.find(StringSpan(std::string("123"))) == nullptr);
+    EXPECT_TRUE(sut.find(StringSpan()) == nullptr);
+}
@@ -3,6 +3,7 @@
 #include <vector>
 #include <string>
 #include <thread>
+#include <atomic>
 
 #include "log.h"
 #include "mqttMotor.h"
@@ -230,4 +231,38 @@ TEST(MqttMotor,clearCalibration ){
         worker.join();
     }
     
-}
\ No newline at end of file
+}
+TEST(MqttMotor,adaptivePolling ){
+    Log::Init();
+    std::string serial = "0000000000001", pn ="0268253";
+    MqttMotor sut(pn,serial);
+    std::atomic<int> statusCounter(0);
+    const MqttData idleClosedStatus("rbus/" + pn + "/" + serial + "/rbus.get.status/result"
+                        ,"{\"results\":\"0,0,0,false,false,true,34,20,false,false,false,false,false,false,false\"}");
+    // the motor replies immediately on every status request
+    sut.setDelegateMotorOutput([&](const MqttData & data) {
+        if (data.getTopic().find("get.status") != std::string::npos) {
+            statusCounter++;
+            sut.onMotorInput(MotorData(idleClosedStatus));
+        }
+    });
+    sut.onMotorConnected();
+    sut.onMotorInput(MotorData(MqttData("rbus/" + pn + "/" + serial + "/rbus.get.maxspeed/result","{\"results\":120}")));
+    sut.onMotorInput(MotorData(MqttData("rbus/" + pn + "/" + serial + "/rbus.get.minspeed/result","{\"results\":20}")));
+
+    // after connecting the motor is polled fast until the hold time passed
+    std::this_thread::sleep_for(MqttMotor::FastPollHold + MqttMotor::ConfigurationInterval);
+    EXPECT_GE(statusCounter, 10) << "polled at the min interval while the state settles";
+
+    statusCounter = 0;
+    std::this_thread::sleep_for(std::chrono::milliseconds(2100));
+    EXPECT_GE(statusCounter, 1);
+    EXPECT_LE(statusCounter, 3) << "an idle and closed motor should be polled at the slow interval";
+
+    // a command makes the polling fast again
+    sut.open();
+    statusCounter = 0;
+    std::this_thread::sleep_for(std::chrono::milliseconds(600));
+    EXPECT_GE(statusCounter, 4) << "a commanded motor should be polled at the min interval";
+    sut.onMotorDisconnected();
+}
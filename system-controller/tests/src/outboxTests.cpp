@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+#include "log.h"
+#include "outbox.h"
+
+namespace {
+    std::vector<std::string> flushAll(Outbox & outbox) {
+        std::vector<std::string> published;
+        outbox.flush([&published](const MqttData & data) {published.push_back(data.getTopic() + " " + data.getPayload());});
+        return published;
+    }
+}
+
+TEST(Outbox,coalesceLatestValue ){
+    Log::Init();
+    const std::string speed1 = "rbus/0628252/0000000000001/rbus.set.speed/trigger";
+    const std::string speed2 = "rbus/0628252/0000000000002/rbus.set.speed/trigger";
+    const std::string open1 = "rbus/0628252/0000000000001/rbus.open/trigger";
+    Outbox sut;
+    sut.add(MqttData(speed1, "50"));
+    sut.add(MqttData(open1, ""));
+    sut.add(MqttData(speed2, "50"));
+    sut.add(MqttData(speed1, "150"));
+    sut.add(MqttData(open1, ""));
+    sut.add(MqttData(speed1, "50"));
+
+    EXPECT_EQ(flushAll(sut), std::vector<std::string>({open1 + " ", speed2 + " 50", open1 + " ", speed1 + " 50"}))
+        << "only the last speed of motor 1 is sent, in its own place; open is not coalesced";
+    EXPECT_EQ(sut.getElidedCount(), 2u);
+    EXPECT_TRUE(sut.empty());
+
+    sut.add(MqttData(speed1, "150"));
+    EXPECT_EQ(flushAll(sut).size(), 1u) << "a flush only coalesces its own messages";
+}
+
+TEST(Outbox,repeatedMessage ){
+    Log::Init();
+    Outbox sut;
+    sut.add(MqttData("rbus/0628252/0000000000001/rbus.get.status/trigger", ""));
+    sut.add(MqttData("rbus/0628252/0000000000001/rbus.get.status/trigger", ""));
+    sut.add(MqttData("rbus/0628252/0000000000002/rbus.get.status/trigger", ""));
+    sut.add(MqttData("rbus/0628252/0000000000001/rbus.get.status/trigger", ""));
+    EXPECT_EQ(flushAll(sut).size(), 3u) << "only the message that repeats the previous one is dropped";
+    EXPECT_EQ(sut.getElidedCount(), 1u);
+
+    sut.addCoalescedTopic("custom/#");
+    sut.add(MqttData("custom/a", "1"));
+    sut.add(MqttData("custom/a", "2"));
+    EXPECT_EQ(flushAll(sut), std::vector<std::string>({"custom/a 2"}));
+}
@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+
+#include "panelChain.h"
+#include "passiveWindow.h"
+#include "testMotorMotionManager.h"
+#include "log.h"
+
+TEST(panelChainTests,flattenSlaveTree ){
+    Log::Init();
+    auto master = std::make_shared<MasterMotorizedWindow>(1000,std::make_shared<TestMotorMotionManager>(0));
+    auto passive = std::make_shared<PassiveWindow>(900);
+    auto motor = std::make_shared<MotorizedWindow>(800,std::make_shared<TestMotorMotionManager>(0));
+    auto tail = std::make_shared<PassiveWindow>(700);
+    auto branch = std::make_shared<MotorizedWindow>(600,std::make_shared<TestMotorMotionManager>(0));
+    motor->addSlave(tail,SlaveType::Passive);
+    passive->addSlave(motor,SlaveType::Motor);
+    master->addSlave(passive,SlaveType::Passive);
+    master->addSlave(branch,SlaveType::Motor);
+
+    PanelChain sut(master);
+    ASSERT_EQ(sut.size(), 5u);
+    EXPECT_EQ(sut.getWindow(0), master.get());
+    EXPECT_EQ(sut.getWindow(3), tail.get()) << "a slave comes right after its master";
+    EXPECT_EQ(sut.getMasterIndex(0), -1);
+    EXPECT_EQ(sut.getMasterIndex(2), 1);
+    EXPECT_EQ(sut.getMasterIndex(4), 0);
+    EXPECT_EQ(sut.getType(1), SlaveType::Passive);
+    EXPECT_EQ(sut.getType(4), SlaveType::Motor);
+    EXPECT_EQ(sut.getLength(2), 800);
+    EXPECT_EQ(sut.getTail(), tail.get()) << "the tail follows the first slaves, not the branch";
+    EXPECT_EQ(sut.getMotors(), std::vector<std::shared_ptr<MotorizedWindow>>({motor, branch, master}));
+}
+
+TEST(panelChainTests,compiledAgainAfterAddSlave ){
+    Log::Init();
+    auto master = std::make_shared<MasterMotorizedWindow>(1000,std::make_shared<TestMotorMotionManager>(0));
+    auto slave = std::make_shared<PassiveWindow>(1000);
+    master->addSlave(slave,SlaveType::Passive);
+    PanelChain sut(master);
+    EXPECT_EQ(sut.getStructureVersion(), master->getStructureVersion());
+
+    // added below a slave, the version of the master changes as well
+    slave->addSlave(std::make_shared<MotorizedWindow>(1000,std::make_shared<TestMotorMotionManager>(0)),SlaveType::Motor);
+    EXPECT_NE(sut.getStructureVersion(), master->getStructureVersion());
+    EXPECT_EQ(PanelChain(master).size(), 3u);
+}
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include <sstream>
+#include <memory>
+#include <string>
+
+#include "simulatedMotor.h"
+#include "siteSimulation.h"
+#include "utils.h"
+#include "log.h"
+
+static std::string readTestConfig(const std::string & name) {
+    std::ifstream f(utils::getApplicationDirectory() + "/testData/" + name);
+    std::ostringstream ss;
+    ss << f.rdbuf();
+    return ss.str();
+}
+
+TEST(SimulatedMotor,physics ){
+    Log::Init();
+    VirtualClock clock;
+    SimulatedMotor sut("pn/serial", 1500, clock, 50, 150);
+    int lastPosition = -1;
+    sut.addOnPositionUpdatehandler([&lastPosition](int position) {lastPosition = position;});
+    sut.reportStatus();
+    EXPECT_EQ(sut.getMotorStatusData().getStatus(), MotorStatus::Closed);
+    EXPECT_EQ(sut.getStroke(), 1500);
+
+    auto runFor = [&](std::chrono::milliseconds duration) {
+        for (auto end = clock.now() + duration; clock.now() < end;) {
+            clock.advance(std::chrono::milliseconds(10));
+            sut.step(std::chrono::milliseconds(10));
+        }
+    };
+    // 1500mm at high speed takes 10 seconds
+    sut.open();
+    runFor(std::chrono::milliseconds(5000));
+    EXPECT_NEAR(sut.getActualPosition(), 750, 2);
+    EXPECT_EQ(sut.getMotorStatusData().getStatus(), MotorStatus::Moving);
+    EXPECT_NEAR(lastPosition, 750, 20) << "status is reported every 100ms while moving";
+    runFor(std::chrono::milliseconds(5100));
+    EXPECT_EQ(sut.getMotorStatusData().getStatus(), MotorStatus::Open);
+    EXPECT_EQ(lastPosition, 1500);
+
+    sut.setLowSpeed();
+    sut.setPosition(1000);
+    runFor(std::chrono::milliseconds(5000));
+    EXPECT_NEAR(sut.getActualPosition(), 1250, 2);
+    sut.stop();
+    runFor(std::chrono::milliseconds(1000));
+    EXPECT_EQ(sut.getMotorStatusData().getStatus(), MotorStatus::Idle);
+    EXPECT_NEAR(lastPosition, 1250, 2);
+    EXPECT_EQ(sut.getNumberOfCommands(), 4u) << "open, low speed, position and stop (the repeated low speed is dropped)";
+}
+
+TEST(SimulatedMotor,calibration ){
+    VirtualClock clock;
+    SimulatedMotor sut("pn/serial", 1000, clock);
+    int calibratedCount = 0;
+    sut.addOnMotorCalibratedhandler([&calibratedCount]() {calibratedCount++;});
+    sut.reportStatus();
+    EXPECT_EQ(calibratedCount, 1);
+    sut.clearCalibration().get();
+    EXPECT_FALSE(sut.isCalibrated());
+    EXPECT_EQ(sut.getStroke(), -1);
+    sut.jumpToPosition(500);
+    sut.open();
+    for (int i = 0; i < 1000 && sut.isMoving(); ++i) {
+        clock.advance(std::chrono::milliseconds(10));
+        sut.step(std::chrono::milliseconds(10));
+    }
+    EXPECT_FALSE(sut.isCalibrated()) << "both ends should be reached before the motor is calibrated";
+    sut.close();
+    for (int i = 0; i < 1000 && sut.isMoving(); ++i) {
+        clock.advance(std::chrono::milliseconds(10));
+        sut.step(std::chrono::milliseconds(10));
+    }
+    sut.reportStatus();
+    EXPECT_TRUE(sut.isCalibrated());
+    EXPECT_EQ(calibratedCount, 2);
+}
+
+TEST(SiteSimulation,cornerOpenAndClose ){
+    Log::Init();
+    SiteSimulation sut(readTestConfig("QXvXQ_withStrokes.json"));
+    ASSERT_EQ(sut.getWings().size(), 2u);
+    ASSERT_EQ(sut.getMotors().size(), 2u);
+    EXPECT_TRUE(sut.areAllWingsClosed());
+
+    for (auto & wing : sut.getWings()) {wing->open();}
+    EXPECT_TRUE(sut.runUntil([&sut]() {return sut.areAllWingsOpen();}, std::chrono::minutes(1)));
+    for (auto & wing : sut.getWings()) {wing->close();}
+    EXPECT_TRUE(sut.runUntil([&sut]() {return sut.areAllWingsClosed();}, std::chrono::minutes(1)));
+    EXPECT_LT(sut.getClock().now(), std::chrono::minutes(1));
+
+    auto counters = sut.getCounters();
+    EXPECT_GT(counters.motorCommands, 0u);
+    EXPECT_GT(counters.wingEvaluations, 0u);
+    EXPECT_GT(counters.wingMessages, 0u);
+}
+
+TEST(SiteSimulation,deterministic ){
+    auto runScenario = []() {
+        SiteSimulation simulation(readTestConfig("X_XX_test.json"));
+        for (auto & wing : simulation.getWings()) {wing->setPositionPerc(60);}
+        simulation.run(std::chrono::seconds(20));
+        for (auto & wing : simulation.getWings()) {wing->close();}
+        simulation.runUntil([&simulation]() {return simulation.areAllWingsClosed();}, std::chrono::minutes(1));
+        auto counters = simulation.getCounters();
+        return std::make_tuple(simulation.getClock().now(), counters.statusReports, counters.motorCommands, counters.wingMessages);
+    };
+    EXPECT_EQ(runScenario(), runScenario());
+}
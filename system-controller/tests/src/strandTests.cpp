@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+#include <string>
+#include <atomic>
+
+#include "strand.h"
+#include "log.h"
+
+TEST(Strand,serial ){
+    Log::Init();
+    auto pool = std::make_shared<ThreadPool>(4);
+    auto sut = std::make_shared<Strand>(pool);
+    std::vector<int> executed; // no lock: the strand is the lock
+    std::atomic<bool> isInside(false);
+    std::atomic<int> overlaps(0);
+    const int taskCount = 1000;
+    for (int i = 0; i < taskCount; ++i) {
+        sut->post([&, i]() {
+            if (isInside.exchange(true)) {
+                overlaps++;
+            }
+            executed.push_back(i);
+            isInside = false;
+        });
+    }
+    sut->waitUntilIdle();
+    ASSERT_EQ((int)executed.size(), taskCount);
+    for (int i = 0; i < taskCount; ++i) {
+        ASSERT_EQ(executed[i], i) << "tasks should run in the order they are posted";
+    }
+    EXPECT_EQ(overlaps, 0) << "tasks of one strand should never run at the same time";
+}
+
+TEST(Strand,parallelStrands ){
+    auto pool = std::make_shared<ThreadPool>(2);
+    auto strand1 = std::make_shared<Strand>(pool);
+    auto strand2 = std::make_shared<Strand>(pool);
+    std::atomic<int> started(0);
+    std::atomic<int> metOther(0);
+    auto task = [&]() {
+        started++;
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+        while (started < 2 && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::yield();
+        }
+        metOther += (started == 2) ? 1 : 0;
+    };
+    strand1->post(task);
+    strand2->post(task);
+    strand1->waitUntilIdle();
+    strand2->waitUntilIdle();
+    EXPECT_EQ(metOther, 2) << "two strands should run at the same time";
+}
+
+TEST(Strand,dispatch ){
+    auto pool = std::make_shared<ThreadPool>(2);
+    auto sut = std::make_shared<Strand>(pool);
+    std::vector<std::string> executed;
+    EXPECT_FALSE(sut->isRunningInThisThread());
+    sut->post([&]() {
+        EXPECT_TRUE(sut->isRunningInThisThread());
+        sut->post([&]() {executed.push_back("posted");});
+        sut->dispatch([&]() {executed.push_back("dispatched");});
+        // a throwing task doesn't stop the strand
+        throw std::runtime_error("failing task");
+    });
+    sut->waitUntilIdle();
+    EXPECT_EQ(executed, std::vector<std::string>({"dispatched", "posted"})) << "dispatch from within the strand runs immediately";
+}
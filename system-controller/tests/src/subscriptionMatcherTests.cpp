@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+#include <string>
+
+#include "subscriptionMatcher.h"
+#include "log.h"
+
+namespace {
+    std::vector<std::size_t> matchOf(const SubscriptionMatcher & sut, const std::string & topic) {
+        std::vector<std::size_t> subscribers;
+        sut.match(StringSpan(topic), subscribers);
+        std::sort(subscribers.begin(), subscribers.end());
+        return subscribers;
+    }
+}
+
+TEST(SubscriptionMatcher,basics ){
+    SubscriptionMatcher sut;
+    sut.add("test/topic", 0);
+    sut.add("testTopic/#", 1);
+    sut.add("aaa/+/bbb", 2);
+    sut.add("+/c/bb/+/ff", 3);
+
+    EXPECT_EQ(matchOf(sut, "test/topic"), std::vector<std::size_t>({0}));
+    EXPECT_TRUE(matchOf(sut, "test/topc").empty());
+    EXPECT_TRUE(matchOf(sut, "test/topic/hello").empty());
+    EXPECT_EQ(matchOf(sut, "testTopic/a/b/c"), std::vector<std::size_t>({1}));
+    EXPECT_EQ(matchOf(sut, "aaa/1/bbb"), std::vector<std::size_t>({2}));
+    EXPECT_TRUE(matchOf(sut, "aaa/1/cc/bbb").empty());
+    EXPECT_EQ(matchOf(sut, "xxx/c/bb/xxx/ff"), std::vector<std::size_t>({3}));
+    EXPECT_TRUE(matchOf(sut, "xxx/c/bbx/xxx/ff").empty());
+}
+
+TEST(SubscriptionMatcher,wildcardRules ){
+    SubscriptionMatcher sut;
+    sut.add("a/#", 0);
+    sut.add("#", 1);
+    sut.add("a/+", 2);
+    sut.add("+/+", 3);
+    sut.add("a/b", 4);
+
+    EXPECT_EQ(matchOf(sut, "a"), std::vector<std::size_t>({0,1})) << "'a/#' also matches the parent level";
+    EXPECT_EQ(matchOf(sut, "a/b"), std::vector<std::size_t>({0,1,2,3,4}));
+    EXPECT_EQ(matchOf(sut, "a/"), std::vector<std::size_t>({0,1,2,3})) << "'+' matches an empty level";
+    EXPECT_EQ(matchOf(sut, "b/c"), std::vector<std::size_t>({1,3}));
+    EXPECT_EQ(matchOf(sut, "a/b/c"), std::vector<std::size_t>({0,1}));
+    EXPECT_TRUE(matchOf(sut, "$SYS/broker").empty()) << "wildcards on the first level don't match $ topics";
+
+    SubscriptionMatcher system;
+    system.add("$SYS/#", 7);
+    EXPECT_EQ(matchOf(system, "$SYS/broker"), std::vector<std::size_t>({7}));
+    EXPECT_TRUE(system.matches(StringSpan(std::string("$SYS"))));
+    EXPECT_FALSE(system.matches(StringSpan(std::string("SYS/broker"))));
+}
+
+TEST(SubscriptionMatcher,subscriberOnce ){
+    SubscriptionMatcher sut;
+    sut.add("rbus/#", 0);
+    sut.add("rbus/+/+/rbus.get.status/result", 0);
+    sut.add("rbus/+/+/rbus.get.status/result", 1);
+
+    EXPECT_EQ(matchOf(sut, "rbus/0628252/0000000000001/rbus.get.status/result"), std::vector<std::size_t>({0,1}));
+    EXPECT_EQ(matchOf(sut, "rbus/0628252/0000000000001/rbus.stop/result"), std::vector<std::size_t>({0}));
+
+    sut.clear();
+    EXPECT_TRUE(matchOf(sut, "rbus/0628252/0000000000001/rbus.stop/result").empty());
+}
@@ -80,9 +80,7 @@ void TestMotorMotionManager::SetFakeMotorStatusData( MotorStatusData data)  {
 }
 
 void TestMotorMotionManager::updateWithFakePosition(int position) {
-    for (auto & handler: _onPositionUpdateHandlers) {
-        handler.second(position);    
-    }
+    _onPositionUpdateHandlers(position);
 }
 
 
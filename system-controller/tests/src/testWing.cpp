@@ -6,7 +6,8 @@
 TestWing::TestWing(int fakeStroke, std::string wingName): 
     _fakeStroke(fakeStroke) ,
      _currentCornerPushZone(std::make_shared<WindowPushZone>()),
-     _currentOppositePushZone(std::make_shared<WindowPushZone>())     {    
+     _currentOppositePushZone(std::make_shared<WindowPushZone>()),
+     _siblings(std::make_shared<std::vector<std::tuple<std::shared_ptr<IWing>,WingSiblingType>>>())     {    
     _wingName = wingName;
     _motors.push_back (std::make_shared<MasterMotorizedWindow>(2000, std::make_shared<TestMotorMotionManager>(4000)));        
 }
@@ -14,7 +15,7 @@ TestWing::TestWing(int fakeStroke, std::string wingName):
 void TestWing::addSibling(std::shared_ptr<IWing> sibling, WingSiblingType siblingType){
     LOG_DEBUG("Added sibling ");
     _commandsCalledBuffer.append("addSibling,");
-    // todo add implementaion of adding a sibling 
+    _siblings->push_back(std::make_tuple(sibling, siblingType));
 }
 void TestWing::open() {
     _fakePos=_fakeStroke;
@@ -46,20 +47,20 @@ int TestWing::getTarget() {
     return _fakePos;
 }
 void TestWing::updateWingMovement(){
-    _commandsCalledBuffer.append("updateWingMovement,");
+    _evaluations++;
 }
 std::shared_ptr<MasterMotorizedWindow> TestWing::getMasterWindow() const {
    // not possible to fill the commandsbuffer due const restriction
     return std::dynamic_pointer_cast<MasterMotorizedWindow>(_motors[0]);
 }
 
-const std::vector<std::shared_ptr<MotorizedWindow>> TestWing::getMotors() const {   
+const std::vector<std::shared_ptr<MotorizedWindow>> & TestWing::getMotors() const {   
     return _motors;
 }
 
 
 const std::shared_ptr<std::vector<std::tuple<std::shared_ptr<IWing>,WingSiblingType>>> TestWing::getSiblings() const {
-    return std::make_shared<std::vector<std::tuple<std::shared_ptr<IWing>,WingSiblingType>>>();
+    return _siblings;
 }
 void TestWing::startCalibrate() {
     _commandsCalledBuffer.append("startCalibrate");    
@@ -0,0 +1,127 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <vector>
+#include <string>
+#include <atomic>
+
+#include "timerWheel.h"
+#include "pollScheduler.h"
+#include "log.h"
+
+TEST(TimerWheel,order ){
+    Log::Init();
+    TimerWheel sut(std::chrono::milliseconds(5), 8); // small wheel so timers wrap around multiple rounds
+    std::mutex mutex;
+    std::vector<int> fired;
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::chrono::milliseconds> firedAfter(4);
+    const std::vector<int> delays = {120, 10, 60, 0};
+    for (int i = 0; i < (int)delays.size(); ++i) {
+        sut.schedule(std::chrono::milliseconds(delays[i]), [&, i]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            fired.push_back(i);
+            firedAfter[i] = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(fired, std::vector<int>({3, 1, 2, 0}));
+    for (int i = 0; i < (int)delays.size(); ++i) {
+        EXPECT_GE(firedAfter[i].count(), delays[i]) << "a timer should never fire early";
+    }
+    EXPECT_EQ(sut.getNumberOfPendingTimers(), 0u);
+}
+
+TEST(TimerWheel,cancel ){
+    TimerWheel sut;
+    std::atomic<int> counter(0);
+    auto id = sut.schedule(std::chrono::milliseconds(30), [&counter]() {counter++;});
+    sut.schedule(std::chrono::milliseconds(30), [&counter]() {counter += 10;});
+    EXPECT_EQ(sut.getNumberOfPendingTimers(), 2u);
+    EXPECT_TRUE(sut.cancel(id));
+    EXPECT_FALSE(sut.cancel(id)) << "a timer can only be cancelled once";
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(counter, 10);
+    EXPECT_FALSE(sut.cancel(0));
+}
+
+TEST(TimerWheel,batch ){
+    TimerWheel sut;
+    std::atomic<int> counter(0), rescheduled(0);
+    // the timers scheduled from within a callback should keep running
+    std::function<void()> reschedule = [&]() {
+        if (++rescheduled < 5) {
+            sut.schedule(std::chrono::milliseconds(1), reschedule);
+        }
+    };
+    for (int i = 0; i < 1000; ++i) {
+        sut.schedule(std::chrono::milliseconds(20), [&counter]() {counter++;});
+    }
+    sut.schedule(std::chrono::milliseconds(0), reschedule);
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    EXPECT_EQ(counter, 1000);
+    EXPECT_EQ(rescheduled, 5);
+}
+
+TEST(PollScheduler,stepping ){
+    Log::Init();
+    TimerWheel wheel;
+    PollScheduler sut(wheel);
+    std::atomic<int> fastSteps(0), slowSteps(0);
+    int fast = sut.add([&fastSteps]() {fastSteps++; return std::chrono::milliseconds(10);});
+    sut.add([&slowSteps]() {slowSteps++; return std::chrono::milliseconds(100);});
+    EXPECT_EQ(sut.getNumberOfClients(), 2u);
+    std::this_thread::sleep_for(std::chrono::milliseconds(250));
+    sut.remove(fast);
+    const int fastAtRemove = fastSteps;
+    EXPECT_GE(fastAtRemove, 10);
+    EXPECT_LE(fastAtRemove, 26);
+    EXPECT_GE(slowSteps, 2);
+    EXPECT_LE(slowSteps, 3);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(fastSteps, fastAtRemove) << "a removed client should not be stepped anymore";
+    EXPECT_EQ(sut.getNumberOfClients(), 1u);
+}
+
+TEST(PollScheduler,stagger ){
+    TimerWheel wheel;
+    PollScheduler sut(wheel);
+    std::mutex mutex;
+    std::set<long> firstStepTicks;
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<int> handles;
+    for (int i = 0; i < PollScheduler::StaggerPhases; ++i) {
+        auto isFirst = std::make_shared<bool>(true);
+        handles.push_back(sut.add([&, isFirst]() {
+            if (*isFirst) {
+                *isFirst = false;
+                std::lock_guard<std::mutex> lock(mutex);
+                firstStepTicks.insert((std::chrono::steady_clock::now() - start) / wheel.getTick());
+            }
+            return std::chrono::milliseconds(1000);
+        }));
+    }
+    std::this_thread::sleep_for(PollScheduler::StaggerStep * PollScheduler::StaggerPhases + std::chrono::milliseconds(50));
+    for (int handle : handles) {
+        sut.remove(handle);
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_GE(firstStepTicks.size(), (std::size_t)PollScheduler::StaggerPhases / 2) << "the first steps should be spread over multiple ticks";
+}
+
+TEST(PollScheduler,removeWaitsOnStep ){
+    TimerWheel wheel;
+    PollScheduler sut(wheel);
+    std::atomic<bool> inStep(false), stepDone(false);
+    int handle = sut.add([&]() {
+        inStep = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        stepDone = true;
+        return std::chrono::milliseconds(1);
+    });
+    while (!inStep) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    sut.remove(handle);
+    EXPECT_TRUE(stepDone) << "remove should wait until the running step is done";
+}
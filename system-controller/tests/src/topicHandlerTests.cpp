@@ -2,6 +2,9 @@
 #include <memory>
 #include <vector>
 #include <string>
+#include <map>
+#include <set>
+#include <atomic>
 
 #include "log.h"
 #include "topicHandler.h"
@@ -32,4 +35,59 @@ TEST(topicHandler,basics ){
     EXPECT_FALSE(sut.isTopicValidForHandling("xxx/c/bbx/xxx/ff"));
 
     EXPECT_TRUE(true);
-}
\ No newline at end of file
+}
+
+namespace {
+    // remembers per key the order of the handled messages and the thread that handled them
+    class RecordingHandler : public TopicHandler {
+        public:
+            explicit RecordingHandler(std::size_t numberOfShards) : TopicHandler({"test/#"}, numberOfShards) {}
+            std::map<std::string, std::vector<int>> handled;
+            std::map<std::string, std::set<std::thread::id>> threads;
+            std::set<std::thread::id> allThreads;
+            std::mutex mutex;
+            std::atomic<int> count {0};
+        protected:
+            // test/<key>/<sequence>: the key is the first two levels
+            std::size_t getShardKey(const MqttData & data) const override {return hashTopicLevels(data.getTopic(), 2);}
+            void handleNewInput(const MqttData & inputData) override {
+                const std::string & topic = inputData.getTopic();
+                const std::string key = topic.substr(0, topic.find_last_of('/'));
+                std::lock_guard<std::mutex> lock(mutex);
+                handled[key].push_back(std::stoi(topic.substr(topic.find_last_of('/') + 1)));
+                threads[key].insert(std::this_thread::get_id());
+                allThreads.insert(std::this_thread::get_id());
+                count++;
+            }
+    };
+}
+
+TEST(topicHandler,shards ){
+    Log::Init();
+    RecordingHandler sut(4);
+    EXPECT_EQ(sut.getNumberOfShards(), 4u);
+    sut.start();
+    const int keyCount = 16;
+    const int messagesPerKey = 50;
+    for (int i = 0; i < messagesPerKey; ++i) {
+        for (int key = 0; key < keyCount; ++key) {
+            sut.queueInput(MqttData("test/motor" + std::to_string(key) + "/" + std::to_string(i), ""));
+        }
+    }
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (sut.count < keyCount * messagesPerKey && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    sut.stop();
+
+    std::lock_guard<std::mutex> lock(sut.mutex);
+    ASSERT_EQ((int)sut.handled.size(), keyCount);
+    for (auto & h : sut.handled) {
+        ASSERT_EQ((int)h.second.size(), messagesPerKey) << h.first;
+        for (int i = 0; i < messagesPerKey; ++i) {
+            EXPECT_EQ(h.second[i], i) << "the messages of one key should be handled in order: " << h.first;
+        }
+        EXPECT_EQ(sut.threads[h.first].size(), 1u) << "one key should always be handled by the same shard: " << h.first;
+    }
+    EXPECT_GT(sut.allThreads.size(), 1u) << "the keys should be spread over the shards";
+}
@@ -49,4 +49,15 @@ TEST(WingData,basics ){
     sut_posMm.getPosition(sut_posMm_posPerc, sut_posMm_posMm);
     
     EXPECT_TRUE(250 == sut_posMm_posMm);
-}
\ No newline at end of file
+}
+TEST(WingData,topicLevels ){
+    Log::Init();
+    auto sut = WingData(MqttData("systemcontroller/config1/WING/wing1/open"));
+    EXPECT_EQ(sut.getId(), "wing1") << "the wing level is not case sensitive";
+    EXPECT_TRUE(sut.getWingCommand() == WingComandType::Open);
+
+    EXPECT_TRUE(WingData(MqttData("systemcontroller/wing/wing1/unknown")).getWingCommand() == WingComandType::Ignore);
+    EXPECT_ANY_THROW(WingData(MqttData("systemcontroller/wings/wing1/open")));
+    EXPECT_ANY_THROW(WingData(MqttData("systemcontroller/wing/wing1/")));
+    EXPECT_ANY_THROW(WingData(MqttData("wing/wing1/open")));
+}
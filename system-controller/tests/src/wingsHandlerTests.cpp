@@ -124,6 +124,69 @@ TEST(WingsHandler,publishWingIdsOnStart) {
     sut.stop();
 }
 
+TEST(WingsHandler,evaluatesDirtyWings) {
+    Log::Init();
+    WingsHandler sut("dummyId", std::make_shared<WingInputTranslator>());
+    auto wing1 = std::make_shared<TestWing>(2000,"wing1");
+    auto wing2 = std::make_shared<TestWing>(2000,"wing2");
+    wing1->addSibling(wing2, WingSiblingType::Opposite);
+    wing2->addSibling(wing1, WingSiblingType::Opposite);
+    sut.addWing(wing1);
+    sut.addWing(wing2);
+    sut.start();
+
+    auto waitForEvaluation = [](const std::shared_ptr<TestWing> & wing, int evaluations) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(100);
+        while (wing->getNumberOfEvaluations() < evaluations && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return wing->getNumberOfEvaluations() >= evaluations;
+    };
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    EXPECT_EQ(wing1->getNumberOfEvaluations() + wing2->getNumberOfEvaluations(), 0) << "Nothing changed, no wing should be evaluated";
+
+    auto motionManager = std::dynamic_pointer_cast<TestMotorMotionManager>(wing1->getMasterWindow()->getMotionManager());
+    motionManager->updateWithFakePosition(500);
+    EXPECT_TRUE(waitForEvaluation(wing2, 1)) << "A moving sibling should trigger an evaluation";
+    EXPECT_EQ(wing1->getNumberOfEvaluations(), 0) << "The wing itself is not evaluated on its own position";
+
+    sut.handleNewInput(MqttData("systemcontroller/dummyId/wing/wing1/open",""));
+    EXPECT_TRUE(waitForEvaluation(wing1, 1)) << "A new target should trigger an evaluation";
+
+    sut.stop();
+}
+
+TEST(WingsHandler,motorCallbacksOnStrand) {
+    Log::Init();
+    WingsHandler sut("dummyId", std::make_shared<WingInputTranslator>());
+    auto wing1 = std::make_shared<TestWing>(2000,"wing1");
+    sut.addWing(wing1);
+    auto motionManager = std::dynamic_pointer_cast<TestMotorMotionManager>(wing1->getMasterWindow()->getMotionManager());
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<std::thread::id> callbackThreads;
+    motionManager->addOnPositionUpdatehandler([&](int) {
+        std::lock_guard<std::mutex> lock(mutex);
+        callbackThreads.push_back(std::this_thread::get_id());
+        cv.notify_all();
+    });
+    auto waitForCallbacks = [&](std::size_t count) {
+        std::unique_lock<std::mutex> lock(mutex);
+        return cv.wait_for(lock, std::chrono::milliseconds(500), [&]() {return callbackThreads.size() >= count;});
+    };
+
+    sut.start();
+    motionManager->SetFakeMotorStatus(MotorStatus::Moving);
+    ASSERT_TRUE(waitForCallbacks(1));
+    EXPECT_NE(callbackThreads[0], std::this_thread::get_id()) << "Once started the motor callbacks should run on the strand of the wing";
+
+    sut.stop();
+    motionManager->SetFakeMotorStatus(MotorStatus::Idle);
+    ASSERT_TRUE(waitForCallbacks(2));
+    EXPECT_EQ(callbackThreads[1], std::this_thread::get_id()) << "Once stopped the motor callbacks should run directly again";
+}
+
 TEST(WingsHandler,CalibrationWing ){ 
     Log::Init();
     int windowLength = 2000;